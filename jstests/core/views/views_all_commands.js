@@ -149,6 +149,7 @@ let viewsCommandTests = {
     balancerStart: {skip: isUnrelated},
     balancerStatus: {skip: isUnrelated},
     balancerStop: {skip: isUnrelated},
+    beginInitialSyncBackup: {skip: isUnrelated},
     buildInfo: {skip: isUnrelated},
     captrunc: {
         command: {captrunc: "view", n: 2, inc: false},
@@ -258,8 +259,10 @@ let viewsCommandTests = {
         expectFailure: true,
     },
     enableSharding: {skip: "Tested as part of shardCollection"},
+    endInitialSyncBackup: {skip: isUnrelated},
     endSessions: {skip: isUnrelated},
     explain: {command: {explain: {count: "view"}}},
+    extendInitialSyncBackup: {skip: isUnrelated},
     features: {skip: isUnrelated},
     filemd5: {skip: isUnrelated},
     find: {skip: "tested in views/views_find.js & views/views_sharded.js"},
@@ -429,6 +432,7 @@ let viewsCommandTests = {
     planCacheSetFilter: {command: {planCacheSetFilter: "view"}, expectFailure: true},
     prepareTransaction: {skip: isUnrelated},
     profile: {skip: isUnrelated},
+    readInitialSyncBackupFile: {skip: isUnrelated},
     refineCollectionShardKey: {skip: isUnrelated},
     refreshLogicalSessionCacheNow: {skip: isAnInternalCommand},
     reapLogicalSessionCacheNow: {skip: isAnInternalCommand},
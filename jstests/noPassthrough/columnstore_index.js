@@ -0,0 +1,77 @@
+/**
+ * Tests that a columnstore index is used in place of a collection scan by queries which only read
+ * indexed fields, and that the documents rebuilt from the index match the collection, including
+ * their field order.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getPlanStage() and getAggPlanStage().
+
+const conn = MongoRunner.runMongod({setParameter: {featureFlagColumnStoreIndexes: true}});
+assert.neq(null, conn, "mongod was unable to start up");
+const coll = conn.getDB("test").columnstore_index;
+
+const docs = [];
+for (let i = 0; i < 100; i++) {
+    // Some documents hold the indexed fields in the opposite order of the key pattern.
+    const doc = i % 2 == 0 ? {_id: i, a: i % 7, c: "unindexed"} : {c: "unindexed", _id: i};
+    if (i % 3 != 0) {
+        doc.b = {x: i, y: [i, NumberLong(i)]};
+    }
+    if (i % 10 == 0) {
+        doc.b = null;
+    }
+    if (i % 2 != 0) {
+        doc.a = i % 7;
+    }
+    docs.push(doc);
+}
+assert.commandWorked(coll.insert(docs));
+
+// Only top-level fields may be indexed, and special index options are rejected.
+assert.commandFailedWithCode(coll.createIndex({"a.b": "columnstore"}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(coll.createIndex({a: "columnstore", b: 1}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(coll.createIndex({a: "columnstore"}, {sparse: true}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(coll.createIndex({a: "columnstore"}, {unique: true}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandWorked(coll.createIndex({a: "columnstore", b: "columnstore"}));
+
+// Compares results in any order, but with the fields of each document in order.
+function assertSameResults(expected, actual) {
+    const sorted = (docs) => docs.map(tojson).sort();
+    assert.eq(sorted(expected), sorted(actual));
+}
+
+function assertColumnScanResults(filter, projection) {
+    const explain = coll.find(filter, projection).explain();
+    assert.neq(null, getPlanStage(explain, "COLUMN_SCAN"), explain);
+    assertSameResults(coll.find(filter, projection).hint({$natural: 1}).toArray(),
+                      coll.find(filter, projection).toArray());
+}
+
+assertColumnScanResults({}, {_id: 0, a: 1, b: 1});
+assertColumnScanResults({a: {$gte: 3}}, {_id: 0, b: 1});
+assertColumnScanResults({"b.y": NumberLong(4)}, {_id: 0, a: 1});
+assertColumnScanResults({b: null}, {_id: 0, b: 1});
+
+// Queries reading unindexed fields still scan the collection.
+assert.neq(null, getPlanStage(coll.find({c: "unindexed"}, {_id: 0, a: 1}).explain(), "COLLSCAN"));
+assert.neq(null, getPlanStage(coll.find({a: 1}, {a: 1}).explain(), "COLLSCAN"));
+
+// A $group over indexed fields scans the column store.
+const pipeline = [{$match: {a: {$lt: 5}}}, {$group: {_id: "$a", n: {$sum: 1}}}];
+assert.neq(null, getAggPlanStage(coll.explain().aggregate(pipeline), "COLUMN_SCAN"));
+assertSameResults(coll.aggregate(pipeline, {hint: {$natural: 1}}).toArray(),
+                  coll.aggregate(pipeline).toArray());
+
+// Writes keep the index up to date.
+assert.commandWorked(coll.update({_id: 1}, {$set: {a: 100}, $unset: {b: ""}}));
+assert.commandWorked(coll.remove({_id: 2}));
+assertColumnScanResults({a: {$gte: 6}}, {_id: 0, a: 1, b: 1});
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,46 @@
+/**
+ * Tests that columnstore indexes can only be created with featureFlagColumnStoreIndexes and FCV
+ * 4.4, and that the FCV cannot be downgraded while one exists.
+ */
+(function() {
+"use strict";
+
+// Without the feature flag, column store indexes cannot be created.
+let conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+assert.commandFailedWithCode(conn.getDB("test").coll.createIndex({a: "columnstore"}),
+                             ErrorCodes.CannotCreateIndex);
+MongoRunner.stopMongod(conn);
+
+conn = MongoRunner.runMongod({setParameter: {featureFlagColumnStoreIndexes: true}});
+assert.neq(null, conn, "mongod was unable to start up");
+const adminDB = conn.getDB("admin");
+const coll = conn.getDB("test").coll;
+assert.commandWorked(coll.insert({_id: 0, a: 1, b: 2}));
+
+// With FCV 4.2, column store indexes cannot be created.
+assert.commandWorked(adminDB.runCommand({setFeatureCompatibilityVersion: lastStableFCV}));
+assert.commandFailedWithCode(coll.createIndex({a: "columnstore"}), ErrorCodes.CannotCreateIndex);
+
+assert.commandWorked(adminDB.runCommand({setFeatureCompatibilityVersion: latestFCV}));
+assert.commandWorked(coll.createIndex({a: "columnstore"}));
+
+// The downgrade stops while a column store index exists, and no other one can be created until the
+// FCV is upgraded again.
+assert.commandFailedWithCode(adminDB.runCommand({setFeatureCompatibilityVersion: lastStableFCV}),
+                             4938120);
+checkFCV(adminDB, lastStableFCV, lastStableFCV);
+assert.commandFailedWithCode(coll.createIndex({b: "columnstore"}), ErrorCodes.CannotCreateIndex);
+
+// Once the index is dropped, the downgrade can finish.
+assert.commandWorked(coll.dropIndex({a: "columnstore"}));
+assert.commandWorked(adminDB.runCommand({setFeatureCompatibilityVersion: lastStableFCV}));
+checkFCV(adminDB, lastStableFCV);
+
+// Upgrading again allows creating column store indexes.
+assert.commandWorked(adminDB.runCommand({setFeatureCompatibilityVersion: latestFCV}));
+checkFCV(adminDB, latestFCV);
+assert.commandWorked(coll.createIndex({b: "columnstore"}));
+
+MongoRunner.stopMongod(conn);
+})();
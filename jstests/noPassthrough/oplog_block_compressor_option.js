@@ -0,0 +1,29 @@
+/**
+ * Tests that --wiredTigerOplogBlockCompressor sets the block compressor of the oplog without
+ * affecting other collections, which keep using --wiredTigerCollectionBlockCompressor.
+ *
+ * @tags: [requires_persistence, requires_replication, requires_wiredtiger]
+ */
+(function() {
+'use strict';
+
+const rst = new ReplSetTest({
+    nodes: 1,
+    nodeOptions: {
+        wiredTigerCollectionBlockCompressor: 'snappy',
+        wiredTigerOplogBlockCompressor: 'zstd',
+    }
+});
+rst.startSet();
+rst.initiate();
+const primary = rst.getPrimary();
+
+assert.commandWorked(primary.getDB('test').coll.insert({}));
+
+const oplogStats = primary.getDB('local').oplog.rs.stats();
+assert.gt(oplogStats.wiredTiger.creationString.search('block_compressor=zstd'), -1, oplogStats);
+const collStats = primary.getDB('test').coll.stats();
+assert.gt(collStats.wiredTiger.creationString.search('block_compressor=snappy'), -1, collStats);
+
+rst.stopSet();
+}());
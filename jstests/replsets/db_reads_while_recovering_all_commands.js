@@ -76,6 +76,7 @@ const allCommands = {
     applyOps: {skip: isPrimaryOnly},
     authenticate: {skip: isNotAUserDataRead},
     availableQueryOptions: {skip: isNotAUserDataRead},
+    beginInitialSyncBackup: {skip: isNotAUserDataRead},
     buildInfo: {skip: isNotAUserDataRead},
     captrunc: {skip: isPrimaryOnly},
     checkShardingIndex: {skip: isPrimaryOnly},
@@ -136,12 +137,14 @@ const allCommands = {
     dropUser: {skip: isPrimaryOnly},
     echo: {skip: isNotAUserDataRead},
     emptycapped: {skip: isPrimaryOnly},
+    endInitialSyncBackup: {skip: isNotAUserDataRead},
     endSessions: {skip: isNotAUserDataRead},
     explain: {
         command: {count: collName},
         expectFailure: true,
         expectedErrorCode: ErrorCodes.NotMasterOrSecondary,
     },
+    extendInitialSyncBackup: {skip: isNotAUserDataRead},
     features: {skip: isNotAUserDataRead},
     filemd5: {skip: isNotAUserDataRead},
     find: {
@@ -235,6 +238,7 @@ const allCommands = {
     planCacheSetFilter: {skip: isNotAUserDataRead},
     prepareTransaction: {skip: isPrimaryOnly},
     profile: {skip: isPrimaryOnly},
+    readInitialSyncBackupFile: {skip: isNotAUserDataRead},
     reapLogicalSessionCacheNow: {skip: isNotAUserDataRead},
     refreshLogicalSessionCacheNow: {skip: isNotAUserDataRead},
     refreshSessions: {skip: isNotAUserDataRead},
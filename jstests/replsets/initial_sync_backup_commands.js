@@ -0,0 +1,91 @@
+/**
+ * Tests the commands a syncing node uses to copy a sync source's data files for file copy based
+ * initial sync: beginInitialSyncBackup, readInitialSyncBackupFile, extendInitialSyncBackup and
+ * endInitialSyncBackup.
+ *
+ * @tags: [requires_persistence, requires_wiredtiger]
+ */
+
+(function() {
+"use strict";
+
+const replSet = new ReplSetTest({name: "initial_sync_backup_commands", nodes: 1});
+replSet.startSet();
+replSet.initiate();
+const primary = replSet.getPrimary();
+const admin = primary.getDB("admin");
+
+assert.commandWorked(primary.getDB("test").foo.insert({_id: 0}, {writeConcern: {w: 1, j: true}}));
+// The backup copies the last stable checkpoint, so wait until there is one.
+let begin;
+assert.soon(() => {
+    assert.commandWorked(admin.runCommand({fsync: 1}));
+    begin = admin.runCommand({beginInitialSyncBackup: 1});
+    if (begin.code === ErrorCodes.NotYetInitialized) {
+        return false;
+    }
+    assert.commandWorked(begin);
+    return true;
+});
+const backupId = begin.backupId;
+assert.eq(begin.dbpath,
+          assert.commandWorked(admin.runCommand({getCmdLineOpts: 1})).parsed.storage.dbPath,
+          tojson(begin));
+assert.eq(typeof begin.checkpointTimestamp, "object", tojson(begin));
+assert.gt(begin.files.length, 0, tojson(begin));
+
+// Only one backup may be open at a time.
+assert.commandFailedWithCode(admin.runCommand({beginInitialSyncBackup: 1}),
+                             ErrorCodes.ConflictingOperationInProgress);
+
+// Every listed file can be read to its listed size, in chunks.
+const chunkBytes = 64 * 1024;
+for (let file of begin.files) {
+    assert(file.filename.startsWith(begin.dbpath), tojson(file));
+    assert(!file.relativePath.startsWith("/"), tojson(file));
+    let offset = 0;
+    while (true) {
+        const res = assert.commandWorked(admin.runCommand({
+            readInitialSyncBackupFile: 1,
+            backupId: backupId,
+            filename: file.filename,
+            offset: NumberLong(offset),
+            length: NumberLong(chunkBytes)
+        }));
+        offset += res.data.length();
+        if (res.eof) {
+            break;
+        }
+        assert.eq(res.data.length(), chunkBytes, tojson(file));
+    }
+    assert.eq(offset, file.fileSize, tojson(file));
+}
+
+// Files outside of the backup cannot be read.
+assert.commandFailedWithCode(admin.runCommand({
+    readInitialSyncBackupFile: 1,
+    backupId: backupId,
+    filename: begin.dbpath + "/mongod.lock",
+    offset: NumberLong(0),
+    length: NumberLong(chunkBytes)
+}),
+                             ErrorCodes.NoSuchKey);
+
+// Extending the backup returns the journal files needed to recover to a later point.
+assert.commandWorked(primary.getDB("test").foo.insert({_id: 1}));
+const extend =
+    assert.commandWorked(admin.runCommand({extendInitialSyncBackup: 1, backupId: backupId}));
+for (let file of extend.files) {
+    assert(file.relativePath.startsWith("journal/"), tojson(extend));
+}
+
+assert.commandWorked(admin.runCommand({endInitialSyncBackup: 1, backupId: backupId}));
+assert.commandFailedWithCode(admin.runCommand({endInitialSyncBackup: 1, backupId: backupId}),
+                             ErrorCodes.NoSuchKey);
+
+// Once the backup is closed, another one can be opened.
+const reopened = assert.commandWorked(admin.runCommand({beginInitialSyncBackup: 1}));
+assert.commandWorked(admin.runCommand({endInitialSyncBackup: 1, backupId: reopened.backupId}));
+
+replSet.stopSet();
+})();
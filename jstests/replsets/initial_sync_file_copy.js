@@ -0,0 +1,75 @@
+/**
+ * Tests file copy based initial sync: a node started with an empty dbpath and
+ * 'fileCopyInitialSyncSource' copies the sync source's data files, applies the copied oplog from
+ * their checkpoint during startup recovery and joins the set without logical initial sync.
+ *
+ * @tags: [requires_persistence, requires_wiredtiger]
+ */
+
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({name: "initial_sync_file_copy", nodes: 1});
+rst.startSet();
+rst.initiate();
+const primary = rst.getPrimary();
+const primaryDB = primary.getDB("test");
+
+// These documents and the index are in the checkpoint that the backup copies.
+assert.commandWorked(primaryDB.inCheckpoint.insert([{_id: 0, a: 0}, {_id: 1, a: 1}]));
+assert.commandWorked(primaryDB.inCheckpoint.createIndex({a: 1}));
+const lastCheckpointedOpTime =
+    assert.commandWorked(primary.adminCommand({replSetGetStatus: 1})).optimes.appliedOpTime;
+assert.soon(() => {
+    assert.commandWorked(primary.adminCommand({fsync: 1}));
+    const status = assert.commandWorked(primary.adminCommand({replSetGetStatus: 1}));
+    return status.lastStableRecoveryTimestamp &&
+        timestampCmp(status.lastStableRecoveryTimestamp, lastCheckpointedOpTime.ts) >= 0;
+});
+
+// These writes are only in the journal, so the syncing node gets them by applying the copied
+// oplog from the checkpoint timestamp.
+assert.commandWorked(
+    primary.adminCommand({configureFailPoint: "pauseCheckpointThread", mode: "alwaysOn"}));
+assert.commandWorked(
+    primaryDB.afterCheckpoint.insert([{_id: 0}, {_id: 1}], {writeConcern: {w: 1, j: true}}));
+assert.commandWorked(
+    primaryDB.inCheckpoint.update({_id: 1}, {$set: {a: 2}}, {writeConcern: {w: 1, j: true}}));
+
+const secondary = rst.add({
+    rsConfig: {votes: 0, priority: 0},
+    setParameter: {fileCopyInitialSyncSource: primary.host, numInitialSyncAttempts: 1},
+});
+checkLog.containsJson(secondary, 4938113);
+assert.commandWorked(
+    primary.adminCommand({configureFailPoint: "pauseCheckpointThread", mode: "off"}));
+
+// The copied node starts outside of the set's config until it is added to it.
+rst.reInitiate();
+rst.awaitSecondaryNodes();
+
+// Writes made after the copy reach the node through steady state replication.
+assert.commandWorked(primaryDB.afterCopy.insert({_id: 0}));
+rst.awaitReplication();
+
+const serverStatus = assert.commandWorked(secondary.adminCommand({serverStatus: 1}));
+assert.eq(0, serverStatus.metrics.repl.initialSync.completed, tojson(serverStatus.metrics.repl));
+assert.eq(0, serverStatus.metrics.repl.initialSync.failures, tojson(serverStatus.metrics.repl));
+
+secondary.setSlaveOk();
+const secondaryDB = secondary.getDB("test");
+for (let collName of ["inCheckpoint", "afterCheckpoint", "afterCopy"]) {
+    assert.eq(primaryDB[collName].find().sort({_id: 1}).toArray(),
+              secondaryDB[collName].find().sort({_id: 1}).toArray(),
+              collName);
+}
+assert.eq(primaryDB.inCheckpoint.getIndexes(), secondaryDB.inCheckpoint.getIndexes());
+assert.eq([{_id: 1, a: 2}], secondaryDB.inCheckpoint.find({a: 2}).hint({a: 1}).toArray());
+
+// The copied node starts on its own data after a restart instead of copying the files again.
+rst.restart(secondary);
+rst.awaitSecondaryNodes();
+assert(!checkLog.checkContainsOnceJson(rst.nodes[1], 4938110), "copied the files again");
+
+rst.stopSet();
+})();
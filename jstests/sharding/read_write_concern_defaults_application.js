@@ -164,6 +164,7 @@ let testCases = {
     balancerStart: {skip: "does not accept read or write concern"},
     balancerStatus: {skip: "does not accept read or write concern"},
     balancerStop: {skip: "does not accept read or write concern"},
+    beginInitialSyncBackup: {skip: "does not accept read or write concern"},
     buildInfo: {skip: "does not accept read or write concern"},
     captrunc: {skip: "test command"},
     checkShardingIndex: {skip: "does not accept read or write concern"},
@@ -354,8 +355,10 @@ let testCases = {
     echo: {skip: "does not accept read or write concern"},
     emptycapped: {skip: "test command"},
     enableSharding: {skip: "does not accept read or write concern"},
+    endInitialSyncBackup: {skip: "does not accept read or write concern"},
     endSessions: {skip: "does not accept read or write concern"},
     explain: {skip: "TODO SERVER-45478"},
+    extendInitialSyncBackup: {skip: "does not accept read or write concern"},
     features: {skip: "internal command"},
     filemd5: {skip: "does not accept read or write concern"},
     find: {
@@ -487,6 +490,7 @@ let testCases = {
     planCacheSetFilter: {skip: "does not accept read or write concern"},
     prepareTransaction: {skip: "internal command"},
     profile: {skip: "does not accept read or write concern"},
+    readInitialSyncBackupFile: {skip: "does not accept read or write concern"},
     reIndex: {skip: "does not accept read or write concern"},
     reapLogicalSessionCacheNow: {skip: "does not accept read or write concern"},
     refineCollectionShardKey: {skip: "does not accept read or write concern"},
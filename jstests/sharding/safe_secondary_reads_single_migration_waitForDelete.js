@@ -103,6 +103,7 @@ let testCases = {
     balancerStart: {skip: "primary only"},
     balancerStatus: {skip: "primary only"},
     balancerStop: {skip: "primary only"},
+    beginInitialSyncBackup: {skip: "does not return user data"},
     buildInfo: {skip: "does not return user data"},
     captrunc: {skip: "primary only"},
     checkShardingIndex: {skip: "primary only"},
@@ -166,8 +167,10 @@ let testCases = {
     echo: {skip: "does not return user data"},
     emptycapped: {skip: "primary only"},
     enableSharding: {skip: "primary only"},
+    endInitialSyncBackup: {skip: "does not return user data"},
     endSessions: {skip: "does not return user data"},
     explain: {skip: "TODO SERVER-30068"},
+    extendInitialSyncBackup: {skip: "does not return user data"},
     features: {skip: "does not return user data"},
     filemd5: {skip: "does not return user data"},
     find: {
@@ -257,6 +260,7 @@ let testCases = {
     planCacheListFilters: {skip: "does not return user data"},
     planCacheSetFilter: {skip: "does not return user data"},
     profile: {skip: "primary only"},
+    readInitialSyncBackupFile: {skip: "does not return user data"},
     reapLogicalSessionCacheNow: {skip: "does not return user data"},
     refineCollectionShardKey: {skip: "primary only"},
     refreshLogicalSessionCacheNow: {skip: "does not return user data"},
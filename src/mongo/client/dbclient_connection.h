@@ -257,6 +257,10 @@ public:
         _hook = hook;
     }
 
+    const HandshakeValidationHook& getHandshakeValidationHook() const {
+        return _hook;
+    }
+
     bool lazySupported() const override {
         return true;
     }
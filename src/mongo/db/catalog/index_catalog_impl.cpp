@@ -647,7 +647,7 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx, const BSONObj& spec)
 
     const bool isSparse = spec["sparse"].trueValue();
 
-    if (pluginName == IndexNames::WILDCARD) {
+    if (pluginName == IndexNames::WILDCARD || pluginName == IndexNames::COLUMN_STORE) {
         if (isSparse) {
             return Status(ErrorCodes::CannotCreateIndex,
                           str::stream() << "Index type '" << pluginName
@@ -685,6 +685,12 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx, const BSONObj& spec)
                           "\"partialFilterExpression\" for an index must be a document");
         }
 
+        if (pluginName == IndexNames::COLUMN_STORE) {
+            return Status(ErrorCodes::CannotCreateIndex,
+                          str::stream() << "Index type '" << pluginName
+                                        << "' does not support the partialFilterExpression option");
+        }
+
         // Parsing the partial filter expression is not expected to fail here since the
         // expression would have been successfully parsed upstream during index creation.
         StatusWithMatchExpression statusWithMatcher =
@@ -40,6 +40,7 @@
 
 #include "mongo/base/status.h"
 #include "mongo/base/status_with.h"
+#include "mongo/db/catalog/index_key_validate_gen.h"
 #include "mongo/db/field_ref.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/wildcard_key_generator.h"
@@ -136,7 +137,7 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
                                           << static_cast<int>(indexVersion)};
                 }
 
-                if (pluginName == IndexNames::WILDCARD) {
+                if (pluginName == IndexNames::WILDCARD || pluginName == IndexNames::COLUMN_STORE) {
                     return {code,
                             str::stream() << "'" << pluginName
                                           << "' index plugin is not allowed with index version v:"
@@ -183,6 +184,22 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
             return Status(code, "wildcard indexes do not allow compounding");
         }
 
+        // A column store index rebuilds documents from its keys, so every field must be a
+        // top-level field stored by the column store itself.
+        if (pluginName == IndexNames::COLUMN_STORE) {
+            if (keyElement.type() != String) {
+                return Status(code,
+                              str::stream() << "All fields of a '" << IndexNames::COLUMN_STORE
+                                            << "' index must have the value '"
+                                            << IndexNames::COLUMN_STORE << "'");
+            }
+            if (keyElement.fieldNameStringData().find('.') != std::string::npos) {
+                return Status(code,
+                              str::stream() << "'" << IndexNames::COLUMN_STORE
+                                            << "' indexes only support top-level fields");
+            }
+        }
+
         // Ensure that the fields on which we are building the index are valid: a field must not
         // begin with a '$' unless it is part of a wildcard, DBRef or text index, and a field path
         // cannot contain an empty field. If a field cannot be created or updated, it should not be
@@ -320,6 +337,16 @@ StatusWith<BSONObj> validateIndexSpec(
                         "commands enabled "};
             }
 
+            // Allow column store indexes only with their feature flag and FCV 4.4, since older
+            // binaries cannot open them.
+            if (IndexNames::findPluginName(indexSpecElem.embeddedObject()) ==
+                    IndexNames::COLUMN_STORE &&
+                (!gFeatureFlagColumnStoreIndexes || isFeatureDisabled)) {
+                return {ErrorCodes::CannotCreateIndex,
+                        "Column store indexes can only be created with FCV 4.4 and with "
+                        "featureFlagColumnStoreIndexes enabled"};
+            }
+
             hasKeyPatternField = true;
         } else if (IndexDescriptor::kIndexNameFieldName == indexSpecElemFieldName) {
             if (indexSpecElem.type() != BSONType::String) {
@@ -33,6 +33,7 @@
 
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/catalog/coll_mod.h"
+#include "mongo/db/catalog/collection_catalog_helper.h"
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/commands.h"
@@ -44,6 +45,7 @@
 #include "mongo/db/db_raii.h"
 #include "mongo/db/dbdirectclient.h"
 #include "mongo/db/index_builds_coordinator.h"
+#include "mongo/db/index_names.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/ops/write_ops.h"
 #include "mongo/db/read_write_concern_defaults.h"
@@ -76,6 +78,33 @@ MONGO_FAIL_POINT_DEFINE(failUpgrading);
 MONGO_FAIL_POINT_DEFINE(failDowngrading);
 MONGO_FAIL_POINT_DEFINE(allowFCVDowngradeWithCompoundHashedShardKey);
 
+/**
+ * Returns the namespace of a collection with a column store index, if there is one on this node.
+ */
+boost::optional<NamespaceString> findCollectionWithColumnStoreIndex(OperationContext* opCtx) {
+    for (const auto& dbName : CollectionCatalog::get(opCtx).getAllDbNames()) {
+        Lock::DBLock dbLock(opCtx, dbName, MODE_IS);
+        boost::optional<NamespaceString> found;
+        catalog::forEachCollectionFromDb(
+            opCtx, dbName, MODE_IS, [&](const Collection* collection) {
+                auto it = collection->getIndexCatalog()->getIndexIterator(
+                    opCtx, true /* includeUnfinishedIndexes */);
+                while (it->more()) {
+                    if (it->next()->descriptor()->getAccessMethodName() ==
+                        IndexNames::COLUMN_STORE) {
+                        found = collection->ns();
+                        return false;
+                    }
+                }
+                return true;
+            });
+        if (found) {
+            return found;
+        }
+    }
+    return boost::none;
+}
+
 /**
  * Deletes the persisted default read/write concern document.
  */
@@ -306,6 +335,17 @@ public:
 
             FeatureCompatibilityVersion::setTargetDowngrade(opCtx);
 
+            // Column store indexes are only supported in 4.4, and cannot be created once the
+            // downgrade has started. If the user tries to downgrade to FCV42, they must first drop
+            // all column store indexes.
+            if (auto nss = findCollectionWithColumnStoreIndex(opCtx)) {
+                uasserted(4938120,
+                          str::stream() << "Cannot downgrade the featureCompatibilityVersion when "
+                                           "there is an existing column store index. Please drop "
+                                           "the column store indexes of "
+                                        << *nss << " and re-initiate the downgrade process");
+            }
+
             // Safe reconfig introduces a new "term" field in the config document. If the user tries
             // to downgrade the replset to FCV42, the primary will initiate a reconfig without the
             // term and wait for it to be replicated on all nodes.
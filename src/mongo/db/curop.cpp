@@ -764,6 +764,7 @@ string OpDebug::report(OperationContext* opCtx, const SingleThreadedLockStats* l
     }
 
     OPDEBUG_TOSTRING_HELP(nShards);
+    OPDEBUG_TOSTRING_HELP(nShardsOwningChunks);
     OPDEBUG_TOSTRING_HELP(cursorid);
     if (mongotCursorId) {
         s << " mongot: " << makeMongotDebugStatsObject().toString();
@@ -929,6 +930,7 @@ void OpDebug::report(OperationContext* opCtx,
     }
 
     OPDEBUG_TOATTR_HELP(nShards);
+    OPDEBUG_TOATTR_HELP(nShardsOwningChunks);
     OPDEBUG_TOATTR_HELP(cursorid);
     if (mongotCursorId) {
         pAttrs->add("mongot", makeMongotDebugStatsObject());
@@ -1049,6 +1051,7 @@ void OpDebug::append(OperationContext* opCtx,
     }
 
     OPDEBUG_APPEND_NUMBER(nShards);
+    OPDEBUG_APPEND_NUMBER(nShardsOwningChunks);
     OPDEBUG_APPEND_NUMBER(cursorid);
     if (mongotCursorId) {
         b.append("mongot", makeMongotDebugStatsObject());
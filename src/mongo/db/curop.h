@@ -237,8 +237,10 @@ public:
     long long nreturned{-1};
     int responseLength{-1};
 
-    // Shard targeting info.
+    // Shard targeting info: the number of shards targeted, and the number of shards owning chunks
+    // of the collection.
     int nShards{-1};
+    int nShardsOwningChunks{-1};
 
     // Stores the duration of time spent blocked on prepare conflicts.
     Milliseconds prepareConflictDurationMillis{0};
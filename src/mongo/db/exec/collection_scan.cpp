@@ -242,6 +242,9 @@ PlanStage::StageState CollectionScan::returnIfMatches(WorkingSetMember* member,
         if (_params.stopApplyingFilterAfterFirstMatch) {
             _filter = nullptr;
         }
+        if (_params.retainedFields) {
+            member->retainedFields = _params.retainedFields;
+        }
         *out = memberID;
         return PlanStage::ADVANCED;
     } else if (_endCondition && Filter::passes(member, _endCondition.get())) {
@@ -29,8 +29,11 @@
 
 #pragma once
 
+#include <memory>
+
 #include "mongo/bson/timestamp.h"
 #include "mongo/db/record_id.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -77,6 +80,10 @@ struct CollectionScanParams {
 
     // Whether or not to wait for oplog visibility on oplog collection scans.
     bool shouldWaitForOplogVisibility = false;
+
+    // If set, the only top-level fields of the returned documents that the rest of the plan
+    // depends on. See WorkingSetMember::retainedFields.
+    std::shared_ptr<const StringSet> retainedFields;
 };
 
 }  // namespace mongo
@@ -0,0 +1,89 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include "mongo/db/exec/requires_index_stage.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/storage/sorted_data_interface.h"
+
+namespace mongo {
+
+class WorkingSet;
+
+/**
+ * Scans every key of a column store index, rebuilding a document holding the indexed fields of
+ * each record and returning those which pass 'filter'. Results are in the OWNED_OBJ state since
+ * they only hold part of the stored document.
+ *
+ * The planner only chooses this stage when the indexed fields cover everything the query reads.
+ */
+class ColumnScan final : public RequiresIndexStage {
+public:
+    ColumnScan(ExpressionContext* expCtx,
+               const IndexDescriptor* descriptor,
+               WorkingSet* workingSet,
+               const MatchExpression* filter);
+
+    StageState doWork(WorkingSetID* out) final;
+    bool isEOF() final;
+    void doDetachFromOperationContext() final;
+    void doReattachToOperationContext() final;
+
+    StageType stageType() const final {
+        return STAGE_COLUMN_SCAN;
+    }
+
+    std::unique_ptr<PlanStageStats> getStats() final;
+
+    const SpecificStats* getSpecificStats() const final;
+
+    static const char* kStageType;
+
+protected:
+    void doSaveStateRequiresIndex() final;
+
+    void doRestoreStateRequiresIndex() final;
+
+private:
+    // The WorkingSet we annotate with results.  Not owned by us.
+    WorkingSet* _workingSet;
+
+    const BSONObj _keyPattern;
+
+    // The filter is not owned by us.
+    const MatchExpression* _filter;
+
+    std::unique_ptr<SortedDataInterface::Cursor> _cursor;
+
+    ColumnScanStats _specificStats;
+};
+
+}  // namespace mongo
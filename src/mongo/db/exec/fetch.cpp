@@ -31,6 +31,7 @@
 
 #include "mongo/db/exec/fetch.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/db/catalog/collection.h"
@@ -38,6 +39,7 @@
 #include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/str.h"
 
@@ -53,11 +55,14 @@ FetchStage::FetchStage(ExpressionContext* expCtx,
                        WorkingSet* ws,
                        std::unique_ptr<PlanStage> child,
                        const MatchExpression* filter,
-                       const Collection* collection)
+                       const Collection* collection,
+                       std::shared_ptr<const StringSet> retainedFields)
     : RequiresCollectionStage(kStageType, expCtx, collection),
       _ws(ws),
       _filter((filter && !filter->isTriviallyTrue()) ? filter : nullptr),
-      _idRetrying(WorkingSet::INVALID_ID) {
+      _retainedFields(std::move(retainedFields)),
+      _idRetrying(WorkingSet::INVALID_ID),
+      _maxBatchSize(std::max(internalQueryFetchStageMaxBatchSize.load(), 0)) {
     _children.emplace_back(std::move(child));
 }
 
@@ -69,6 +74,11 @@ bool FetchStage::isEOF() {
         return false;
     }
 
+    if (!_batch.empty()) {
+        // We have buffered members that are yet to be returned.
+        return false;
+    }
+
     return child()->isEOF();
 }
 
@@ -77,6 +87,10 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    if (_maxBatchSize > 1) {
+        return doWorkBatched(out);
+    }
+
     // Either retry the last WSM we worked on or get a new one from our child.
     WorkingSetID id;
     StageState status;
@@ -131,7 +145,103 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState FetchStage::doWorkBatched(WorkingSetID* out) {
+    if (!_batchFilled) {
+        WorkingSetID id;
+        StageState status = child()->work(&id);
+
+        if (PlanStage::ADVANCED == status) {
+            WorkingSetMember* member = _ws->get(id);
+            if (member->hasObj()) {
+                ++_specificStats.alreadyHasObj;
+                // The object may be invalidated by the time the batch is returned.
+                member->makeObjOwnedIfNeeded();
+            } else {
+                // We need a valid RecordId to fetch from and this is the only state that has one.
+                verify(WorkingSetMember::RID_AND_IDX == member->getState());
+                verify(member->hasRecordId());
+                _fetchOrder.push_back(_batch.size());
+            }
+            _batch.push_back(id);
+
+            if (_batch.size() < _targetBatchSize && !child()->isEOF()) {
+                return NEED_TIME;
+            }
+        } else if (PlanStage::IS_EOF != status || _batch.empty()) {
+            // Pass through NEED_TIME, NEED_YIELD and FAILURE, which leave the batch as it is, and
+            // EOF if nothing is buffered.
+            *out = id;
+            return status;
+        }
+
+        _batchFilled = true;
+        _targetBatchSize = std::min(_targetBatchSize * 2, _maxBatchSize);
+        ++_specificStats.batches;
+
+        std::sort(_fetchOrder.begin(), _fetchOrder.end(), [&](size_t lhs, size_t rhs) {
+            return _ws->get(_batch[lhs])->recordId < _ws->get(_batch[rhs])->recordId;
+        });
+    }
+
+    if (_numFetched < _fetchOrder.size()) {
+        try {
+            fetchBatch();
+        } catch (const WriteConflictException&) {
+            *out = WorkingSet::INVALID_ID;
+            return NEED_YIELD;
+        }
+    }
+
+    WorkingSetID id = _batch[_batchPos++];
+    if (_batchPos == _batch.size()) {
+        clearBatch();
+    }
+
+    if (WorkingSet::INVALID_ID == id) {
+        // The record of this member was deleted before it could be fetched.
+        return NEED_TIME;
+    }
+    return returnIfMatches(_ws->get(id), id, out);
+}
+
+void FetchStage::fetchBatch() {
+    if (!_cursor)
+        _cursor = collection()->getCursor(opCtx());
+
+    for (; _numFetched < _fetchOrder.size(); ++_numFetched) {
+        // Seeking the cursor invalidates the object returned by the previous seek.
+        if (_numFetched > 0) {
+            auto& previous = _batch[_fetchOrder[_numFetched - 1]];
+            if (WorkingSet::INVALID_ID != previous) {
+                _ws->get(previous)->makeObjOwnedIfNeeded();
+            }
+        }
+
+        auto& id = _batch[_fetchOrder[_numFetched]];
+        if (!WorkingSetCommon::fetch(opCtx(), _ws, id, _cursor, collection()->ns())) {
+            _ws->free(id);
+            id = WorkingSet::INVALID_ID;
+        }
+    }
+}
+
+void FetchStage::clearBatch() {
+    _batch.clear();
+    _fetchOrder.clear();
+    _batchFilled = false;
+    _numFetched = 0;
+    _batchPos = 0;
+}
+
 void FetchStage::doSaveStateRequiresCollection() {
+    // Buffered members that have been fetched may point into the cursor, which is about to be
+    // reset.
+    for (size_t i = _batchPos; i < _batch.size(); ++i) {
+        if (WorkingSet::INVALID_ID != _batch[i]) {
+            _ws->get(_batch[i])->makeObjOwnedIfNeeded();
+        }
+    }
+
     if (_cursor) {
         _cursor->saveUnpositioned();
     }
@@ -174,6 +284,9 @@ PlanStage::StageState FetchStage::returnIfMatches(WorkingSetMember* member,
     ++_specificStats.docsExamined;
 
     if (Filter::passes(member, _filter)) {
+        if (_retainedFields) {
+            member->retainedFields = _retainedFields;
+        }
         *out = memberID;
         return PlanStage::ADVANCED;
     } else {
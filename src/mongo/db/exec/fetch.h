@@ -30,11 +30,13 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/record_id.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -46,6 +48,12 @@ class SeekableRecordCursor;
  * In WorkingSetMember terms, it transitions from RID_AND_IDX to RID_AND_OBJ by reading
  * the record at the provided RecordId.  Returns verbatim any data that already has an object.
  *
+ * When internalQueryFetchStageMaxBatchSize is greater than one, the stage buffers a batch of
+ * members from its child, looks up their records in RecordId order so that neighbouring records
+ * are read together, and then returns the members in the order the child produced them. The batch
+ * size starts at one and doubles with each batch, so that queries which only consume a few
+ * results do not fetch more documents than they need.
+ *
  * Preconditions: Valid RecordId.
  */
 class FetchStage : public RequiresCollectionStage {
@@ -54,7 +62,8 @@ public:
                WorkingSet* ws,
                std::unique_ptr<PlanStage> child,
                const MatchExpression* filter,
-               const Collection* collection);
+               const Collection* collection,
+               std::shared_ptr<const StringSet> retainedFields = nullptr);
 
     ~FetchStage();
 
@@ -86,6 +95,21 @@ private:
      */
     StageState returnIfMatches(WorkingSetMember* member, WorkingSetID memberID, WorkingSetID* out);
 
+    /**
+     * Implements doWork() when batching is enabled.
+     */
+    StageState doWorkBatched(WorkingSetID* out);
+
+    /**
+     * Looks up the records of the buffered members that still need to be fetched, in RecordId
+     * order. Members whose record no longer exists are freed and replaced by INVALID_ID in
+     * '_batch'. Throws WriteConflictException, in which case the members fetched so far are kept
+     * and the remaining ones are fetched on the next call.
+     */
+    void fetchBatch();
+
+    void clearBatch();
+
     // Used to fetch Records from _collection.
     std::unique_ptr<SeekableRecordCursor> _cursor;
 
@@ -95,9 +119,34 @@ private:
     // The filter is not owned by us.
     const MatchExpression* _filter;
 
+    // Top-level fields that the rest of the plan depends on, attached to each returned member.
+    std::shared_ptr<const StringSet> _retainedFields;
+
     // If not Null, we use this rather than asking our child what to do next.
     WorkingSetID _idRetrying;
 
+    // The maximum number of members buffered by a batch. Batching is disabled if this is at most
+    // one.
+    const size_t _maxBatchSize;
+
+    // The number of members the batch being filled will hold before its records are fetched.
+    size_t _targetBatchSize = 1;
+
+    // The buffered members, in the order in which they were produced by the child.
+    std::vector<WorkingSetID> _batch;
+
+    // True once the batch has been filled, either because it reached '_targetBatchSize' or because
+    // the child hit EOF.
+    bool _batchFilled = false;
+
+    // Indexes into '_batch' of the members that need to be fetched, sorted by RecordId, and the
+    // number of them that have been fetched so far.
+    std::vector<size_t> _fetchOrder;
+    size_t _numFetched = 0;
+
+    // The position in '_batch' of the next member to return.
+    size_t _batchPos = 0;
+
     // Stats
     FetchStats _specificStats;
 };
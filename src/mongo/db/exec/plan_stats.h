@@ -264,6 +264,29 @@ struct CountStats : public SpecificStats {
     long long nSkipped;
 };
 
+struct ColumnScanStats : public SpecificStats {
+    SpecificStats* clone() const final {
+        ColumnScanStats* specific = new ColumnScanStats(*this);
+        // BSON objects have to be explicitly copied.
+        specific->keyPattern = keyPattern.getOwned();
+        return specific;
+    }
+
+    uint64_t estimateObjectSizeInBytes() const {
+        return keyPattern.objsize() + indexName.capacity() + sizeof(*this);
+    }
+
+    std::string indexName;
+
+    BSONObj keyPattern;
+
+    // Number of index keys read, one per document in the collection.
+    size_t keysExamined = 0;
+
+    // Number of rebuilt documents passed through the filter.
+    size_t docsTested = 0;
+};
+
 struct CountScanStats : public SpecificStats {
     CountScanStats()
         : indexVersion(0),
@@ -422,6 +445,10 @@ struct FetchStats : public SpecificStats {
 
     // The total number of full documents touched by the fetch stage.
     size_t docsExamined = 0u;
+
+    // The number of batches of documents looked up in RecordId order. Zero unless batching is
+    // enabled through internalQueryFetchStageMaxBatchSize.
+    size_t batches = 0u;
 };
 
 struct IDHackStats : public SpecificStats {
@@ -113,6 +113,7 @@ WorkingSetID WorkingSet::emplace(WorkingSetMember&& wsm) {
 void WorkingSetMember::clear() {
     _metadata = DocumentMetadataFields{};
     keyData.clear();
+    retainedFields.reset();
     if (doc.value().hasExclusivelyOwnedStorage()) {
         // Reset the document to point to an empty BSON, which will preserve its underlying
         // DocumentStorage for future users of this WSM.
@@ -151,9 +152,26 @@ bool WorkingSetMember::hasOwnedObj() const {
 }
 
 void WorkingSetMember::makeObjOwnedIfNeeded() {
-    if (_state == RID_AND_OBJ && !doc.value().isOwned()) {
+    if (_state != RID_AND_OBJ || doc.value().isOwned()) {
+        return;
+    }
+
+    if (!retainedFields || doc.value().isModified()) {
         doc.value() = doc.value().getOwned();
+        return;
+    }
+
+    BSONObjBuilder bob;
+    auto nFieldsNeeded = retainedFields->size();
+    for (auto&& elt : doc.value().toBson()) {
+        if (retainedFields->count(elt.fieldNameStringData())) {
+            bob.append(elt);
+            if (--nFieldsNeeded == 0) {
+                break;
+            }
+        }
     }
+    resetDocument(doc.snapshotId(), bob.obj());
 }
 
 bool WorkingSetMember::getFieldDotted(const string& field, BSONElement* out) const {
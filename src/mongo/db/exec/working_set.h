@@ -38,6 +38,7 @@
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/snapshot.h"
 #include "mongo/stdx/unordered_set.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -154,6 +155,10 @@ public:
     Snapshotted<Document> doc;
     std::vector<IndexKeyDatum> keyData;
 
+    // If set, the only top-level fields of 'doc' that the rest of the plan depends on. An unowned
+    // 'doc' is then made owned by copying just these fields out of the storage engine's buffer.
+    std::shared_ptr<const StringSet> retainedFields;
+
     bool hasRecordId() const;
     bool hasObj() const;
     bool hasOwnedObj() const;
@@ -164,6 +169,8 @@ public:
      *
      * It is illegal for unowned BSON to survive a yield, so this must be called on any working set
      * members which may stay alive across yield points.
+     *
+     * If 'retainedFields' is set, the owned copy only contains those top-level fields.
      */
     void makeObjOwnedIfNeeded();
 
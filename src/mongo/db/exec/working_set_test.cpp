@@ -313,4 +313,21 @@ TEST_F(WorkingSetFixture, WsmCanBeExtractedAndReinserted) {
     ASSERT_FALSE(emplacedWsm->metadata());
 }
 
+TEST_F(WorkingSetFixture, MakingObjOwnedOnlyCopiesRetainedFields) {
+    BSONObj obj = BSON("_id" << 1 << "a" << 2 << "b" << BSON("c" << 3) << "d" << 4);
+    ws->transitionToRecordIdAndObj(id);
+    member->doc = {SnapshotId(), Document{BSONObj(obj.objdata())}};
+    member->retainedFields = std::make_shared<const StringSet>(StringSet{"_id", "b"});
+    ASSERT_FALSE(member->doc.value().isOwned());
+
+    member->makeObjOwnedIfNeeded();
+    ASSERT_TRUE(member->doc.value().isOwned());
+    ASSERT_BSONOBJ_EQ(member->doc.value().toBson(), BSON("_id" << 1 << "b" << BSON("c" << 3)));
+
+    // Freeing the member forgets the retained fields.
+    ws->free(id);
+    id = ws->allocate();
+    ASSERT_FALSE(ws->get(id)->retainedFields);
+}
+
 }  // namespace mongo
@@ -0,0 +1,65 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/jsobj.h"
+
+namespace mongo {
+
+/**
+ * This is the access method for "columnstore" indices. A column store index keeps a narrow copy
+ * of a fixed set of top-level fields of every document, so that queries which only touch those
+ * fields can scan the index instead of the collection.
+ */
+class ColumnStoreAccessMethod : public AbstractIndexAccessMethod {
+public:
+    ColumnStoreAccessMethod(IndexCatalogEntry* btreeState,
+                            std::unique_ptr<SortedDataInterface> btree);
+
+private:
+    /**
+     * Fills 'keys' with the single key that should be generated for 'obj' on this index.
+     *
+     * This function ignores the 'multikeyPaths' and 'multikeyMetadataKeys' pointers because array
+     * values are stored whole, so column store indexes are never multikey.
+     */
+    void doGetKeys(const BSONObj& obj,
+                   GetKeysContext context,
+                   KeyStringSet* keys,
+                   KeyStringSet* multikeyMetadataKeys,
+                   MultikeyPaths* multikeyPaths,
+                   boost::optional<RecordId> id) const final;
+
+    BSONObj _keyPattern;
+};
+
+}  // namespace mongo
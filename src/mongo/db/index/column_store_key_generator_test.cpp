@@ -0,0 +1,85 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/expression_keys_private.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/json.h"
+#include "mongo/unittest/unittest.h"
+
+using namespace mongo;
+
+namespace {
+
+const BSONObj kKeyPattern = BSON("a"
+                                 << "columnstore"
+                                 << "b"
+                                 << "columnstore"
+                                 << "c"
+                                 << "columnstore");
+
+BSONObj getOnlyKey(const BSONObj& obj) {
+    KeyStringSet keys;
+    ExpressionKeysPrivate::getColumnStoreKeys(
+        obj, kKeyPattern, &keys, KeyString::Version::kLatestVersion, Ordering::make(kKeyPattern));
+    ASSERT_EQ(keys.size(), 1U);
+    return KeyString::toBson(*keys.begin(), Ordering::make(kKeyPattern));
+}
+
+TEST(ColumnStoreKeyGeneratorTest, StoresEachIndexedValueWithItsPosition) {
+    auto key = getOnlyKey(fromjson("{_id: 0, c: 'x', a: 1, d: 2}"));
+    ASSERT_BSONOBJ_EQ(key, fromjson("{'': [1, 1], '': [], '': ['x', 0]}"));
+}
+
+TEST(ColumnStoreKeyGeneratorTest, ArraysAreStoredWhole) {
+    auto key = getOnlyKey(fromjson("{a: [1, 2], b: [], c: null}"));
+    ASSERT_BSONOBJ_EQ(key, fromjson("{'': [[1, 2], 0], '': [[], 1], '': [null, 2]}"));
+}
+
+TEST(ColumnStoreKeyGeneratorTest, DocumentRoundTripsThroughKey) {
+    auto obj = fromjson("{a: {x: 1, y: [NumberLong(2), 3.5]}, c: NumberDecimal('1.0'), d: 4}");
+    auto rebuilt =
+        ExpressionKeysPrivate::documentFromColumnStoreKey(kKeyPattern, getOnlyKey(obj));
+
+    // The missing field 'b' stays missing, and the unindexed field 'd' is dropped.
+    auto expected = fromjson("{a: {x: 1, y: [NumberLong(2), 3.5]}, c: NumberDecimal('1.0')}");
+    ASSERT_TRUE(rebuilt.binaryEqual(expected)) << rebuilt;
+}
+
+TEST(ColumnStoreKeyGeneratorTest, RebuiltDocumentKeepsFieldOrder) {
+    auto obj = fromjson("{c: 1, _id: 0, b: 2, a: 3}");
+    auto rebuilt =
+        ExpressionKeysPrivate::documentFromColumnStoreKey(kKeyPattern, getOnlyKey(obj));
+    ASSERT_TRUE(rebuilt.binaryEqual(fromjson("{c: 1, b: 2, a: 3}"))) << rebuilt;
+}
+
+}  // namespace
@@ -31,7 +31,9 @@
 
 #include "mongo/db/index/expression_keys_private.h"
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "mongo/bson/bsonelement_comparator_interface.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
@@ -362,6 +364,80 @@ void ExpressionKeysPrivate::get2DKeys(const BSONObj& obj,
     }
 }
 
+// static
+void ExpressionKeysPrivate::getColumnStoreKeys(const BSONObj& obj,
+                                               const BSONObj& keyPattern,
+                                               KeyStringSet* keys,
+                                               KeyString::Version keyStringVersion,
+                                               Ordering ordering,
+                                               boost::optional<RecordId> id) {
+    // Find the indexed fields in the order 'obj' holds them, keeping the first of any duplicates.
+    std::vector<BSONElement> values(keyPattern.nFields());
+    std::vector<int> positions(keyPattern.nFields());
+    int position = 0;
+    for (auto&& field : obj) {
+        size_t column = 0;
+        for (auto&& indexEntry : keyPattern) {
+            if (field.fieldNameStringData() == indexEntry.fieldNameStringData()) {
+                if (!values[column]) {
+                    values[column] = field;
+                    positions[column] = position++;
+                }
+                break;
+            }
+            ++column;
+        }
+    }
+
+    BSONObjBuilder keyBuilder;
+    for (size_t column = 0; column < values.size(); ++column) {
+        BSONArrayBuilder columnBuilder(keyBuilder.subarrayStart(""));
+        if (values[column]) {
+            columnBuilder.append(values[column]);
+            columnBuilder.append(positions[column]);
+        }
+    }
+
+    KeyString::HeapBuilder keyString(keyStringVersion, keyBuilder.obj(), ordering);
+    if (id) {
+        keyString.appendRecordId(*id);
+    }
+    keys->insert(keyString.release());
+}
+
+// static
+BSONObj ExpressionKeysPrivate::documentFromColumnStoreKey(const BSONObj& keyPattern,
+                                                          const BSONObj& key) {
+    struct Field {
+        int position;
+        StringData name;
+        BSONElement value;
+    };
+    std::vector<Field> fields;
+    BSONObjIterator keyIt(key);
+    for (auto&& indexEntry : keyPattern) {
+        invariant(keyIt.more());
+        auto column = keyIt.next();
+        invariant(column.type() == BSONType::Array);
+        BSONObjIterator columnIt(column.embeddedObject());
+        if (columnIt.more()) {
+            auto value = columnIt.next();
+            invariant(columnIt.more());
+            auto position = columnIt.next().numberInt();
+            fields.push_back({position, indexEntry.fieldNameStringData(), value});
+        }
+    }
+
+    std::sort(fields.begin(), fields.end(), [](const Field& lhs, const Field& rhs) {
+        return lhs.position < rhs.position;
+    });
+    BSONObjBuilder bob;
+    for (const auto& field : fields) {
+        bob.appendAs(field.value, field.name);
+    }
+    return bob.obj();
+}
+
 // static
 void ExpressionKeysPrivate::getFTSKeys(const BSONObj& obj,
                                        const fts::FTSSpec& ftsSpec,
@@ -67,6 +67,31 @@ public:
                           Ordering ordering,
                           boost::optional<RecordId> id = boost::none);
 
+    //
+    // Column store
+    //
+
+    /**
+     * Generates the single key stored for 'obj' in a column store index. Each field of the key
+     * holds [value, position] for the corresponding top-level field of 'obj', where 'position' is
+     * the field's rank among the indexed fields of 'obj', or an empty array if 'obj' lacks the
+     * field. The document can then be rebuilt from the key with its field order, and without
+     * losing the distinction between a missing field and a null one.
+     */
+    static void getColumnStoreKeys(const BSONObj& obj,
+                                   const BSONObj& keyPattern,
+                                   KeyStringSet* keys,
+                                   KeyString::Version keyStringVersion,
+                                   Ordering ordering,
+                                   boost::optional<RecordId> id = boost::none);
+
+    /**
+     * Inverse of getColumnStoreKeys(): rebuilds a document containing the indexed fields of the
+     * original document, in the original order, from a column store index key with its field
+     * names stripped.
+     */
+    static BSONObj documentFromColumnStoreKey(const BSONObj& keyPattern, const BSONObj& key);
+
     //
     // FTS
     //
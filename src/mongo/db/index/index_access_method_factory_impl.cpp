@@ -35,6 +35,7 @@
 
 #include "mongo/db/index/2d_access_method.h"
 #include "mongo/db/index/btree_access_method.h"
+#include "mongo/db/index/column_store_access_method.h"
 #include "mongo/db/index/fts_access_method.h"
 #include "mongo/db/index/hash_access_method.h"
 #include "mongo/db/index/haystack_access_method.h"
@@ -62,6 +63,8 @@ std::unique_ptr<IndexAccessMethod> IndexAccessMethodFactoryImpl::make(
         return std::make_unique<TwoDAccessMethod>(entry, std::move(sortedDataInterface));
     else if (IndexNames::WILDCARD == type)
         return std::make_unique<WildcardAccessMethod>(entry, std::move(sortedDataInterface));
+    else if (IndexNames::COLUMN_STORE == type)
+        return std::make_unique<ColumnStoreAccessMethod>(entry, std::move(sortedDataInterface));
     LOGV2(20688,
           "Can't find index for keyPattern {desc_keyPattern}",
           "desc_keyPattern"_attr = desc->keyPattern());
@@ -43,6 +43,7 @@ const string IndexNames::TEXT = "text";
 const string IndexNames::HASHED = "hashed";
 const string IndexNames::BTREE = "";
 const string IndexNames::WILDCARD = "wildcard";
+const string IndexNames::COLUMN_STORE = "columnstore";
 
 const StringMap<IndexType> kIndexNameToType = {
     {IndexNames::GEO_2D, INDEX_2D},
@@ -51,6 +52,7 @@ const StringMap<IndexType> kIndexNameToType = {
     {IndexNames::TEXT, INDEX_TEXT},
     {IndexNames::HASHED, INDEX_HASHED},
     {IndexNames::WILDCARD, INDEX_WILDCARD},
+    {IndexNames::COLUMN_STORE, INDEX_COLUMN_STORE},
 };
 
 // static
@@ -40,6 +40,7 @@
 #include "mongo/db/catalog/collection_options.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/document_validation.h"
+#include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog_raii.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
@@ -73,6 +74,7 @@
 #include "mongo/db/stats/server_write_concern_metrics.h"
 #include "mongo/db/stats/top.h"
 #include "mongo/db/storage/duplicate_key_error_info.h"
+#include "mongo/db/storage/flow_control.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/db/write_concern.h"
 #include "mongo/logv2/log.h"
@@ -304,6 +306,31 @@ LockMode fixLockModeForSystemDotViewsChanges(const NamespaceString& nss, LockMod
     return nss.isSystemDotViews() ? MODE_X : mode;
 }
 
+/**
+ * Blocks while flow control is throttling writes to 'nss'. Like the global flow control ticket,
+ * this is only waited for when the operation holds no locks.
+ */
+void waitForFlowControlNamespaceBudget(OperationContext* opCtx, const NamespaceString& nss) {
+    auto flowControl = FlowControl::get(opCtx);
+    if (!flowControl || !opCtx->shouldParticipateInFlowControl() ||
+        opCtx->lockState()->isLocked()) {
+        return;
+    }
+    flowControl->waitForNamespaceBudget(opCtx, nss);
+}
+
+void recordFlowControlWriteCost(OperationContext* opCtx,
+                                const Collection* collection,
+                                std::int64_t numDocs,
+                                std::int64_t bytes) {
+    auto flowControl = FlowControl::get(opCtx);
+    if (!flowControl || !collection || numDocs == 0) {
+        return;
+    }
+    const auto numIndexes = collection->getIndexCatalog()->numIndexesTotal(opCtx);
+    flowControl->recordWrite(collection->ns(), FlowControl::writeCost(numDocs, bytes, numIndexes));
+}
+
 void insertDocuments(OperationContext* opCtx,
                      Collection* collection,
                      std::vector<InsertStatement>::iterator begin,
@@ -349,6 +376,12 @@ void insertDocuments(OperationContext* opCtx,
     uassertStatusOK(
         collection->insertDocuments(opCtx, begin, end, &CurOp::get(opCtx)->debug(), fromMigrate));
     wuow.commit();
+
+    std::int64_t bytes = 0;
+    for (auto it = begin; it != end; ++it) {
+        bytes += it->doc.objsize();
+    }
+    recordFlowControlWriteCost(opCtx, collection, batchSize, bytes);
 }
 
 /**
@@ -404,6 +437,8 @@ bool insertBatchAndHandleErrors(OperationContext* opCtx,
         uasserted(ErrorCodes::InternalError, "failAllInserts failpoint active!");
     }
 
+    waitForFlowControlNamespaceBudget(opCtx, wholeOp.getNamespace());
+
     boost::optional<AutoGetCollection> collection;
     auto acquireCollection = [&] {
         while (true) {
@@ -639,6 +674,8 @@ static SingleWriteResult performSingleUpdateOp(OperationContext* opCtx,
         uasserted(ErrorCodes::InternalError, "failAllUpdates failpoint active!");
     }
 
+    waitForFlowControlNamespaceBudget(opCtx, ns);
+
     boost::optional<AutoGetCollection> collection;
     while (true) {
         collection.emplace(opCtx, ns, fixLockModeForSystemDotViewsChanges(ns, MODE_IX));
@@ -697,6 +734,8 @@ static SingleWriteResult performSingleUpdateOp(OperationContext* opCtx,
 
     const bool didInsert = !res.upserted.isEmpty();
     const long long nMatchedOrInserted = didInsert ? 1 : res.numMatched;
+    recordFlowControlWriteCost(
+        opCtx, collection->getCollection(), res.numDocsModified + (didInsert ? 1 : 0), 0);
     LastError::get(opCtx->getClient()).recordUpdate(res.existing, nMatchedOrInserted, res.upserted);
 
     SingleWriteResult result;
@@ -898,6 +937,8 @@ static SingleWriteResult performSingleDeleteOp(OperationContext* opCtx,
         uasserted(ErrorCodes::InternalError, "failAllRemoves failpoint active!");
     }
 
+    waitForFlowControlNamespaceBudget(opCtx, ns);
+
     AutoGetCollection collection(opCtx, ns, fixLockModeForSystemDotViewsChanges(ns, MODE_IX));
 
     if (collection.getDb()) {
@@ -920,6 +961,7 @@ static SingleWriteResult performSingleDeleteOp(OperationContext* opCtx,
     uassertStatusOK(exec->executePlan());
     long long n = DeleteStage::getNumDeleted(*exec);
     curOp.debug().additiveMetrics.ndeleted = n;
+    recordFlowControlWriteCost(opCtx, collection.getCollection(), n, 0);
 
     PlanSummaryStats summary;
     Explain::getSummaryStats(*exec, &summary);
@@ -157,6 +157,9 @@ size_t getKeysExamined(StageType type, const SpecificStats* specific) {
     } else if (STAGE_COUNT_SCAN == type) {
         const CountScanStats* spec = static_cast<const CountScanStats*>(specific);
         return spec->keysExamined;
+    } else if (STAGE_COLUMN_SCAN == type) {
+        const ColumnScanStats* spec = static_cast<const ColumnScanStats*>(specific);
+        return spec->keysExamined;
     } else if (STAGE_DISTINCT_SCAN == type) {
         const DistinctScanStats* spec = static_cast<const DistinctScanStats*>(specific);
         return spec->keysExamined;
@@ -206,6 +209,10 @@ void addStageSummaryStr(const PlanStage* stage, StringBuilder& sb) {
         const CountScanStats* spec = static_cast<const CountScanStats*>(specific);
         const KeyPattern keyPattern{spec->keyPattern};
         sb << " " << keyPattern;
+    } else if (STAGE_COLUMN_SCAN == stage->stageType()) {
+        const ColumnScanStats* spec = static_cast<const ColumnScanStats*>(specific);
+        const KeyPattern keyPattern{spec->keyPattern};
+        sb << " " << keyPattern;
     } else if (STAGE_DISTINCT_SCAN == stage->stageType()) {
         const DistinctScanStats* spec = static_cast<const DistinctScanStats*>(specific);
         const KeyPattern keyPattern{spec->keyPattern};
@@ -372,6 +379,14 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("docsExamined", spec->docsTested);
         }
+    } else if (STAGE_COLUMN_SCAN == stats.stageType) {
+        ColumnScanStats* spec = static_cast<ColumnScanStats*>(stats.specific.get());
+        bob->append("keyPattern", spec->keyPattern);
+        bob->append("indexName", spec->indexName);
+        if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
+            bob->appendNumber("keysExamined", spec->keysExamined);
+            bob->appendNumber("docsTested", spec->docsTested);
+        }
     } else if (STAGE_COUNT == stats.stageType) {
         CountStats* spec = static_cast<CountStats*>(stats.specific.get());
 
@@ -450,6 +465,9 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("docsExamined", spec->docsExamined);
             bob->appendNumber("alreadyHasObj", spec->alreadyHasObj);
+            if (spec->batches > 0) {
+                bob->appendNumber("batches", spec->batches);
+            }
         }
     } else if (STAGE_GEO_NEAR_2D == stats.stageType || STAGE_GEO_NEAR_2DSPHERE == stats.stageType) {
         NearStats* spec = static_cast<NearStats*>(stats.specific.get());
@@ -986,6 +1004,10 @@ void Explain::getSummaryStats(const PlanExecutor& exec, PlanSummaryStats* statsO
             const IndexScanStats* ixscanStats =
                 static_cast<const IndexScanStats*>(ixscan->getSpecificStats());
             statsOut->indexesUsed.insert(ixscanStats->indexName);
+        } else if (STAGE_COLUMN_SCAN == stages[i]->stageType()) {
+            const ColumnScanStats* columnScanStats =
+                static_cast<const ColumnScanStats*>(stages[i]->getSpecificStats());
+            statsOut->indexesUsed.insert(columnScanStats->indexName);
         } else if (STAGE_COUNT_SCAN == stages[i]->stageType()) {
             const CountScan* countScan = static_cast<const CountScan*>(stages[i]);
             const CountScanStats* countScanStats =
@@ -260,8 +260,10 @@ void fillOutPlannerParams(OperationContext* opCtx,
         collection->getIndexCatalog()->getIndexIterator(opCtx, false);
     while (ii->more()) {
         const IndexCatalogEntry* ice = ii->next();
-        plannerParams->indices.push_back(
-            indexEntryFromIndexCatalogEntry(opCtx, *ice, canonicalQuery));
+        auto& indexList = ice->descriptor()->getIndexType() == IndexType::INDEX_COLUMN_STORE
+            ? plannerParams->columnStoreIndexes
+            : plannerParams->indices;
+        indexList.push_back(indexEntryFromIndexCatalogEntry(opCtx, *ice, canonicalQuery));
     }
 
     // If query supports index filters, filter params.indices by indices in query settings.
@@ -1422,6 +1424,9 @@ bool turnIxscanIntoDistinctIxscan(QuerySolution* soln,
 
             // Make the fetch the new root. This destroys the project stage.
             soln->root.reset(fetchNode);
+
+            // The fetched documents are now returned in full, so nothing may be trimmed from them.
+            fetchNode->retainedFields.clear();
         }
 
         // Whenver we have a FETCH node, the IXSCAN is its child. We detach the IXSCAN from the
@@ -1466,6 +1471,10 @@ QueryPlannerParams fillOutPlannerParamsForDistinct(OperationContext* opCtx,
     while (ii->more()) {
         const IndexCatalogEntry* ice = ii->next();
         const IndexDescriptor* desc = ice->descriptor();
+        if (desc->getIndexType() == IndexType::INDEX_COLUMN_STORE) {
+            continue;
+        }
+
         if (desc->keyPattern().hasField(parsedDistinct.getKey())) {
             if (!mayUnwindArrays &&
                 isAnyComponentOfPathMultikey(desc->keyPattern(),
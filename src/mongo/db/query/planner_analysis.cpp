@@ -467,6 +467,76 @@ std::unique_ptr<QuerySolutionNode> tryPushdownProjectBeneathSort(
     return ownedSortNode;
 }
 
+/**
+ * Given the solution tree 'root', looks for an inclusion projection which is only separated from
+ * the FETCH or COLLSCAN producing its documents by stages which do not need anything beyond a known
+ * set of top-level fields. If found, records these fields on the data access node so that results
+ * which must be copied out of the storage engine's buffers (e.g. because they are spooled by a SORT
+ * or buffered across a yield) only copy the parts of the document the plan still depends on.
+ *
+ * Does not change the shape of the tree.
+ */
+void tryPushdownProjectionIntoDataAccess(QuerySolutionNode* root, const QueryPlannerParams& params) {
+    auto topLevelField = [](StringData path) { return path.substr(0, path.find('.')).toString(); };
+
+    // Stages above the projection only see its output, so skip over them.
+    auto node = root;
+    while (node->children.size() == 1u &&
+           (STAGE_LIMIT == node->getType() || STAGE_SKIP == node->getType() ||
+            isSortStageType(node->getType()))) {
+        node = node->children[0];
+    }
+
+    if (!isProjectionStageType(node->getType())) {
+        return;
+    }
+
+    auto projectNode = static_cast<ProjectionNode*>(node);
+    if (!projectNode->proj.isInclusionOnly()) {
+        return;
+    }
+
+    std::set<std::string> fields;
+    for (auto&& field : projectNode->proj.getRequiredFields()) {
+        fields.insert(topLevelField(field));
+    }
+
+    node = projectNode->children[0];
+    while (node->children.size() == 1u) {
+        switch (node->getType()) {
+            case STAGE_LIMIT:
+            case STAGE_SKIP:
+                break;
+            case STAGE_SORT_SIMPLE:
+            case STAGE_SORT_DEFAULT:
+                for (auto&& sortComponent : static_cast<SortNode*>(node)->pattern) {
+                    fields.insert(topLevelField(sortComponent.fieldNameStringData()));
+                }
+                break;
+            case STAGE_SORT_KEY_GENERATOR:
+                for (auto&& sortComponent : static_cast<SortKeyGeneratorNode*>(node)->sortSpec) {
+                    fields.insert(topLevelField(sortComponent.fieldNameStringData()));
+                }
+                break;
+            case STAGE_SHARDING_FILTER:
+                for (auto&& shardKeyField : params.shardKey) {
+                    fields.insert(topLevelField(shardKeyField.fieldNameStringData()));
+                }
+                break;
+            case STAGE_FETCH:
+                static_cast<FetchNode*>(node)->retainedFields = std::move(fields);
+                return;
+            default:
+                return;
+        }
+        node = node->children[0];
+    }
+
+    if (STAGE_COLLSCAN == node->getType()) {
+        static_cast<CollectionScanNode*>(node)->retainedFields = std::move(fields);
+    }
+}
+
 bool canUseSimpleSort(const QuerySolutionNode& solnRoot,
                       const CanonicalQuery& cq,
                       const QueryPlannerParams& plannerParams) {
@@ -948,6 +1018,7 @@ std::unique_ptr<QuerySolution> QueryPlannerAnalysis::analyzeDataAccess(
     }
 
     solnRoot = tryPushdownProjectBeneathSort(std::move(solnRoot));
+    tryPushdownProjectionIntoDataAccess(solnRoot.get(), params);
 
     soln->root = std::move(solnRoot);
     return soln;
@@ -44,6 +44,7 @@
 #include "mongo/db/matcher/expression_algo.h"
 #include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/matcher/expression_text.h"
+#include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/collation/collator_interface.h"
@@ -287,6 +288,53 @@ std::unique_ptr<QuerySolution> buildWholeIXSoln(const IndexEntry& index,
     return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
 }
 
+/**
+ * Returns a solution scanning the column store index 'index' in place of the collection, or
+ * nullptr if the query may read a field that the index does not store.
+ */
+std::unique_ptr<QuerySolution> buildColumnScanSoln(const IndexEntry& index,
+                                                   const CanonicalQuery& query,
+                                                   const QueryPlannerParams& params) {
+    invariant(index.type == INDEX_COLUMN_STORE);
+
+    // A column scan returns partial documents without record ids, so the query must project onto
+    // a known set of fields.
+    const auto* projection = query.getProj();
+    if (!projection || !projection->isInclusionOnly() ||
+        (params.options & QueryPlannerParams::PRESERVE_RECORD_ID) ||
+        QueryPlannerCommon::hasNode(query.root(), MatchExpression::GEO_NEAR) ||
+        QueryPlannerCommon::hasNode(query.root(), MatchExpression::TEXT)) {
+        return nullptr;
+    }
+
+    DepsTracker deps;
+    query.root()->addDependencies(&deps);
+    if (deps.needWholeDocument) {
+        return nullptr;
+    }
+
+    auto fields = std::move(deps.fields);
+    fields.insert(projection->getRequiredFields().begin(), projection->getRequiredFields().end());
+    for (auto&& sortElt : query.getQueryRequest().getSort()) {
+        fields.insert(sortElt.fieldName());
+    }
+    if (params.options & QueryPlannerParams::INCLUDE_SHARD_FILTER) {
+        for (auto&& shardKeyElt : params.shardKey) {
+            fields.insert(shardKeyElt.fieldName());
+        }
+    }
+
+    for (auto&& field : fields) {
+        if (!index.keyPattern.hasField(StringData(field).substr(0, field.find('.')))) {
+            return nullptr;
+        }
+    }
+
+    auto csn = std::make_unique<ColumnScanNode>(index);
+    csn->filter = query.root()->shallowClone();
+    return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(csn));
+}
+
 bool providesSort(const CanonicalQuery& query, const BSONObj& kp) {
     return query.getQueryRequest().getSort().isPrefixOf(kp, SimpleBSONElementComparator::kInstance);
 }
@@ -1046,6 +1094,21 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         }
     }
 
+    // Without an indexed plan, prefer scanning a column store index which holds every field the
+    // query reads over scanning the full documents in the collection.
+    if (out.empty() && hintedIndex.isEmpty()) {
+        for (auto&& index : params.columnStoreIndexes) {
+            if (auto soln = buildColumnScanSoln(index, query, params)) {
+                LOGV2_DEBUG(4937700,
+                            5,
+                            "Planner: outputting a column scan:\n{columnScan}",
+                            "columnScan"_attr = redact(soln->toString()));
+                out.push_back(std::move(soln));
+                break;
+            }
+        }
+    }
+
     // The caller can explicitly ask for a collscan.
     bool collscanRequested = (params.options & QueryPlannerParams::INCLUDE_COLLSCAN);
 
@@ -0,0 +1,132 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_planner_test_fixture.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * A specialization of the QueryPlannerTest fixture which makes it easy to present the planner
+ * with a view of the available column store indexes.
+ */
+class QueryPlannerColumnStoreTest : public QueryPlannerTest {
+protected:
+    void setUp() final {
+        QueryPlannerTest::setUp();
+
+        // Only output a collection scan when there is no other choice.
+        params.options &= ~QueryPlannerParams::INCLUDE_COLLSCAN;
+    }
+
+    void addColumnStoreIndex(BSONObj keyPattern) {
+        params.columnStoreIndexes.push_back({keyPattern,
+                                             INDEX_COLUMN_STORE,
+                                             false,  // multikey
+                                             {},
+                                             {},
+                                             false,  // sparse
+                                             false,  // unique
+                                             IndexEntry::Identifier{"columnstore"},
+                                             nullptr,  // filterExpr
+                                             BSONObj(),
+                                             nullptr,
+                                             nullptr});
+    }
+
+    /**
+     * Returns the type of the leaf of the only solution, which must be a single chain of stages.
+     */
+    StageType onlySolutionLeafType() const {
+        assertNumSolutions(1U);
+        const auto* node = solns.front()->root.get();
+        while (!node->children.empty()) {
+            ASSERT_EQ(node->children.size(), 1U);
+            node = node->children[0];
+        }
+        return node->getType();
+    }
+
+    const BSONObj kColumnStoreKeyPattern = BSON("a"
+                                                << "columnstore"
+                                                << "b"
+                                                << "columnstore");
+};
+
+TEST_F(QueryPlannerColumnStoreTest, UsesColumnScanWhenIndexCoversFilterAndProjection) {
+    addColumnStoreIndex(kColumnStoreKeyPattern);
+
+    runQuerySortProj(fromjson("{a: {$gt: 3}, 'b.c': 1}"), BSONObj(), fromjson("{_id: 0, b: 1}"));
+    ASSERT_EQ(onlySolutionLeafType(), STAGE_COLUMN_SCAN);
+}
+
+TEST_F(QueryPlannerColumnStoreTest, UsesColumnScanWithSortOnIndexedField) {
+    addColumnStoreIndex(kColumnStoreKeyPattern);
+
+    runQuerySortProj(BSONObj(), fromjson("{b: -1}"), fromjson("{_id: 0, a: 1}"));
+    ASSERT_EQ(onlySolutionLeafType(), STAGE_COLUMN_SCAN);
+}
+
+TEST_F(QueryPlannerColumnStoreTest, DoesNotUseColumnScanWhenFilterReadsUnindexedField) {
+    addColumnStoreIndex(kColumnStoreKeyPattern);
+
+    runQuerySortProj(fromjson("{a: 1, c: 2}"), BSONObj(), fromjson("{_id: 0, a: 1}"));
+    assertHasOnlyCollscan();
+}
+
+TEST_F(QueryPlannerColumnStoreTest, DoesNotUseColumnScanWhenProjectionIncludesUnindexedField) {
+    addColumnStoreIndex(kColumnStoreKeyPattern);
+
+    // The projection implicitly includes '_id', which is not indexed.
+    runQuerySortProj(fromjson("{a: 1}"), BSONObj(), fromjson("{a: 1}"));
+    assertHasOnlyCollscan();
+}
+
+TEST_F(QueryPlannerColumnStoreTest, DoesNotUseColumnScanWithoutProjection) {
+    addColumnStoreIndex(kColumnStoreKeyPattern);
+
+    runQuery(fromjson("{a: 1}"));
+    assertHasOnlyCollscan();
+}
+
+TEST_F(QueryPlannerColumnStoreTest, PrefersIndexedPlanOverColumnScan) {
+    addColumnStoreIndex(kColumnStoreKeyPattern);
+    addIndex(BSON("a" << 1));
+
+    runQuerySortProj(fromjson("{a: 1}"), BSONObj(), fromjson("{_id: 0, a: 1, b: 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1, b: 1}, node: {fetch: {node: {ixscan: {pattern: {a: 1}}}}}}}");
+}
+
+}  // namespace
+}  // namespace mongo
@@ -934,5 +934,29 @@ TEST_F(QueryPlannerTest, PreserveRecordIdOptionPrecludesSimpleSort) {
         "{sort: {pattern: {a: 1}, limit: 0, type: 'default', node: {cscan: {dir: 1}}}}");
 }
 
+TEST_F(QueryPlannerTest, InclusionProjectionFieldsArePushedIntoCollectionScan) {
+    runQueryAsCommand(
+        fromjson("{find: 'testns', projection: {a: 1, 'b.c': 1}, sort: {d: 1}, limit: 3}"));
+    assertHasOnlyCollscan();
+
+    const auto* node = solns.front()->root.get();
+    while (STAGE_COLLSCAN != node->getType()) {
+        node = node->children[0];
+    }
+    const auto* csn = static_cast<const CollectionScanNode*>(node);
+    ASSERT(std::set<std::string>({"_id", "a", "b", "d"}) == csn->retainedFields);
+}
+
+TEST_F(QueryPlannerTest, ExclusionProjectionFieldsAreNotPushedIntoCollectionScan) {
+    runQueryAsCommand(fromjson("{find: 'testns', projection: {a: 0}}"));
+    assertHasOnlyCollscan();
+
+    const auto* node = solns.front()->root.get();
+    while (STAGE_COLLSCAN != node->getType()) {
+        node = node->children[0];
+    }
+    ASSERT_TRUE(static_cast<const CollectionScanNode*>(node)->retainedFields.empty());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -105,6 +105,10 @@ struct QueryPlannerParams {
     // What indices are available for planning?
     std::vector<IndexEntry> indices;
 
+    // Column store indexes are kept apart from 'indices', since they cannot answer predicates and
+    // are only used to replace a collection scan when they hold every field the query reads.
+    std::vector<IndexEntry> columnStoreIndexes;
+
     // What's our shard key?  If INCLUDE_SHARD_FILTER is set we will create a shard filtering
     // stage.  If we know the shard key, we can perform covering analysis instead of always
     // forcing a fetch.
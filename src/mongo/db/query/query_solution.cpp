@@ -159,6 +159,16 @@ void addEqualityFieldSorts(const BSONObj& sortPattern,
         sortsOut->insert(prefixBob.obj());
     }
 }
+
+std::string retainedFieldsToString(const std::set<std::string>& fields) {
+    str::stream ss;
+    ss << "{";
+    for (auto it = fields.begin(); it != fields.end(); ++it) {
+        ss << (it == fields.begin() ? " " : ", ") << *it;
+    }
+    ss << " }";
+    return ss;
+}
 }  // namespace
 
 string QuerySolutionNode::toString() const {
@@ -242,6 +252,10 @@ void CollectionScanNode::appendToString(str::stream* ss, int indent) const {
         addIndent(ss, indent + 1);
         *ss << "filter = " << filter->debugString();
     }
+    if (!retainedFields.empty()) {
+        addIndent(ss, indent + 1);
+        *ss << "retainedFields = " << retainedFieldsToString(retainedFields) << '\n';
+    }
     addCommon(ss, indent);
 }
 
@@ -255,6 +269,40 @@ QuerySolutionNode* CollectionScanNode::clone() const {
     copy->direction = this->direction;
     copy->shouldTrackLatestOplogTimestamp = this->shouldTrackLatestOplogTimestamp;
     copy->shouldWaitForOplogVisibility = this->shouldWaitForOplogVisibility;
+    copy->retainedFields = this->retainedFields;
+
+    return copy;
+}
+
+//
+// ColumnScanNode
+//
+
+void ColumnScanNode::appendToString(str::stream* ss, int indent) const {
+    addIndent(ss, indent);
+    *ss << "COLUMN_SCAN\n";
+    addIndent(ss, indent + 1);
+    *ss << "name = " << index.identifier.catalogName << '\n';
+    addIndent(ss, indent + 1);
+    *ss << "keyPattern = " << index.keyPattern << '\n';
+    if (nullptr != filter) {
+        addIndent(ss, indent + 1);
+        *ss << "filter = " << filter->debugString();
+    }
+    addCommon(ss, indent);
+}
+
+FieldAvailability ColumnScanNode::getFieldAvailability(const std::string& field) const {
+    auto topLevelField = StringData(field).substr(0, field.find('.'));
+    return index.keyPattern.hasField(topLevelField) ? FieldAvailability::kFullyProvided
+                                                    : FieldAvailability::kNotProvided;
+}
+
+QuerySolutionNode* ColumnScanNode::clone() const {
+    ColumnScanNode* copy = new ColumnScanNode(this->index);
+    cloneBaseData(copy);
+
+    copy->sorts = this->sorts;
 
     return copy;
 }
@@ -495,6 +543,10 @@ void FetchNode::appendToString(str::stream* ss, int indent) const {
         filter->debugString(sb, indent + 2);
         *ss << sb.str();
     }
+    if (!retainedFields.empty()) {
+        addIndent(ss, indent + 1);
+        *ss << "retainedFields = " << retainedFieldsToString(retainedFields) << '\n';
+    }
     addCommon(ss, indent);
     addIndent(ss, indent + 1);
     *ss << "Child:" << '\n';
@@ -506,6 +558,7 @@ QuerySolutionNode* FetchNode::clone() const {
     cloneBaseData(copy);
 
     copy->_sorts = this->_sorts;
+    copy->retainedFields = this->retainedFields;
 
     return copy;
 }
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <memory>
+#include <set>
 
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonobj_comparator_interface.h"
@@ -375,6 +376,44 @@ struct CollectionScanNode : public QuerySolutionNode {
 
     // Once the first matching document is found, assume that all documents after it must match.
     bool stopApplyingFilterAfterFirstMatch = false;
+
+    // If non-empty, the top-level fields of the scanned documents that the rest of the plan
+    // depends on. Only these fields are copied when a result has to outlive the storage cursor.
+    std::set<std::string> retainedFields;
+};
+
+/**
+ * Scans every key of a column store index, producing documents that hold only the indexed fields.
+ * Only valid when those fields cover everything the rest of the plan reads.
+ */
+struct ColumnScanNode : public QuerySolutionNode {
+    ColumnScanNode(IndexEntry index)
+        : sorts(SimpleBSONObjComparator::kInstance.makeBSONObjSet()), index(std::move(index)) {}
+
+    virtual ~ColumnScanNode() {}
+
+    virtual StageType getType() const {
+        return STAGE_COLUMN_SCAN;
+    }
+
+    virtual void appendToString(str::stream* ss, int indent) const;
+
+    bool fetched() const {
+        return true;
+    }
+    FieldAvailability getFieldAvailability(const std::string& field) const;
+    bool sortedByDiskLoc() const {
+        return false;
+    }
+    const BSONObjSet& getSort() const {
+        return sorts;
+    }
+
+    QuerySolutionNode* clone() const;
+
+    BSONObjSet sorts;
+
+    IndexEntry index;
 };
 
 struct AndHashNode : public QuerySolutionNode {
@@ -515,6 +554,10 @@ struct FetchNode : public QuerySolutionNode {
     QuerySolutionNode* clone() const;
 
     BSONObjSet _sorts;
+
+    // If non-empty, the top-level fields of the fetched documents that the rest of the plan
+    // depends on. Only these fields are copied when a result has to outlive the storage cursor.
+    std::set<std::string> retainedFields;
 };
 
 struct IndexScanNode : public QuerySolutionNode {
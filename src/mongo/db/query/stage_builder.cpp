@@ -42,6 +42,7 @@
 #include "mongo/db/exec/and_hash.h"
 #include "mongo/db/exec/and_sorted.h"
 #include "mongo/db/exec/collection_scan.h"
+#include "mongo/db/exec/column_scan.h"
 #include "mongo/db/exec/count_scan.h"
 #include "mongo/db/exec/distinct_scan.h"
 #include "mongo/db/exec/ensure_sorted.h"
@@ -89,9 +90,26 @@ std::unique_ptr<PlanStage> buildStages(OperationContext* opCtx,
             params.requestResumeToken = csn->requestResumeToken;
             params.resumeAfterRecordId = csn->resumeAfterRecordId;
             params.stopApplyingFilterAfterFirstMatch = csn->stopApplyingFilterAfterFirstMatch;
+            if (!csn->retainedFields.empty()) {
+                params.retainedFields = std::make_shared<const StringSet>(
+                    csn->retainedFields.begin(), csn->retainedFields.end());
+            }
             return std::make_unique<CollectionScan>(
                 expCtx, collection, params, ws, csn->filter.get());
         }
+        case STAGE_COLUMN_SCAN: {
+            const ColumnScanNode* csn = static_cast<const ColumnScanNode*>(root);
+
+            invariant(collection);
+            auto descriptor = collection->getIndexCatalog()->findIndexByName(
+                opCtx, csn->index.identifier.catalogName);
+            invariant(descriptor,
+                      str::stream() << "Namespace: " << collection->ns()
+                                    << ", CanonicalQuery: " << cq.toStringShort()
+                                    << ", IndexEntry: " << csn->index.toString());
+
+            return std::make_unique<ColumnScan>(expCtx, descriptor, ws, csn->filter.get());
+        }
         case STAGE_IXSCAN: {
             const IndexScanNode* ixn = static_cast<const IndexScanNode*>(root);
 
@@ -119,8 +137,17 @@ std::unique_ptr<PlanStage> buildStages(OperationContext* opCtx,
         case STAGE_FETCH: {
             const FetchNode* fn = static_cast<const FetchNode*>(root);
             auto childStage = buildStages(opCtx, collection, cq, qsol, fn->children[0], ws);
-            return std::make_unique<FetchStage>(
-                expCtx, ws, std::move(childStage), fn->filter.get(), collection);
+            std::shared_ptr<const StringSet> retainedFields;
+            if (!fn->retainedFields.empty()) {
+                retainedFields = std::make_shared<const StringSet>(fn->retainedFields.begin(),
+                                                                   fn->retainedFields.end());
+            }
+            return std::make_unique<FetchStage>(expCtx,
+                                                ws,
+                                                std::move(childStage),
+                                                fn->filter.get(),
+                                                collection,
+                                                std::move(retainedFields));
         }
         case STAGE_SORT_DEFAULT: {
             auto snDefault = static_cast<const SortNodeDefault*>(root);
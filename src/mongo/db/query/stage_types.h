@@ -40,6 +40,9 @@ enum StageType {
     STAGE_CACHED_PLAN,
     STAGE_COLLSCAN,
 
+    // Scans every key of a column store index, rebuilding the indexed fields of each document.
+    STAGE_COLUMN_SCAN,
+
     // This stage sits at the root of the query tree and counts up the number of results
     // returned by its child.
     STAGE_COUNT,
@@ -234,5 +234,36 @@ void AllDatabaseCloner::Stats::append(BSONObjBuilder* builder) const {
     }
 }
 
+void AllDatabaseCloner::Stats::appendProgressEstimate(BSONObjBuilder* builder,
+                                                     Date_t now) const {
+    long long documentsToCopy = 0;
+    long long documentsCopied = 0;
+    Date_t start;
+    for (auto&& db : databaseStats) {
+        if (start == Date_t() && db.start != Date_t()) {
+            start = db.start;
+        }
+        for (auto&& coll : db.collectionStats) {
+            documentsToCopy += coll.documentToCopy;
+            documentsCopied += coll.documentsCopied;
+        }
+    }
+    if (documentsToCopy == 0) {
+        return;
+    }
+    builder->appendNumber("approxTotalDocumentsToCopy", documentsToCopy);
+    builder->appendNumber("approxTotalDocumentsCopied", documentsCopied);
+    // The count of documents to copy is approximate and only grows as collections are reached,
+    // so the estimate is a lower bound that firms up as the clone progresses.
+    if (documentsCopied > 0 && documentsCopied < documentsToCopy && start != Date_t() &&
+        now > start) {
+        auto elapsedMillis = durationCount<Milliseconds>(now - start);
+        builder->appendNumber(
+            "remainingCloneMillisEstimate",
+            static_cast<long long>(static_cast<double>(elapsedMillis) *
+                                   (documentsToCopy - documentsCopied) / documentsCopied));
+    }
+}
+
 }  // namespace repl
 }  // namespace mongo
@@ -46,6 +46,13 @@ public:
         std::string toString() const;
         BSONObj toBSON() const;
         void append(BSONObjBuilder* builder) const;
+
+        /**
+         * Appends the number of documents to copy and copied across all databases and, while
+         * the clone is still underway, an estimate of the time left extrapolated from the copy
+         * rate so far.  Appends nothing until the document counts are known.
+         */
+        void appendProgressEstimate(BSONObjBuilder* builder, Date_t now) const;
     };
 
     AllDatabaseCloner(InitialSyncSharedData* sharedData,
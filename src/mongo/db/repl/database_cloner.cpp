@@ -31,12 +31,18 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
 #include "mongo/base/string_data.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands/list_collections_filter.h"
 #include "mongo/db/repl/database_cloner.h"
 #include "mongo/db/repl/database_cloner_gen.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace repl {
@@ -49,7 +55,9 @@ DatabaseCloner::DatabaseCloner(const std::string& dbName,
                                ThreadPool* dbPool)
     : BaseCloner("DatabaseCloner"_sd, sharedData, source, client, storageInterface, dbPool),
       _dbName(dbName),
-      _listCollectionsStage("listCollections", this, &DatabaseCloner::listCollectionsStage) {
+      _listCollectionsStage("listCollections", this, &DatabaseCloner::listCollectionsStage),
+      _createClientFn(
+          [] { return std::make_unique<DBClientConnection>(true /* autoReconnect */); }) {
     invariant(!dbName.empty());
     _stats.dbname = dbName;
 }
@@ -63,6 +71,10 @@ CollectionOptions DatabaseCloner::parseCollectionOptions(const BSONObj& obj) {
     return uassertStatusOK(CollectionOptions::parse(obj, CollectionOptions::parseForStorage));
 }
 
+void DatabaseCloner::setCreateClientFn_forTest(const CreateClientFn& createClientFn) {
+    _createClientFn = createClientFn;
+}
+
 void DatabaseCloner::preStage() {
     stdx::lock_guard<Latch> lk(_mutex);
     _stats.start = getSharedData()->getClock()->now();
@@ -125,20 +137,104 @@ void DatabaseCloner::postStage() {
             _stats.collectionStats.back().ns = coll.first.ns();
         }
     }
-    for (const auto& coll : _collections) {
-        auto& sourceNss = coll.first;
-        auto& collectionOptions = coll.second;
+
+    const size_t numCloners = std::min(
+        _collections.size(),
+        static_cast<size_t>(std::max(1, initialSyncMaxConcurrentCollectionCloners.load())));
+    std::vector<stdx::thread> clonerThreads;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _numCollectionClonerThreads = numCloners - 1;
+    }
+    for (size_t i = 1; i < numCloners; ++i) {
+        clonerThreads.emplace_back([this, i] {
+            ON_BLOCK_EXIT([this] {
+                stdx::lock_guard<Latch> lk(_mutex);
+                --_numCollectionClonerThreads;
+                _collectionClonerThreadExitedCV.notify_all();
+            });
+            ThreadClient tc(str::stream() << "DatabaseCloner-" << _dbName << "-" << i,
+                            getGlobalServiceContext());
+            std::unique_ptr<DBClientConnection> client;
+            try {
+                client = makeCollectionClonerClient();
+            } catch (const DBException& e) {
+                // The remaining cloners pick up the collections this one would have cloned.
+                LOGV2(4938000,
+                      "Unable to open an additional connection for collection cloning: {error}",
+                      "error"_attr = e.toStatus());
+                return;
+            }
+            {
+                stdx::lock_guard<Latch> lk(_mutex);
+                if (_collectionClonerClientsShutDown) {
+                    client->shutdownAndDisallowReconnect();
+                    return;
+                }
+                _collectionClonerClients.push_back(client.get());
+            }
+            runCollectionCloners(client.get());
+            {
+                stdx::lock_guard<Latch> lk(_mutex);
+                _collectionClonerClients.erase(std::find(_collectionClonerClients.begin(),
+                                                         _collectionClonerClients.end(),
+                                                         client.get()));
+            }
+            client->shutdownAndDisallowReconnect();
+        });
+    }
+    runCollectionCloners(getClient());
+
+    // Wait for the other cloners. If the clone fails or is canceled meanwhile, shut down their
+    // connections to unblock them promptly, since only the main connection is shut down by the
+    // initial syncer. Cancellation is not signaled to this cloner, so it is polled for.
+    while (true) {
+        const bool canceled = mustExit();
+        stdx::unique_lock<Latch> lk(_mutex);
+        if ((_collectionCloneFailed || canceled) && !_collectionClonerClientsShutDown) {
+            for (auto client : _collectionClonerClients) {
+                client->shutdownAndDisallowReconnect();
+            }
+            _collectionClonerClientsShutDown = true;
+        }
+        if (_numCollectionClonerThreads == 0) {
+            break;
+        }
+        _collectionClonerThreadExitedCV.wait_for(lk, Milliseconds(100).toSystemDuration());
+    }
+    for (auto&& thread : clonerThreads) {
+        thread.join();
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    // Abort the database cloner if any collection clone failed.
+    if (_collectionCloneFailed)
+        return;
+    _stats.end = getSharedData()->getClock()->now();
+}
+
+void DatabaseCloner::runCollectionCloners(DBClientConnection* client) {
+    while (true) {
+        size_t index;
+        CollectionCloner* cloner;
         {
             stdx::lock_guard<Latch> lk(_mutex);
-            _currentCollectionCloner = std::make_unique<CollectionCloner>(sourceNss,
-                                                                          collectionOptions,
-                                                                          getSharedData(),
-                                                                          getSource(),
-                                                                          getClient(),
-                                                                          getStorageInterface(),
-                                                                          getDBPool());
+            if (_collectionCloneFailed || _nextCollectionIndex == _collections.size())
+                return;
+            index = _nextCollectionIndex++;
+            auto& coll = _collections[index];
+            auto& clonerPtr = _activeCollectionCloners[index];
+            clonerPtr = std::make_unique<CollectionCloner>(coll.first,
+                                                           coll.second,
+                                                           getSharedData(),
+                                                           getSource(),
+                                                           client,
+                                                           getStorageInterface(),
+                                                           getDBPool());
+            cloner = clonerPtr.get();
         }
-        auto collStatus = _currentCollectionCloner->run();
+        auto& sourceNss = _collections[index].first;
+        auto collStatus = cloner->run();
         if (collStatus.isOK()) {
             LOGV2_DEBUG(
                 21148, 1, "collection clone finished: {namespace}", "namespace"_attr = sourceNss);
@@ -156,23 +252,33 @@ void DatabaseCloner::postStage() {
         }
         {
             stdx::lock_guard<Latch> lk(_mutex);
-            _stats.collectionStats[_stats.clonedCollections] = _currentCollectionCloner->getStats();
-            _currentCollectionCloner = nullptr;
-            // Abort the database cloner if the collection clone failed.
-            if (!collStatus.isOK())
+            _stats.collectionStats[index] = cloner->getStats();
+            _activeCollectionCloners.erase(index);
+            if (!collStatus.isOK()) {
+                _collectionCloneFailed = true;
                 return;
+            }
             _stats.clonedCollections++;
         }
     }
-    stdx::lock_guard<Latch> lk(_mutex);
-    _stats.end = getSharedData()->getClock()->now();
+}
+
+std::unique_ptr<DBClientConnection> DatabaseCloner::makeCollectionClonerClient() {
+    auto client = _createClientFn();
+    // Validate the sync source on these connections the same way as on the main one, so that they
+    // cannot clone from it once it is neither primary nor secondary.
+    client->setHandshakeValidationHook(getClient()->getHandshakeValidationHook());
+    uassertStatusOK(client->connect(getSource(), StringData()));
+    uassertStatusOK(replAuthenticate(client.get())
+                        .withContext(str::stream() << "Failed to authenticate to " << getSource()));
+    return client;
 }
 
 DatabaseCloner::Stats DatabaseCloner::getStats() const {
     stdx::lock_guard<Latch> lk(_mutex);
     DatabaseCloner::Stats stats = _stats;
-    if (_currentCollectionCloner) {
-        stats.collectionStats[_stats.clonedCollections] = _currentCollectionCloner->getStats();
+    for (const auto& [index, cloner] : _activeCollectionCloners) {
+        stats.collectionStats[index] = cloner->getStats();
     }
     return stats;
 }
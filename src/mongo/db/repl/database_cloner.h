@@ -29,10 +29,13 @@
 
 #pragma once
 
+#include <functional>
+#include <map>
 #include <vector>
 
 #include "mongo/db/repl/base_cloner.h"
 #include "mongo/db/repl/collection_cloner.h"
+#include "mongo/stdx/condition_variable.h"
 
 namespace mongo {
 namespace repl {
@@ -52,6 +55,8 @@ public:
         void append(BSONObjBuilder* builder) const;
     };
 
+    using CreateClientFn = std::function<std::unique_ptr<DBClientConnection>()>;
+
     DatabaseCloner(const std::string& dbName,
                    InitialSyncSharedData* sharedData,
                    const HostAndPort& source,
@@ -67,6 +72,11 @@ public:
 
     static CollectionOptions parseCollectionOptions(const BSONObj& element);
 
+    /**
+     * Overrides how the connections used by concurrent collection cloners are created.
+     */
+    void setCreateClientFn_forTest(const CreateClientFn& createClientFn);
+
 protected:
     ClonerStages getStages() final;
 
@@ -87,10 +97,24 @@ private:
 
     /**
      * The postStage creates and runs the individual CollectionCloners on each database found on
-     * the sync source, and sets the end time in _stats when done.
+     * the sync source, and sets the end time in _stats when done.  Up to
+     * 'initialSyncMaxConcurrentCollectionCloners' collections are cloned at the same time; every
+     * cloner after the first runs on its own thread and connection.
      */
     void postStage() final;
 
+    /**
+     * Repeatedly claims the next uncloned collection and clones it over 'client', until every
+     * collection has been claimed or a collection clone fails.
+     */
+    void runCollectionCloners(DBClientConnection* client);
+
+    /**
+     * Opens and authenticates an additional connection to the sync source, with the handshake
+     * validation of the main connection.  Throws on failure.
+     */
+    std::unique_ptr<DBClientConnection> makeCollectionClonerClient();
+
     std::string describeForFuzzer(BaseClonerStage* stage) const final {
         return _dbName + " db: { " + stage->getName() + ": 1 } ";
     }
@@ -107,8 +131,23 @@ private:
     const std::string _dbName;                                                // (R)
     ClonerStage<DatabaseCloner> _listCollectionsStage;                        // (R)
     std::vector<std::pair<NamespaceString, CollectionOptions>> _collections;  // (X)
-    std::unique_ptr<CollectionCloner> _currentCollectionCloner;               // (MX)
-    Stats _stats;                                                             // (MX)
+    CreateClientFn _createClientFn;                                           // (X)
+
+    // Cloners currently running, keyed by their index in '_collections'.
+    std::map<size_t, std::unique_ptr<CollectionCloner>> _activeCollectionCloners;  // (M)
+    size_t _nextCollectionIndex = 0;                                               // (M)
+    bool _collectionCloneFailed = false;                                           // (M)
+    std::vector<DBClientConnection*> _collectionClonerClients;                     // (M)
+    Stats _stats;                                                                  // (M)
+
+    // Set once the connections of the additional cloner threads have been shut down, after which
+    // a thread that opens its connection late exits instead of registering it.
+    bool _collectionClonerClientsShutDown = false;  // (M)
+
+    // The number of additional cloner threads still running; the condition variable is notified
+    // as each one exits.
+    size_t _numCollectionClonerThreads = 0;                    // (M)
+    stdx::condition_variable _collectionClonerThreadExitedCV;  // (S)
 };
 
 }  // namespace repl
@@ -32,6 +32,7 @@
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/repl/cloner_test_fixture.h"
 #include "mongo/db/repl/database_cloner.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/service_context_test_fixture.h"
@@ -39,10 +40,31 @@
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
 #include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace repl {
 
+/**
+ * Runs its handshake validation hook against a sync source that is neither primary nor secondary
+ * when it connects, as a real connection would after its isMaster handshake.
+ */
+class HandshakeValidatingClient : public MockDBClientConnection {
+public:
+    using MockDBClientConnection::MockDBClientConnection;
+
+    Status connect(const HostAndPort& host, StringData applicationName) override {
+        if (const auto& hook = getHandshakeValidationHook()) {
+            auto status = hook(executor::RemoteCommandResponse(
+                BSON("ismaster" << false << "secondary" << false), Milliseconds(0)));
+            if (!status.isOK()) {
+                return status;
+            }
+        }
+        return MockDBClientConnection::connect(host, applicationName);
+    }
+};
+
 struct CollectionCloneInfo {
     std::shared_ptr<CollectionMockStats> stats = std::make_shared<CollectionMockStats>();
     CollectionBulkLoaderMock* loader = nullptr;
@@ -493,5 +515,144 @@ TEST_F(DatabaseClonerTest, DatabaseAndCollectionStats) {
     ASSERT_EQ(_clock.now(), stats.collectionStats[1].end);
 }
 
+TEST_F(DatabaseClonerTest, ClonesCollectionsConcurrently) {
+    const auto originalMaxConcurrentCloners = initialSyncMaxConcurrentCollectionCloners.load();
+    initialSyncMaxConcurrentCollectionCloners.store(2);
+    ON_BLOCK_EXIT(
+        [&] { initialSyncMaxConcurrentCollectionCloners.store(originalMaxConcurrentCloners); });
+
+    auto uuid1 = UUID::gen();
+    auto uuid2 = UUID::gen();
+    const BSONObj idIndexSpec = BSON("v" << 1 << "key" << BSON("_id" << 1) << "name"
+                                         << "_id_");
+    const std::vector<BSONObj> sourceInfos = {BSON("name"
+                                                   << "a"
+                                                   << "type"
+                                                   << "collection"
+                                                   << "options" << BSONObj() << "info"
+                                                   << BSON("readOnly" << false << "uuid" << uuid1)),
+                                              BSON(
+                                                  "name"
+                                                  << "b"
+                                                  << "type"
+                                                  << "collection"
+                                                  << "options" << BSONObj() << "info"
+                                                  << BSON("readOnly" << false << "uuid" << uuid2))};
+    _mockServer->setCommandReply("listCollections",
+                                 createListCollectionsResponse({sourceInfos[0], sourceInfos[1]}));
+    _mockServer->setCommandReply("count", {createCountResponse(0), createCountResponse(0)});
+    // The two collections may list their indexes in either order, so they share one spec.
+    _mockServer->setCommandReply("listIndexes",
+                                 {createCursorResponse(_dbName + ".a", BSON_ARRAY(idIndexSpec)),
+                                  createCursorResponse(_dbName + ".b", BSON_ARRAY(idIndexSpec))});
+    // Create the entries up front so the concurrent cloners only look them up.
+    const NamespaceString nssA{_dbName, "a"};
+    const NamespaceString nssB{_dbName, "b"};
+    _collections[nssA];
+    _collections[nssB];
+    auto cloner = makeDatabaseCloner();
+    int clientsCreated = 0;
+    cloner->setCreateClientFn_forTest([&]() -> std::unique_ptr<DBClientConnection> {
+        ++clientsCreated;
+        return std::make_unique<MockDBClientConnection>(_mockServer.get(), true);
+    });
+
+    // Hold each collection clone in a different stage; both can only be reached together if the
+    // collections are cloned at the same time.
+    auto beforeStageFailPoint = globalFailPointRegistry().find("hangBeforeClonerStage");
+    auto afterStageFailPoint = globalFailPointRegistry().find("hangAfterClonerStage");
+    auto beforeTimesEntered = beforeStageFailPoint->setMode(
+        FailPoint::alwaysOn,
+        0,
+        fromjson("{cloner: 'CollectionCloner', stage: 'query', nss: '" + _dbName + ".b'}"));
+    auto afterTimesEntered = afterStageFailPoint->setMode(
+        FailPoint::alwaysOn,
+        0,
+        fromjson("{cloner: 'CollectionCloner', stage: 'count', nss: '" + _dbName + ".a'}"));
+
+    stdx::thread clonerThread([&] {
+        Client::initThread("ClonerRunner");
+        ASSERT_OK(cloner->run());
+    });
+    beforeStageFailPoint->waitForTimesEntered(beforeTimesEntered + 1);
+    afterStageFailPoint->waitForTimesEntered(afterTimesEntered + 1);
+
+    auto stats = cloner->getStats();
+    ASSERT_EQ(2, stats.collections);
+    ASSERT_EQ(0, stats.clonedCollections);
+    ASSERT_EQ(_clock.now(), stats.collectionStats[0].start);
+    ASSERT_EQ(_clock.now(), stats.collectionStats[1].start);
+
+    beforeStageFailPoint->setMode(FailPoint::off);
+    afterStageFailPoint->setMode(FailPoint::off);
+    clonerThread.join();
+
+    ASSERT_EQ(1, clientsCreated);
+    stats = cloner->getStats();
+    ASSERT_EQ(2, stats.clonedCollections);
+    ASSERT_EQ(_clock.now(), stats.end);
+    ASSERT(_collections[nssA].stats->commitCalled);
+    ASSERT(_collections[nssB].stats->commitCalled);
+}
+
+TEST_F(DatabaseClonerTest, AdditionalClonerConnectionsValidateTheSyncSource) {
+    const int originalMaxConcurrentCloners = initialSyncMaxConcurrentCollectionCloners.load();
+    initialSyncMaxConcurrentCollectionCloners.store(2);
+    ON_BLOCK_EXIT(
+        [&] { initialSyncMaxConcurrentCollectionCloners.store(originalMaxConcurrentCloners); });
+
+    const BSONObj idIndexSpec = BSON("v" << 1 << "key" << BSON("_id" << 1) << "name"
+                                         << "_id_");
+    const std::vector<BSONObj> sourceInfos = {
+        BSON("name"
+             << "a"
+             << "type"
+             << "collection"
+             << "options" << BSONObj() << "info"
+             << BSON("readOnly" << false << "uuid" << UUID::gen())),
+        BSON("name"
+             << "b"
+             << "type"
+             << "collection"
+             << "options" << BSONObj() << "info"
+             << BSON("readOnly" << false << "uuid" << UUID::gen()))};
+    _mockServer->setCommandReply("listCollections",
+                                 createListCollectionsResponse({sourceInfos[0], sourceInfos[1]}));
+    _mockServer->setCommandReply("count", {createCountResponse(0), createCountResponse(0)});
+    _mockServer->setCommandReply("listIndexes",
+                                 {createCursorResponse(_dbName + ".a", BSON_ARRAY(idIndexSpec)),
+                                  createCursorResponse(_dbName + ".b", BSON_ARRAY(idIndexSpec))});
+    const NamespaceString nssA{_dbName, "a"};
+    const NamespaceString nssB{_dbName, "b"};
+    _collections[nssA];
+    _collections[nssB];
+
+    // The main connection rejects a sync source which is neither primary nor secondary.
+    int validations = 0;
+    _mockClient->setHandshakeValidationHook(
+        [&](const executor::RemoteCommandResponse& isMasterReply) -> Status {
+            ++validations;
+            if (isMasterReply.data["ismaster"].trueValue() ||
+                isMasterReply.data["secondary"].trueValue()) {
+                return Status::OK();
+            }
+            return {ErrorCodes::NotMasterOrSecondary, "neither primary nor secondary"};
+        });
+    auto cloner = makeDatabaseCloner();
+    int clientsCreated = 0;
+    cloner->setCreateClientFn_forTest([&]() -> std::unique_ptr<DBClientConnection> {
+        ++clientsCreated;
+        return std::make_unique<HandshakeValidatingClient>(_mockServer.get(), true);
+    });
+
+    // The additional connection is refused, so the main connection clones both collections.
+    ASSERT_OK(cloner->run());
+    ASSERT_EQ(1, clientsCreated);
+    ASSERT_EQ(1, validations);
+    ASSERT_EQ(2, cloner->getStats().clonedCollections);
+    ASSERT(_collections[nssA].stats->commitCalled);
+    ASSERT(_collections[nssB].stats->commitCalled);
+}
+
 }  // namespace repl
 }  // namespace mongo
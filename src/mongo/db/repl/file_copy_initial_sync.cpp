@@ -0,0 +1,221 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kReplicationInitialSync
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/file_copy_initial_sync.h"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+#include "mongo/client/dbclient_connection.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
+#include "mongo/db/repl/replication_auth.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/storage/storage_engine_metadata.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/executor/remote_command_response.h"
+#include "mongo/logv2/log.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+// The file in which StorageEngineMetadata records the storage engine and its options.
+const char kStorageMetadataFile[] = "storage.bson";
+
+BSONObj runBackupCommand(DBClientConnection* conn, const BSONObj& cmd) {
+    BSONObj reply;
+    conn->runCommand("admin", cmd, reply);
+    uassertStatusOK(getStatusFromCommandResult(reply).withContext(
+        str::stream() << cmd.firstElementFieldName() << " failed on "
+                      << conn->getServerAddress()));
+    return reply;
+}
+
+/**
+ * Returns where the file described by 'file', an entry of a beginInitialSyncBackup or
+ * extendInitialSyncBackup reply, goes in this node's dbpath.
+ */
+boost::filesystem::path localPathFor(const BSONObj& file) {
+    const boost::filesystem::path relativePath(file["relativePath"].str());
+    uassert(ErrorCodes::BadValue,
+            str::stream() << "Sync source listed a file outside of its dbpath: " << file,
+            !relativePath.empty() && relativePath.is_relative() &&
+                std::none_of(relativePath.begin(), relativePath.end(), [](const auto& part) {
+                    return part == "..";
+                }));
+    return boost::filesystem::path(storageGlobalParams.dbpath) / relativePath;
+}
+
+/**
+ * Copies a file of the backup 'backupId' to its place in this node's dbpath, replacing any copy
+ * left by an earlier attempt.
+ */
+void copyFile(DBClientConnection* conn, const BSONElement& backupId, const BSONObj& file) {
+    const auto localPath = localPathFor(file);
+    boost::filesystem::create_directories(localPath.parent_path());
+    std::ofstream out(localPath.string(), std::ios::binary | std::ios::trunc);
+    uassert(ErrorCodes::FileStreamFailed,
+            str::stream() << "Failed to open " << localPath.string() << " for writing",
+            out);
+
+    const auto filename = file["filename"].str();
+    long long offset = 0;
+    while (true) {
+        auto reply = runBackupCommand(
+            conn,
+            BSON("readInitialSyncBackupFile" << 1 << backupId << "filename" << filename << "offset"
+                                             << offset << "length"
+                                             << static_cast<long long>(BSONObjMaxUserSize)));
+        int length;
+        const char* data = reply["data"].binData(length);
+        out.write(data, length);
+        uassert(ErrorCodes::FileStreamFailed,
+                str::stream() << "Failed to write " << length << " bytes at offset " << offset
+                              << " of " << localPath.string(),
+                out);
+        offset += length;
+        if (reply["eof"].trueValue()) {
+            break;
+        }
+        uassert(ErrorCodes::FileStreamFailed,
+                str::stream() << "Sync source returned no data before the end of " << filename,
+                length > 0);
+    }
+    out.close();
+    uassert(ErrorCodes::FileStreamFailed,
+            str::stream() << "Failed to close " << localPath.string(),
+            out);
+
+    const auto fileSize = file["fileSize"].safeNumberLong();
+    uassert(ErrorCodes::FileStreamFailed,
+            str::stream() << "Copied " << offset << " bytes of " << filename << " instead of "
+                          << fileSize,
+            offset == fileSize);
+    LOGV2_DEBUG(4938111,
+                1,
+                "Copied file from sync source",
+                "file"_attr = localPath.string(),
+                "fileSize"_attr = fileSize);
+}
+
+}  // namespace
+
+void fileCopyInitialSyncIfNeeded(ServiceContext* service) {
+    if (fileCopyInitialSyncSource.empty() ||
+        StorageEngineMetadata::forPath(storageGlobalParams.dbpath)) {
+        return;
+    }
+
+    const auto& replSettings = ReplicationCoordinator::get(service)->getSettings();
+    uassert(ErrorCodes::InvalidOptions,
+            "fileCopyInitialSyncSource requires replication to be enabled with --replSet",
+            replSettings.usingReplSets());
+    const auto source = uassertStatusOK(HostAndPort::parse(fileCopyInitialSyncSource));
+
+    DBClientConnection conn;
+    conn.setHandshakeValidationHook(
+        [&](const executor::RemoteCommandResponse& isMasterReply) -> Status {
+            if (!isMasterReply.isOK()) {
+                return isMasterReply.status;
+            }
+            if (isMasterReply.data["setName"].str() != replSettings.ourSetName()) {
+                return {ErrorCodes::InvalidReplicaSetConfig,
+                        str::stream() << "Sync source " << source.toString() << " is not a member of "
+                                      << replSettings.ourSetName()};
+            }
+            if (!isMasterReply.data["ismaster"].trueValue() &&
+                !isMasterReply.data["secondary"].trueValue()) {
+                return {ErrorCodes::NotMasterOrSecondary,
+                        str::stream()
+                            << "Sync source " << source.toString() << " is neither primary nor secondary"};
+            }
+            return Status::OK();
+        });
+    uassertStatusOK(conn.connect(source, "FileCopyInitialSync"));
+    uassertStatusOK(replAuthenticate(&conn).withContext(str::stream()
+                                                        << "Failed to authenticate to " << source));
+
+    const auto begin = runBackupCommand(&conn, BSON("beginInitialSyncBackup" << 1));
+    const auto backupId = begin["backupId"];
+    ON_BLOCK_EXIT([&] {
+        // If this fails, the sync source closes the backup once it has been idle for
+        // initialSyncBackupInactivityTimeoutSecs.
+        try {
+            runBackupCommand(&conn, BSON("endInitialSyncBackup" << 1 << backupId));
+        } catch (const DBException& ex) {
+            LOGV2_WARNING(4938112,
+                          "Failed to close initial sync backup on sync source",
+                          "syncSource"_attr = source,
+                          "error"_attr = ex.toStatus());
+        }
+    });
+    LOGV2(4938110,
+          "Starting file copy based initial sync",
+          "syncSource"_attr = source,
+          "checkpointTimestamp"_attr = begin["checkpointTimestamp"].timestamp(),
+          "numFiles"_attr = begin["files"].Obj().nFields());
+
+    boost::optional<BSONObj> metadataFile;
+    for (const auto& file : begin["files"].Obj()) {
+        if (file["relativePath"].str() == kStorageMetadataFile) {
+            metadataFile = file.Obj().getOwned();
+            continue;
+        }
+        copyFile(&conn, backupId, file.Obj());
+    }
+    uassert(ErrorCodes::NoSuchKey,
+            str::stream() << "Sync source " << source << " did not list " << kStorageMetadataFile,
+            metadataFile);
+
+    // The data files hold the checkpoint.  The journal written since the backup was opened holds
+    // the oplog entries after it, which startup recovery applies from the checkpoint timestamp.
+    const auto extend =
+        runBackupCommand(&conn, BSON("extendInitialSyncBackup" << 1 << backupId));
+    for (const auto& file : extend["files"].Obj()) {
+        copyFile(&conn, backupId, file.Obj());
+    }
+
+    // Once storage.bson exists, this node starts on the copied files instead of copying again.
+    copyFile(&conn, backupId, *metadataFile);
+    LOGV2(4938113,
+          "Finished file copy based initial sync",
+          "syncSource"_attr = source,
+          "checkpointTimestamp"_attr = begin["checkpointTimestamp"].timestamp());
+}
+
+}  // namespace repl
+}  // namespace mongo
@@ -0,0 +1,54 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+namespace mongo {
+
+class ServiceContext;
+
+namespace repl {
+
+/**
+ * File copy based initial sync.  If 'fileCopyInitialSyncSource' is set and dbpath holds no data,
+ * copies the data files of that member into dbpath through an initial sync backup (see
+ * initial_sync_backup_commands.cpp).  Must run before the storage engine starts.
+ *
+ * The storage engine then opens the copied files at the backup's checkpoint, and startup recovery
+ * applies the copied oplog from the checkpoint timestamp, so the node joins the set without
+ * re-inserting documents or rebuilding indexes.
+ *
+ * storage.bson is written last, so a copy that fails or is interrupted is started again on the
+ * next startup.  Throws if the copy fails.
+ */
+void fileCopyInitialSyncIfNeeded(ServiceContext* service);
+
+}  // namespace repl
+}  // namespace mongo
@@ -0,0 +1,330 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kReplicationInitialSync
+
+#include "mongo/platform/basic.h"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+#include "mongo/bson/util/bson_extract.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
+#include "mongo/db/repl/repl_set_command.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/storage_engine.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/periodic_runner.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+// The file in which StorageEngineMetadata records the storage engine and its options.
+const char kStorageMetadataFile[] = "storage.bson";
+
+// Leaves room in the reply for the fields other than the file data.
+constexpr long long kMaxBackupFileChunkBytes = BSONObjMaxUserSize - 64 * 1024;
+
+/**
+ * The backup opened on behalf of a syncing node.  The storage engine allows a single backup cursor
+ * at a time, so at most one syncing node can copy files from this node at once.
+ */
+struct InitialSyncBackup {
+    Mutex mutex = MONGO_MAKE_LATCH("InitialSyncBackup::mutex");
+    boost::optional<UUID> backupId;
+    // Files that may be read through this backup, with the number of bytes to copy from each.
+    stdx::unordered_map<std::string, std::uint64_t> files;
+    // When the syncing node last used the backup.
+    Date_t lastUsed;
+    // Closes the backup once the syncing node has been silent for
+    // initialSyncBackupInactivityTimeoutSecs.  Started by the first backup opened on this node.
+    PeriodicJobAnchor reaper;
+};
+
+const auto getInitialSyncBackup = ServiceContext::declareDecoration<InitialSyncBackup>();
+
+UUID parseBackupId(const BSONObj& cmdObj) {
+    return uassertStatusOK(UUID::parse(cmdObj["backupId"]));
+}
+
+void uassertBackupIsOpen(WithLock, const InitialSyncBackup& backup, const UUID& backupId) {
+    uassert(ErrorCodes::NoSuchKey,
+            str::stream() << "No initial sync backup with id " << backupId << " is open",
+            backup.backupId == backupId);
+}
+
+/**
+ * Closes the open backup if the syncing node has not used it within the inactivity timeout, for
+ * instance because it crashed or chose another sync source, so it does not pin a checkpoint and
+ * hold back oplog truncation indefinitely.
+ */
+void reapInactiveBackup(Client* client) {
+    auto service = client->getServiceContext();
+    auto& backup = getInitialSyncBackup(service);
+    stdx::lock_guard<Latch> lk(backup.mutex);
+    if (!backup.backupId ||
+        service->getFastClockSource()->now() - backup.lastUsed <
+            Seconds(initialSyncBackupInactivityTimeoutSecs.load())) {
+        return;
+    }
+
+    auto opCtx = client->makeOperationContext();
+    service->getStorageEngine()->endNonBlockingBackup(opCtx.get());
+    LOGV2(4938102,
+          "Closed inactive initial sync backup",
+          "backupId"_attr = *backup.backupId,
+          "lastUsed"_attr = backup.lastUsed);
+    backup.backupId = boost::none;
+    backup.files.clear();
+}
+
+void appendFile(BSONArrayBuilder* files, const std::string& filename, std::uint64_t fileSize) {
+    BSONObjBuilder file(files->subobjStart());
+    file.append("filename", filename);
+    file.append("relativePath",
+                boost::filesystem::path(filename)
+                    .lexically_relative(storageGlobalParams.dbpath)
+                    .generic_string());
+    file.append("fileSize", static_cast<long long>(fileSize));
+}
+
+/**
+ * Opens a backup cursor so that a syncing node can copy this node's data files:
+ * { beginInitialSyncBackup: 1 }
+ *
+ * The reply lists the files to copy, including storage.bson, and 'checkpointTimestamp', the
+ * timestamp from which the syncing node must apply the oplog once it has copied the files.  See
+ * file_copy_initial_sync.h for the syncing node's side.
+ */
+class CmdBeginInitialSyncBackup : public ReplSetCommand {
+public:
+    CmdBeginInitialSyncBackup() : ReplSetCommand("beginInitialSyncBackup") {}
+
+    bool run(OperationContext* opCtx,
+             const std::string&,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        uassertStatusOK(ReplicationCoordinator::get(opCtx)->checkReplEnabledForCommand(&result));
+        auto storageEngine = opCtx->getServiceContext()->getStorageEngine();
+        uassert(ErrorCodes::CommandNotSupported,
+                "File copy based initial sync requires a persistent storage engine",
+                storageEngine->supportsCheckpoints() && !storageEngine->isEphemeral());
+
+        auto& backup = getInitialSyncBackup(opCtx->getServiceContext());
+        stdx::lock_guard<Latch> lk(backup.mutex);
+        uassert(ErrorCodes::ConflictingOperationInProgress,
+                "An initial sync backup is already open on this node",
+                !backup.backupId);
+
+        // Read before the backup cursor pins its checkpoint, so that a checkpoint completing in
+        // between can only make the data files newer than the reported timestamp.  Applying the
+        // oplog from an earlier point is safe, just as it is for logical initial sync.
+        auto checkpointTimestamp = storageEngine->getLastStableRecoveryTimestamp();
+        uassert(ErrorCodes::NotYetInitialized,
+                "This node has not yet taken a stable checkpoint",
+                checkpointTimestamp);
+
+        auto backupInformation =
+            uassertStatusOK(storageEngine->beginNonBlockingBackup(opCtx, {}));
+
+        backup.backupId = UUID::gen();
+        backup.files.clear();
+        backup.lastUsed = opCtx->getServiceContext()->getFastClockSource()->now();
+        if (!backup.reaper.isValid()) {
+            backup.reaper = opCtx->getServiceContext()->getPeriodicRunner()->makeJob(
+                {"InitialSyncBackupReaper", reapInactiveBackup, Seconds(1)});
+            backup.reaper.start();
+        }
+        BSONArrayBuilder files(result.subarrayStart("files"));
+        for (const auto& [filename, file] : backupInformation) {
+            backup.files.emplace(filename, file.fileSize);
+            appendFile(&files, filename, file.fileSize);
+        }
+        // The storage engine metadata is not part of the backup cursor, but the syncing node needs
+        // it to start on the copied files with this node's storage options.
+        const auto metadataFile =
+            (boost::filesystem::path(storageGlobalParams.dbpath) / kStorageMetadataFile).string();
+        boost::system::error_code ec;
+        const auto metadataFileSize = boost::filesystem::file_size(metadataFile, ec);
+        uassert(ErrorCodes::FileStreamFailed,
+                str::stream() << "Failed to get the size of " << metadataFile << ": "
+                              << ec.message(),
+                !ec);
+        backup.files.emplace(metadataFile, metadataFileSize);
+        appendFile(&files, metadataFile, metadataFileSize);
+        files.doneFast();
+
+        LOGV2(4938100,
+              "Opened initial sync backup",
+              "backupId"_attr = *backup.backupId,
+              "checkpointTimestamp"_attr = *checkpointTimestamp,
+              "numFiles"_attr = backup.files.size());
+        backup.backupId->appendToBuilder(&result, "backupId");
+        result.append("checkpointTimestamp", *checkpointTimestamp);
+        result.append("dbpath", storageGlobalParams.dbpath);
+        return true;
+    }
+} cmdBeginInitialSyncBackup;
+
+/**
+ * Returns up to 'length' bytes of a file in an open initial sync backup, starting at 'offset':
+ * { readInitialSyncBackupFile: 1, backupId: <UUID>, filename: <string>, offset: <long>,
+ *   length: <long> }
+ *
+ * Only files listed by the backup may be read, and only up to the size they had when listed.
+ */
+class CmdReadInitialSyncBackupFile : public ReplSetCommand {
+public:
+    CmdReadInitialSyncBackupFile() : ReplSetCommand("readInitialSyncBackupFile") {}
+
+    bool run(OperationContext* opCtx,
+             const std::string&,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        const auto backupId = parseBackupId(cmdObj);
+        std::string filename;
+        uassertStatusOK(bsonExtractStringField(cmdObj, "filename", &filename));
+        long long offset;
+        uassertStatusOK(bsonExtractIntegerField(cmdObj, "offset", &offset));
+        long long length;
+        uassertStatusOK(bsonExtractIntegerField(cmdObj, "length", &length));
+        uassert(ErrorCodes::BadValue,
+                "'offset' must be non-negative and 'length' must be positive",
+                offset >= 0 && length > 0);
+
+        std::uint64_t fileSize;
+        {
+            auto& backup = getInitialSyncBackup(opCtx->getServiceContext());
+            stdx::lock_guard<Latch> lk(backup.mutex);
+            uassertBackupIsOpen(lk, backup, backupId);
+            auto it = backup.files.find(filename);
+            uassert(ErrorCodes::NoSuchKey,
+                    str::stream() << "File " << filename << " is not part of backup " << backupId,
+                    it != backup.files.end());
+            fileSize = it->second;
+            backup.lastUsed = opCtx->getServiceContext()->getFastClockSource()->now();
+        }
+
+        const auto start = std::min(static_cast<std::uint64_t>(offset), fileSize);
+        const auto toRead = std::min({static_cast<std::uint64_t>(length),
+                                      static_cast<std::uint64_t>(kMaxBackupFileChunkBytes),
+                                      fileSize - start});
+        std::vector<char> buffer(toRead);
+        if (toRead > 0) {
+            std::ifstream file(filename, std::ios::binary);
+            file.seekg(start);
+            file.read(buffer.data(), toRead);
+            uassert(ErrorCodes::FileStreamFailed,
+                    str::stream() << "Failed to read " << toRead << " bytes at offset " << start
+                                  << " of " << filename,
+                    file && static_cast<std::uint64_t>(file.gcount()) == toRead);
+        }
+
+        result.appendBinData("data", toRead, BinDataGeneral, buffer.data());
+        result.append("eof", start + toRead == fileSize);
+        return true;
+    }
+} cmdReadInitialSyncBackupFile;
+
+/**
+ * Makes the journal durable and returns the journal files of an open initial sync backup, so a
+ * syncing node can recover its copy to a point later than the backup's checkpoint:
+ * { extendInitialSyncBackup: 1, backupId: <UUID> }
+ */
+class CmdExtendInitialSyncBackup : public ReplSetCommand {
+public:
+    CmdExtendInitialSyncBackup() : ReplSetCommand("extendInitialSyncBackup") {}
+
+    bool run(OperationContext* opCtx,
+             const std::string&,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        const auto backupId = parseBackupId(cmdObj);
+        opCtx->recoveryUnit()->waitUntilDurable(opCtx);
+
+        auto& backup = getInitialSyncBackup(opCtx->getServiceContext());
+        stdx::lock_guard<Latch> lk(backup.mutex);
+        uassertBackupIsOpen(lk, backup, backupId);
+        backup.lastUsed = opCtx->getServiceContext()->getFastClockSource()->now();
+        auto filenames = uassertStatusOK(
+            opCtx->getServiceContext()->getStorageEngine()->extendBackupCursor(opCtx));
+
+        BSONArrayBuilder files(result.subarrayStart("files"));
+        for (const auto& filename : filenames) {
+            boost::system::error_code ec;
+            const auto fileSize = boost::filesystem::file_size(filename, ec);
+            uassert(ErrorCodes::FileStreamFailed,
+                    str::stream() << "Failed to get the size of " << filename << ": "
+                                  << ec.message(),
+                    !ec);
+            backup.files[filename] = fileSize;
+            appendFile(&files, filename, fileSize);
+        }
+        files.doneFast();
+        return true;
+    }
+} cmdExtendInitialSyncBackup;
+
+/**
+ * Closes an initial sync backup, letting checkpoints and oplog truncation resume:
+ * { endInitialSyncBackup: 1, backupId: <UUID> }
+ */
+class CmdEndInitialSyncBackup : public ReplSetCommand {
+public:
+    CmdEndInitialSyncBackup() : ReplSetCommand("endInitialSyncBackup") {}
+
+    bool run(OperationContext* opCtx,
+             const std::string&,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        const auto backupId = parseBackupId(cmdObj);
+
+        auto& backup = getInitialSyncBackup(opCtx->getServiceContext());
+        stdx::lock_guard<Latch> lk(backup.mutex);
+        uassertBackupIsOpen(lk, backup, backupId);
+        opCtx->getServiceContext()->getStorageEngine()->endNonBlockingBackup(opCtx);
+        backup.backupId = boost::none;
+        backup.files.clear();
+        LOGV2(4938101, "Closed initial sync backup", "backupId"_attr = backupId);
+        return true;
+    }
+} cmdEndInitialSyncBackup;
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
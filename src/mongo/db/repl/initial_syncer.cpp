@@ -440,9 +440,11 @@ BSONObj InitialSyncer::_getInitialSyncProgress_inlock() const {
         _appendInitialSyncProgressMinimal_inlock(&bob);
         if (_initialSyncState) {
             if (_initialSyncState->allDatabaseCloner) {
+                auto stats = _initialSyncState->allDatabaseCloner->getStats();
                 BSONObjBuilder dbsBuilder(bob.subobjStart("databases"));
-                _initialSyncState->allDatabaseCloner->getStats().append(&dbsBuilder);
+                stats.append(&dbsBuilder);
                 dbsBuilder.doneFast();
+                stats.appendProgressEstimate(&bob, _sharedData->getClock()->now());
             }
         }
         return bob.obj();
@@ -44,12 +44,14 @@
 #include "mongo/db/logical_session_id.h"
 #include "mongo/db/repl/apply_ops.h"
 #include "mongo/db/repl/insert_group.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/transaction_oplog_application.h"
 #include "mongo/db/stats/timer_stats.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/basic.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/log_with_sampling.h"
+#include "mongo/util/timer.h"
 #include "third_party/murmurhash3/MurmurHash3.h"
 
 namespace mongo {
@@ -72,6 +74,21 @@ ServerStatusMetricField<Counter64> displayOplogApplicationBatchSize("repl.apply.
 TimerStats applyBatchStats;
 ServerStatusMetricField<TimerStats> displayOpBatchesApplied("repl.apply.batches", &applyBatchStats);
 
+// Time the writer threads spent applying ops, and time they spent waiting for the rest of the
+// batch to be applied. Together they give the utilisation of the writer pool.
+Counter64 writerBusyMicros;
+ServerStatusMetricField<Counter64> displayWriterBusyMicros("repl.apply.writers.busyMicros",
+                                                           &writerBusyMicros);
+Counter64 writerIdleMicros;
+ServerStatusMetricField<Counter64> displayWriterIdleMicros("repl.apply.writers.idleMicros",
+                                                           &writerIdleMicros);
+
+// Number of writer vectors applied by a writer thread after its first, i.e. taken over from a
+// writer thread that was still busy.
+Counter64 writerVectorsStolen;
+ServerStatusMetricField<Counter64> displayWriterVectorsStolen("repl.apply.writers.stolen",
+                                                             &writerVectorsStolen);
+
 NamespaceString parseUUIDOrNs(OperationContext* opCtx, const OplogEntry& oplogEntry) {
     auto optionalUuid = oplogEntry.getUuid();
     if (!optionalUuid) {
@@ -421,6 +438,10 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
             ? new ApplyBatchFinalizerForJournal(_replCoord)
             : new ApplyBatchFinalizer(_replCoord)};
 
+    // The batch taken from the batcher, and possibly already written to the oplog, while the
+    // previous batch was being applied.
+    std::unique_ptr<PreparedOplogBatch> nextBatch;
+
     while (true) {  // Exits on message from OplogBatcher.
         // Use a new operation context each iteration, as otherwise we may appear to use a single
         // collection name to refer to collections with different UUIDs.
@@ -443,31 +464,37 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
         // Transition to SECONDARY state, if possible.
         _replCoord->finishRecoveryIfEligible(&opCtx);
 
-        // Blocks up to a second waiting for a batch to be ready to apply. If one doesn't become
-        // ready in time, we'll loop again so we can do the above checks periodically.
-        OplogBatch ops = _oplogBatcher->getNextBatch(Seconds(1));
-        if (ops.empty()) {
-            if (ops.mustShutdown()) {
-                // Shut down and exit oplog application loop.
-                return;
-            }
-            if (MONGO_unlikely(rsSyncApplyStop.shouldFail())) {
-                continue;
-            }
-            if (ops.termWhenExhausted()) {
-                // Signal drain complete if we're in Draining state and the buffer is empty.
-                // Since we check the states of batcher and oplog buffer without synchronization,
-                // they can be stale. We make sure the applier is still draining in the given term
-                // before and after the check, so that if the oplog buffer was exhausted, then
-                // it still will be.
-                _replCoord->signalDrainComplete(&opCtx, *ops.termWhenExhausted());
+        std::unique_ptr<PreparedOplogBatch> batch = std::move(nextBatch);
+        if (!batch) {
+            // Blocks up to a second waiting for a batch to be ready to apply. If one doesn't
+            // become ready in time, we'll loop again so we can do the above checks periodically.
+            OplogBatch ops = _oplogBatcher->getNextBatch(Seconds(1));
+            if (ops.empty()) {
+                if (ops.mustShutdown()) {
+                    // Shut down and exit oplog application loop.
+                    return;
+                }
+                if (MONGO_unlikely(rsSyncApplyStop.shouldFail())) {
+                    continue;
+                }
+                if (ops.termWhenExhausted()) {
+                    // Signal drain complete if we're in Draining state and the buffer is empty.
+                    // Since we check the states of batcher and oplog buffer without
+                    // synchronization, they can be stale. We make sure the applier is still
+                    // draining in the given term before and after the check, so that if the oplog
+                    // buffer was exhausted, then it still will be.
+                    _replCoord->signalDrainComplete(&opCtx, *ops.termWhenExhausted());
+                }
+                continue;  // Try again.
             }
-            continue;  // Try again.
+
+            batch = std::make_unique<PreparedOplogBatch>();
+            batch->ops = ops.releaseBatch();
         }
 
-        // Extract some info from ops that we'll need after releasing the batch below.
-        const auto firstOpTimeInBatch = ops.front().getOpTime();
-        const auto lastOpInBatch = ops.back();
+        // Extract some info from ops that we'll need after applying the batch below.
+        const auto firstOpTimeInBatch = batch->ops.front().getOpTime();
+        const auto lastOpInBatch = batch->ops.back();
         const auto lastOpTimeInBatch = lastOpInBatch.getOpTime();
         const auto lastWallTimeInBatch = lastOpInBatch.getWallClockTime();
         const auto lastAppliedOpTimeAtStartOfBatch = _replCoord->getMyLastAppliedOpTime();
@@ -485,9 +512,12 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
         // Don't allow the fsync+lock thread to see intermediate states of batch application.
         stdx::lock_guard<SimpleMutex> fsynclk(filesLockedFsync);
 
-        // Apply the operations in this batch. '_applyOplogBatch' returns the optime of the
-        // last op that was applied, which should be the last optime in the batch.
-        auto swLastOpTimeAppliedInBatch = _applyOplogBatch(&opCtx, ops.releaseBatch());
+        // Apply the operations in this batch. '_applyPreparedOplogBatch' returns the optime of
+        // the last op that was applied, which should be the last optime in the batch. When more
+        // than one batch may be in flight, the next batch is prepared while this one is applied.
+        const bool prepareNextBatch = replApplierMaxBatchesInFlight.load() > 1;
+        auto swLastOpTimeAppliedInBatch = _applyPreparedOplogBatch(
+            &opCtx, batch.get(), prepareNextBatch ? &nextBatch : nullptr);
         if (swLastOpTimeAppliedInBatch.getStatus().code() == ErrorCodes::InterruptedAtShutdown) {
             // If an operation was interrupted at shutdown, fail the batch without advancing
             // appliedThrough as if this were an unclean shutdown. This ensures the stable timestamp
@@ -532,6 +562,42 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
 }
 
 
+namespace {
+
+// Writes the oplog entries in 'ops' between 'begin' and 'end' to the oplog.
+void writeOplogEntries(OperationContext* opCtx,
+                       StorageInterface* storageInterface,
+                       const std::vector<OplogEntry>& ops,
+                       size_t begin,
+                       size_t end) {
+    UnreplicatedWritesBlock uwb(opCtx);
+
+    std::vector<InsertStatement> docs;
+    docs.reserve(end - begin);
+    for (size_t i = begin; i < end; i++) {
+        // Add as unowned BSON to avoid unnecessary ref-count bumps.
+        // 'ops' will outlive 'docs' so the BSON lifetime will be guaranteed.
+        docs.emplace_back(InsertStatement{
+            ops[i].getRaw(), ops[i].getOpTime().getTimestamp(), ops[i].getOpTime().getTerm()});
+    }
+
+    fassert(40141,
+            storageInterface->insertDocuments(opCtx, NamespaceString::kRsOplogNamespace, docs));
+}
+
+// Returns true if the catalog state 'ops' is partitioned against cannot be changed by applying
+// them, so that the batch after them may be partitioned before they have been applied. Commands,
+// including applyOps and transactions, are always batched on their own, so this excludes batches
+// containing them and the other entries that the OplogBatcher processes individually.
+bool canPrepareNextBatchWhileApplying(const std::vector<OplogEntry>& ops) {
+    return std::none_of(ops.begin(), ops.end(), [](const OplogEntry& op) {
+        return op.isCommand() || op.getNss().isSystemDotViews() ||
+            op.getNss().isServerConfigurationCollection();
+    });
+}
+
+}  // namespace
+
 // Schedules the writes to the oplog for 'ops' into threadPool. The caller must guarantee that
 // 'ops' stays valid until all scheduled work in the thread pool completes.
 void scheduleWritesToOplog(OperationContext* opCtx,
@@ -551,23 +617,10 @@ void scheduleWritesToOplog(OperationContext* opCtx,
             // safe to exclude any writes from Flow Control.
             opCtx->setShouldParticipateInFlowControl(false);
 
-            UnreplicatedWritesBlock uwb(opCtx.get());
             ShouldNotConflictWithSecondaryBatchApplicationBlock shouldNotConflictBlock(
                 opCtx->lockState());
 
-            std::vector<InsertStatement> docs;
-            docs.reserve(end - begin);
-            for (size_t i = begin; i < end; i++) {
-                // Add as unowned BSON to avoid unnecessary ref-count bumps.
-                // 'ops' will outlive 'docs' so the BSON lifetime will be guaranteed.
-                docs.emplace_back(InsertStatement{ops[i].getRaw(),
-                                                  ops[i].getOpTime().getTimestamp(),
-                                                  ops[i].getOpTime().getTerm()});
-            }
-
-            fassert(40141,
-                    storageInterface->insertDocuments(
-                        opCtx.get(), NamespaceString::kRsOplogNamespace, docs));
+            writeOplogEntries(opCtx.get(), storageInterface, ops, begin, end);
         };
     };
 
@@ -599,8 +652,57 @@ void scheduleWritesToOplog(OperationContext* opCtx,
     }
 }
 
+size_t OplogApplierImpl::_numWriterVectors() const {
+    return _writerPool->getStats().numThreads * replWriterVectorsPerThread.load();
+}
+
 StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
                                                       std::vector<OplogEntry> ops) {
+    PreparedOplogBatch batch;
+    batch.ops = std::move(ops);
+    return _applyPreparedOplogBatch(opCtx, &batch, nullptr);
+}
+
+std::unique_ptr<OplogApplierImpl::PreparedOplogBatch> OplogApplierImpl::_prepareNextOplogBatch(
+    OperationContext* opCtx, const OpTime& lastOpTimeInCurrentBatch) {
+    OplogBatch ops = _oplogBatcher->tryGetNextBatch();
+    if (ops.empty()) {
+        return nullptr;
+    }
+
+    auto nextBatch = std::make_unique<PreparedOplogBatch>();
+    nextBatch->ops = ops.releaseBatch();
+    if (getOptions().skipWritesToOplog || !canPrepareNextBatchWhileApplying(nextBatch->ops)) {
+        // The batch will be written and partitioned once the current batch has been applied.
+        return nextBatch;
+    }
+
+    LOGV2_DEBUG(4937800,
+                2,
+                "Preparing next replication batch while applying the current one",
+                "size"_attr = nextBatch->ops.size());
+
+    // If we crash before the next batch has been applied, recovery must truncate its entries
+    // since minValid does not cover them yet. The current batch is covered by minValid, so we
+    // truncate after its last entry rather than at our last applied optime.
+    _consistencyMarkers->setOplogTruncateAfterPoint(opCtx,
+                                                    lastOpTimeInCurrentBatch.getTimestamp());
+
+    // The writer threads are busy with the current batch, so write the oplog entries on this
+    // thread. We hold the PBWM lock already, so there is nothing to conflict with.
+    writeOplogEntries(opCtx, _storageInterface, nextBatch->ops, 0, nextBatch->ops.size());
+
+    nextBatch->writerVectors.resize(_numWriterVectors());
+    fillWriterVectors(opCtx, &nextBatch->ops, &nextBatch->writerVectors, &nextBatch->derivedOps);
+    nextBatch->writtenToOplog = true;
+    return nextBatch;
+}
+
+StatusWith<OpTime> OplogApplierImpl::_applyPreparedOplogBatch(
+    OperationContext* opCtx,
+    PreparedOplogBatch* batch,
+    std::unique_ptr<PreparedOplogBatch>* nextBatch) {
+    auto& ops = batch->ops;
     invariant(!ops.empty());
 
     LOGV2_DEBUG(21230, 2, "replication batch size is {size}", "size"_attr = ops.size());
@@ -628,13 +730,6 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
         // because the spawned threads refer to objects on the stack
         ON_BLOCK_EXIT([&] { _writerPool->waitForIdle(); });
 
-        // Write batch of ops into oplog.
-        if (!getOptions().skipWritesToOplog) {
-            _consistencyMarkers->setOplogTruncateAfterPoint(
-                opCtx, _replCoord->getMyLastAppliedOpTime().getTimestamp());
-            scheduleWritesToOplog(opCtx, _storageInterface, _writerPool, ops);
-        }
-
         // Holds 'pseudo operations' generated by secondaries to aid in replication.
         // Keep in scope until all operations in 'ops' and 'derivedOps' have been applied.
         // Pseudo operations include:
@@ -642,14 +737,25 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
         // - ops to update config.transactions. Normal writes to config.transactions in the
         //   primary don't create an oplog entry, so extract info from writes with transactions
         //   and create a pseudo oplog.
-        std::vector<std::vector<OplogEntry>> derivedOps;
+        auto& derivedOps = batch->derivedOps;
+        auto& writerVectors = batch->writerVectors;
+
+        // A batch prepared while the previous batch was being applied has already been written to
+        // the oplog and partitioned.
+        if (!batch->writtenToOplog) {
+            // Write batch of ops into oplog.
+            if (!getOptions().skipWritesToOplog) {
+                _consistencyMarkers->setOplogTruncateAfterPoint(
+                    opCtx, _replCoord->getMyLastAppliedOpTime().getTimestamp());
+                scheduleWritesToOplog(opCtx, _storageInterface, _writerPool, ops);
+            }
 
-        std::vector<std::vector<const OplogEntry*>> writerVectors(
-            _writerPool->getStats().numThreads);
-        fillWriterVectors(opCtx, &ops, &writerVectors, &derivedOps);
+            writerVectors.resize(_numWriterVectors());
+            fillWriterVectors(opCtx, &ops, &writerVectors, &derivedOps);
 
-        // Wait for writes to finish before applying ops.
-        _writerPool->waitForIdle();
+            // Wait for writes to finish before applying ops.
+            _writerPool->waitForIdle();
+        }
 
         // Use this fail point to hold the PBWM lock after we have written the oplog entries but
         // before we have applied them.
@@ -667,36 +773,82 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
         }
 
         {
-            std::vector<Status> statusVector(_writerPool->getStats().numThreads, Status::OK());
+            const size_t numWriters = _writerPool->getStats().numThreads;
+            std::vector<Status> statusVector(numWriters, Status::OK());
+
+            // Each writer vector is an independent chain of ops: all ops on the same document, and
+            // all ops on a capped collection, hash to the same vector. There are several vectors
+            // per writer thread, and they are handed out largest first to whichever thread is free,
+            // so that one hot vector does not leave the other writer threads idle.
+            std::vector<size_t> writerVectorOrder;
+            for (size_t i = 0; i < writerVectors.size(); i++) {
+                if (!writerVectors[i].empty()) {
+                    writerVectorOrder.push_back(i);
+                }
+            }
+            std::stable_sort(writerVectorOrder.begin(),
+                             writerVectorOrder.end(),
+                             [&](size_t l, size_t r) {
+                                 return writerVectors[l].size() > writerVectors[r].size();
+                             });
+            AtomicWord<size_t> nextWriterVector{0};
+            AtomicWord<long long> busyMicros{0};
+            Timer applyTimer;
 
             // Doles out all the work to the writer pool threads. writerVectors is not modified,
             // but  applyOplogBatchPerWorker will modify the vectors that it contains.
-            invariant(writerVectors.size() == statusVector.size());
-            for (size_t i = 0; i < writerVectors.size(); i++) {
-                if (writerVectors[i].empty())
-                    continue;
-
-                _writerPool->schedule(
-                    [this,
-                     &writer = writerVectors.at(i),
-                     &status = statusVector.at(i),
-                     &multikeyVector = multikeyVector.at(i)](auto scheduleStatus) {
-                        invariant(scheduleStatus);
-
-                        auto opCtx = cc().makeOperationContext();
-
-                        // This code path is only executed on secondaries and initial syncing nodes,
-                        // so it is safe to exclude any writes from Flow Control.
-                        opCtx->setShouldParticipateInFlowControl(false);
-
-                        status = opCtx->runWithoutInterruptionExceptAtGlobalShutdown([&] {
-                            return applyOplogBatchPerWorker(opCtx.get(), &writer, &multikeyVector);
-                        });
+            const size_t numActiveWriters = std::min(numWriters, writerVectorOrder.size());
+            for (size_t i = 0; i < numActiveWriters; i++) {
+                _writerPool->schedule([this,
+                                       &writerVectors,
+                                       &writerVectorOrder,
+                                       &nextWriterVector,
+                                       &busyMicros,
+                                       &status = statusVector.at(i),
+                                       &multikeyVector = multikeyVector.at(i)](auto scheduleStatus) {
+                    invariant(scheduleStatus);
+
+                    auto opCtx = cc().makeOperationContext();
+
+                    // This code path is only executed on secondaries and initial syncing nodes,
+                    // so it is safe to exclude any writes from Flow Control.
+                    opCtx->setShouldParticipateInFlowControl(false);
+
+                    Timer busyTimer;
+                    status = opCtx->runWithoutInterruptionExceptAtGlobalShutdown([&] {
+                        for (size_t applied = 0;; applied++) {
+                            const auto next = nextWriterVector.fetchAndAdd(1);
+                            if (next >= writerVectorOrder.size()) {
+                                return Status::OK();
+                            }
+                            if (applied > 0) {
+                                writerVectorsStolen.increment();
+                            }
+
+                            auto& writer = writerVectors[writerVectorOrder[next]];
+                            auto writerStatus =
+                                applyOplogBatchPerWorker(opCtx.get(), &writer, &multikeyVector);
+                            if (!writerStatus.isOK()) {
+                                return writerStatus;
+                            }
+                        }
                     });
+                    busyMicros.fetchAndAdd(busyTimer.micros());
+                });
+            }
+
+            // While the writer threads apply this batch, write and partition the next one.
+            if (nextBatch && canPrepareNextBatchWhileApplying(ops)) {
+                *nextBatch = _prepareNextOplogBatch(opCtx, ops.back().getOpTime());
             }
 
             _writerPool->waitForIdle();
 
+            const long long applyMicros = applyTimer.micros();
+            writerBusyMicros.increment(busyMicros.load());
+            writerIdleMicros.increment(
+                std::max(0LL, applyMicros * static_cast<long long>(numWriters) - busyMicros.load()));
+
             // If any of the statuses is not ok, return error.
             for (auto it = statusVector.cbegin(); it != statusVector.cend(); ++it) {
                 const auto& status = *it;
@@ -98,6 +98,40 @@ private:
      */
     StatusWith<OpTime> _applyOplogBatch(OperationContext* opCtx, std::vector<OplogEntry> ops);
 
+    /**
+     * A batch of oplog entries along with the work done to prepare it for application. If
+     * 'writtenToOplog' is set, the entries have already been written to the oplog and partitioned
+     * into 'writerVectors', which point into 'ops' and 'derivedOps'.
+     */
+    struct PreparedOplogBatch {
+        std::vector<OplogEntry> ops;
+        std::vector<std::vector<OplogEntry>> derivedOps;
+        std::vector<std::vector<const OplogEntry*>> writerVectors;
+        bool writtenToOplog = false;
+    };
+
+    /**
+     * Applies 'batch' as described for _applyOplogBatch(), skipping the oplog write and
+     * partitioning if they were already done.
+     *
+     * If 'nextBatch' is not null, then while the writer threads apply 'batch' this thread takes the
+     * next batch from the OplogBatcher, if one is ready, and stores it in 'nextBatch'. When both
+     * batches contain only CRUD operations the next batch is also written to the oplog and
+     * partitioned, with the oplog truncate after point set to the last optime of 'batch' so that
+     * its entries are truncated if we crash before applying it.
+     */
+    StatusWith<OpTime> _applyPreparedOplogBatch(OperationContext* opCtx,
+                                                PreparedOplogBatch* batch,
+                                                std::unique_ptr<PreparedOplogBatch>* nextBatch);
+
+    /**
+     * Takes the next batch from the OplogBatcher without waiting and, if possible, prepares it
+     * while the batch ending at 'lastOpTimeInCurrentBatch' is being applied. Returns nullptr if no
+     * batch was ready.
+     */
+    std::unique_ptr<PreparedOplogBatch> _prepareNextOplogBatch(
+        OperationContext* opCtx, const OpTime& lastOpTimeInCurrentBatch);
+
     void _deriveOpsAndFillWriterVectors(OperationContext* opCtx,
                                         std::vector<OplogEntry>* ops,
                                         std::vector<std::vector<const OplogEntry*>>* writerVectors,
@@ -119,6 +153,12 @@ private:
     // we will apply all operations that were fetched.
     OpTime _beginApplyingOpTime = OpTime();
 
+    /**
+     * Returns the number of writer vectors a batch is partitioned into. Writer threads take
+     * writer vectors from the batch until none are left.
+     */
+    size_t _numWriterVectors() const;
+
     void fillWriterVectors(OperationContext* opCtx,
                            std::vector<OplogEntry>* ops,
                            std::vector<std::vector<const OplogEntry*>>* writerVectors,
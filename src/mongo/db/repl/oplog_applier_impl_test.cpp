@@ -30,6 +30,7 @@
 #include "mongo/platform/basic.h"
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -56,6 +57,8 @@
 #include "mongo/db/repl/idempotency_test_fixture.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplog_applier.h"
+#include "mongo/db/repl/oplog_buffer_blocking_queue.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/replication_process.h"
 #include "mongo/db/repl/storage_interface.h"
@@ -64,10 +67,14 @@
 #include "mongo/db/session_txn_record_gen.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/transaction_participant_gen.h"
+#include "mongo/executor/network_interface_mock.h"
+#include "mongo/executor/thread_pool_task_executor_test_fixture.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
+#include "mongo/util/fail_point.h"
 #include "mongo/util/md5.hpp"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/string_map.h"
@@ -383,6 +390,311 @@ TEST_F(OplogApplierImplTest,
                                                      createOplogCollectionOptions()));
 }
 
+/**
+ * Test only subclass of OplogApplierImpl that does not apply oplog entries, but tracks the writer
+ * vectors handed to the writer threads.
+ */
+class TrackWriterVectorsApplier : public OplogApplierImpl {
+public:
+    using OplogApplierImpl::OplogApplierImpl;
+
+    Status applyOplogBatchPerWorker(OperationContext* opCtx,
+                                    std::vector<const OplogEntry*>* ops,
+                                    WorkerMultikeyPathInfo* workerMultikeyPathInfo) override {
+        std::vector<OplogEntry> writerVector;
+        for (auto&& opPtr : *ops) {
+            writerVector.push_back(*opPtr);
+        }
+        stdx::lock_guard<Latch> lk(mutex);
+        writerVectorsApplied.push_back(std::move(writerVector));
+        return Status::OK();
+    }
+
+    Mutex mutex = MONGO_MAKE_LATCH("TrackWriterVectorsApplier::mutex");
+    std::vector<std::vector<OplogEntry>> writerVectorsApplied;
+};
+
+TEST_F(OplogApplierImplTest, MultiApplySplitsBatchIntoMoreWriterVectorsThanWriterThreads) {
+    NamespaceString nss("test." + _agent.getSuiteName() + "_" + _agent.getTestName());
+    createCollection(_opCtx.get(), nss, CollectionOptions());
+
+    // Two updates to each of 32 documents.
+    std::vector<OplogEntry> ops;
+    for (int i = 0; i < 64; i++) {
+        ops.push_back(makeUpdateDocumentOplogEntry({Timestamp(Seconds(1), i + 1), 1LL},
+                                                   nss,
+                                                   BSON("_id" << i % 32),
+                                                   BSON("$set" << BSON("x" << i))));
+    }
+
+    const int numWriters = 4;
+    auto writerPool = makeReplWriterPool(numWriters);
+    NoopOplogApplierObserver observer;
+    TrackWriterVectorsApplier oplogApplier(
+        nullptr,  // executor
+        nullptr,  // oplogBuffer
+        &observer,
+        ReplicationCoordinator::get(_opCtx.get()),
+        getConsistencyMarkers(),
+        getStorageInterface(),
+        repl::OplogApplier::Options(repl::OplogApplication::Mode::kSecondary),
+        writerPool.get());
+    ASSERT_EQUALS(ops.back().getOpTime(),
+                  unittest::assertGet(oplogApplier.applyOplogBatch(_opCtx.get(), ops)));
+
+    // The writer threads took more writer vectors than there are threads.
+    ASSERT_GT(oplogApplier.writerVectorsApplied.size(), size_t(numWriters));
+
+    // Both updates to a document were applied from the same writer vector, in oplog order.
+    std::map<int, Timestamp> lastUpdate;
+    std::map<int, size_t> writerVectorForId;
+    size_t numApplied = 0;
+    for (size_t i = 0; i < oplogApplier.writerVectorsApplied.size(); i++) {
+        for (const auto& op : oplogApplier.writerVectorsApplied[i]) {
+            const int id = op.getObject2()->getIntField("_id");
+            ASSERT_EQUALS(i, writerVectorForId.emplace(id, i).first->second);
+            ASSERT_LT(lastUpdate[id], op.getTimestamp());
+            lastUpdate[id] = op.getTimestamp();
+            numApplied++;
+        }
+    }
+    ASSERT_EQUALS(ops.size(), numApplied);
+}
+
+/**
+ * Test only subclass of OplogApplierImpl that does not apply oplog entries, but tracks the ops
+ * applied. The writer threads applying ops at or before 'lastTimestampInFirstBatch' block until
+ * releaseFirstBatch() is called, and then fail with the given status.
+ */
+class BlockFirstBatchApplier : public OplogApplierImpl {
+public:
+    using OplogApplierImpl::OplogApplierImpl;
+
+    Status applyOplogBatchPerWorker(OperationContext* opCtx,
+                                    std::vector<const OplogEntry*>* ops,
+                                    WorkerMultikeyPathInfo* workerMultikeyPathInfo) override {
+        stdx::unique_lock<Latch> lk(mutex);
+        if (ops->front()->getTimestamp() <= lastTimestampInFirstBatch) {
+            firstBatchStarted = true;
+            cv.notify_all();
+            cv.wait(lk, [&] { return bool(firstBatchStatus); });
+            if (!firstBatchStatus->isOK()) {
+                return *firstBatchStatus;
+            }
+        }
+        for (auto&& opPtr : *ops) {
+            operationsApplied.push_back(*opPtr);
+        }
+        return Status::OK();
+    }
+
+    void waitForFirstBatchToStart() {
+        stdx::unique_lock<Latch> lk(mutex);
+        cv.wait(lk, [&] { return firstBatchStarted; });
+    }
+
+    void releaseFirstBatch(Status status = Status::OK()) {
+        stdx::lock_guard<Latch> lk(mutex);
+        firstBatchStatus = status;
+        cv.notify_all();
+    }
+
+    Timestamp lastTimestampInFirstBatch;
+
+    Mutex mutex = MONGO_MAKE_LATCH("BlockFirstBatchApplier::mutex");
+    stdx::condition_variable cv;
+    bool firstBatchStarted = false;
+    boost::optional<Status> firstBatchStatus;
+    std::vector<OplogEntry> operationsApplied;
+};
+
+/**
+ * Runs the oplog application loop over two batches of inserts, so that the second batch is ready
+ * in the OplogBatcher while the first is being applied.
+ */
+class OplogApplierImplBatchesInFlightTest : public OplogApplierImplTest {
+protected:
+    static constexpr int kBatchSize = 4;
+
+    void setUp() override {
+        OplogApplierImplTest::setUp();
+
+        executor::ThreadPoolMock::Options options;
+        options.onCreateThread = []() { Client::initThread("OplogApplierImplBatchesInFlight"); };
+        _executor = executor::makeThreadPoolTestExecutor(
+            std::make_unique<executor::NetworkInterfaceMock>(), options);
+        _executor->startup();
+
+        _writerPool = makeReplWriterPool(1);
+        _applier = std::make_unique<BlockFirstBatchApplier>(
+            _executor.get(),
+            &_buffer,
+            &_observer,
+            ReplicationCoordinator::get(_opCtx.get()),
+            getConsistencyMarkers(),
+            getStorageInterface(),
+            repl::OplogApplier::Options(repl::OplogApplication::Mode::kSecondary),
+            _writerPool.get());
+
+        NamespaceString nss("test.batchesInFlight");
+        createCollection(_opCtx.get(), nss, CollectionOptions());
+        for (int i = 0; i < 2 * kBatchSize; i++) {
+            _ops.push_back(makeInsertDocumentOplogEntry(
+                {Timestamp(Seconds(1), i + 1), 1LL}, nss, BSON("_id" << i)));
+        }
+        _applier->lastTimestampInFirstBatch = _ops[kBatchSize - 1].getTimestamp();
+
+        _originalBatchLimitOperations = replBatchLimitOperations.load();
+        _originalMaxBatchesInFlight = replApplierMaxBatchesInFlight.load();
+        replBatchLimitOperations.store(kBatchSize);
+    }
+
+    void tearDown() override {
+        replBatchLimitOperations.store(_originalBatchLimitOperations);
+        replApplierMaxBatchesInFlight.store(_originalMaxBatchesInFlight);
+
+        _executor->shutdown();
+        _executor->join();
+        _applier.reset();
+        _writerPool.reset();
+        OplogApplierImplTest::tearDown();
+    }
+
+    /**
+     * Starts oplog application with 'maxBatchesInFlight' and returns once a writer thread is
+     * applying the first batch. The second batch has been taken from the oplog buffer by then.
+     */
+    void startApplying(int maxBatchesInFlight) {
+        replApplierMaxBatchesInFlight.store(maxBatchesInFlight);
+        _applier->enqueue(_opCtx.get(), _ops.cbegin(), _ops.cend());
+
+        // Hold the first batch until the OplogBatcher has put together the second one, so that it
+        // is ready by the time the first batch is handed to the writer threads.
+        auto fp = globalFailPointRegistry().find("pauseBatchApplicationAfterWritingOplogEntries");
+        auto timesEntered = fp->setMode(FailPoint::alwaysOn);
+        ON_BLOCK_EXIT([&] { fp->setMode(FailPoint::off); });
+
+        _applierFuture = _applier->startup();
+        fp->waitForTimesEntered(timesEntered + 1);
+        while (!_buffer.isEmpty()) {
+            sleepmillis(10);
+        }
+        sleepmillis(100);
+        fp->setMode(FailPoint::off);
+
+        _applier->waitForFirstBatchToStart();
+    }
+
+    /**
+     * Waits up to ten seconds for the oplog truncate after point to reach 'timestamp'.
+     */
+    Timestamp waitForOplogTruncateAfterPoint(const Timestamp& timestamp) {
+        auto truncateAfterPoint = getConsistencyMarkers()->getOplogTruncateAfterPoint(_opCtx.get());
+        for (int i = 0; i < 1000 && truncateAfterPoint != timestamp; i++) {
+            sleepmillis(10);
+            truncateAfterPoint = getConsistencyMarkers()->getOplogTruncateAfterPoint(_opCtx.get());
+        }
+        return truncateAfterPoint;
+    }
+
+    /**
+     * Shuts down oplog application and waits for the application loop to exit.
+     */
+    void stopApplying() {
+        _applier->shutdown();
+        _applierFuture.get();
+    }
+
+    /**
+     * Asserts that every op was applied, and that all ops in the first batch were applied before
+     * any op in the second. Ops within a batch may be applied in any order.
+     */
+    void assertAppliedInBatchOrder() {
+        stdx::lock_guard<Latch> lk(_applier->mutex);
+        const auto& applied = _applier->operationsApplied;
+        ASSERT_EQUALS(_ops.size(), applied.size());
+        for (size_t i = 0; i < applied.size(); i++) {
+            const bool inFirstBatch =
+                applied[i].getTimestamp() <= _applier->lastTimestampInFirstBatch;
+            ASSERT_EQUALS(i < size_t(kBatchSize), inFirstBatch) << applied[i].toBSON();
+        }
+    }
+
+    std::unique_ptr<executor::ThreadPoolTaskExecutor> _executor;
+    OplogBufferBlockingQueue _buffer{nullptr};
+    NoopOplogApplierObserver _observer;
+    std::unique_ptr<ThreadPool> _writerPool;
+    std::unique_ptr<BlockFirstBatchApplier> _applier;
+    Future<void> _applierFuture;
+    std::vector<OplogEntry> _ops;
+
+private:
+    int _originalBatchLimitOperations = 0;
+    int _originalMaxBatchesInFlight = 0;
+};
+
+TEST_F(OplogApplierImplBatchesInFlightTest, OneBatchInFlightDoesNotPrepareTheNextBatch) {
+    startApplying(1);
+
+    // The second batch is not written to the oplog until the first has been applied.
+    sleepmillis(100);
+    ASSERT_EQUALS(Timestamp(), getConsistencyMarkers()->getOplogTruncateAfterPoint(_opCtx.get()));
+
+    _applier->releaseFirstBatch();
+    stopApplying();
+    assertAppliedInBatchOrder();
+    ASSERT_EQUALS(_ops.back().getOpTime(),
+                  getConsistencyMarkers()->getAppliedThrough(_opCtx.get()));
+}
+
+TEST_F(OplogApplierImplBatchesInFlightTest, TwoBatchesInFlightApplyBatchesInOrder) {
+    startApplying(2);
+
+    // The second batch is written to the oplog while the first is applied, with the oplog
+    // truncate after point covering its entries.
+    ASSERT_EQUALS(_applier->lastTimestampInFirstBatch,
+                  waitForOplogTruncateAfterPoint(_applier->lastTimestampInFirstBatch));
+    {
+        stdx::lock_guard<Latch> lk(_applier->mutex);
+        ASSERT_TRUE(_applier->operationsApplied.empty());
+    }
+
+    _applier->releaseFirstBatch();
+    stopApplying();
+    assertAppliedInBatchOrder();
+    ASSERT_EQUALS(Timestamp(), getConsistencyMarkers()->getOplogTruncateAfterPoint(_opCtx.get()));
+    ASSERT_EQUALS(_ops.back().getOpTime(),
+                  getConsistencyMarkers()->getAppliedThrough(_opCtx.get()));
+}
+
+TEST_F(OplogApplierImplBatchesInFlightTest, TwoBatchesInFlightApplyPreparedBatchAtShutdown) {
+    startApplying(2);
+    ASSERT_EQUALS(_applier->lastTimestampInFirstBatch,
+                  waitForOplogTruncateAfterPoint(_applier->lastTimestampInFirstBatch));
+
+    // The second batch has already been written to the oplog, so shutting down while the first
+    // is applied must not drop it.
+    _applier->shutdown();
+    _applier->releaseFirstBatch();
+    _applierFuture.get();
+
+    assertAppliedInBatchOrder();
+    ASSERT_EQUALS(Timestamp(), getConsistencyMarkers()->getOplogTruncateAfterPoint(_opCtx.get()));
+    ASSERT_EQUALS(_ops.back().getOpTime(),
+                  getConsistencyMarkers()->getAppliedThrough(_opCtx.get()));
+}
+
+DEATH_TEST_F(OplogApplierImplBatchesInFlightTest,
+             TwoBatchesInFlightAbortWhenApplyingFirstBatchFails,
+             "34437") {
+    startApplying(2);
+    ASSERT_EQUALS(_applier->lastTimestampInFirstBatch,
+                  waitForOplogTruncateAfterPoint(_applier->lastTimestampInFirstBatch));
+
+    _applier->releaseFirstBatch({ErrorCodes::OperationFailed, "failed to apply first batch"});
+    _applierFuture.get();
+}
+
 TEST_F(OplogApplierImplTest,
        OplogApplicationThreadFuncUsesApplyOplogEntryOrGroupedInsertsToApplyOperation) {
     NamespaceString nss("local." + _agent.getSuiteName() + "_" + _agent.getTestName());
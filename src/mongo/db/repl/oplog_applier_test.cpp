@@ -37,7 +37,11 @@
 #include "mongo/db/operation_context_noop.h"
 #include "mongo/db/repl/oplog_applier.h"
 #include "mongo/db/repl/oplog_buffer_blocking_queue.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
+#include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/db/service_context.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace repl {
@@ -307,6 +311,44 @@ TEST_F(OplogApplierTest, GetNextApplierBatchChecksBatchLimitsForNumberOfOperatio
     ASSERT_EQUALS(srcOps[4], batch[1]);
 }
 
+TEST_F(OplogApplierTest, GetNextApplierBatchEndsBatchAtEarliestWaitingReadWhenEnabled) {
+    std::vector<OplogEntry> srcOps;
+    srcOps.push_back(makeInsertOplogEntry(1, NamespaceString(dbName, "bar")));
+    srcOps.push_back(makeInsertOplogEntry(2, NamespaceString(dbName, "bar")));
+    srcOps.push_back(makeInsertOplogEntry(3, NamespaceString(dbName, "bar")));
+    srcOps.push_back(makeInsertOplogEntry(4, NamespaceString(dbName, "bar")));
+    _applier->enqueue(_opCtx.get(), srcOps.cbegin(), srcOps.cend());
+
+    // A read is waiting for the second entry to be applied.
+    auto service = ServiceContext::make();
+    ReplicationCoordinatorMock replCoord(service.get());
+    replCoord.setEarliestOpTimeWaitingForLastApplied(srcOps[1].getOpTime());
+
+    const bool originalBoundaryAtWaitingReads = replBatchBoundaryAtWaitingReads.load();
+    ON_BLOCK_EXIT(
+        [&] { replBatchBoundaryAtWaitingReads.store(originalBoundaryAtWaitingReads); });
+
+    // Waiting reads do not end a batch unless replBatchBoundaryAtWaitingReads is enabled.
+    replBatchBoundaryAtWaitingReads.store(false);
+    ASSERT_EQUALS(Timestamp(), getBatchBoundaryForWaitingReads(&replCoord));
+
+    replBatchBoundaryAtWaitingReads.store(true);
+    _limits.forceBatchBoundaryAfter = getBatchBoundaryForWaitingReads(&replCoord);
+    ASSERT_EQUALS(srcOps[1].getTimestamp(), _limits.forceBatchBoundaryAfter);
+
+    // First batch: [insert, insert], ending at the entry the read waits for.
+    auto batch = unittest::assertGet(_applier->getNextApplierBatch(_opCtx.get(), _limits));
+    ASSERT_EQUALS(2U, batch.size()) << toString(batch);
+    ASSERT_EQUALS(srcOps[0], batch[0]);
+    ASSERT_EQUALS(srcOps[1], batch[1]);
+
+    // Second batch: [insert, insert]
+    batch = unittest::assertGet(_applier->getNextApplierBatch(_opCtx.get(), _limits));
+    ASSERT_EQUALS(2U, batch.size()) << toString(batch);
+    ASSERT_EQUALS(srcOps[2], batch[0]);
+    ASSERT_EQUALS(srcOps[3], batch[1]);
+}
+
 TEST_F(OplogApplierTest, GetNextApplierBatchChecksBatchLimitsForSizeOfOperations) {
     std::vector<OplogEntry> srcOps;
     srcOps.push_back(makeInsertOplogEntry(1, NamespaceString(dbName, "bar")));
@@ -70,6 +70,18 @@ OplogBatch OplogBatcher::getNextBatch(Seconds maxWaitTime) {
     return ops;
 }
 
+OplogBatch OplogBatcher::tryGetNextBatch() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_ops.empty()) {
+        return OplogBatch(0);
+    }
+
+    OplogBatch ops = std::move(_ops);
+    _ops = OplogBatch(0);
+    _cv.notify_all();
+    return ops;
+}
+
 void OplogBatcher::startup(StorageInterface* storageInterface) {
     _thread = std::make_unique<stdx::thread>([this, storageInterface] { _run(storageInterface); });
 }
@@ -264,6 +276,12 @@ void OplogBatcher::_run(StorageInterface* storageInterface) {
         // Check the limits once per batch since users can change them at runtime.
         batchLimits.ops = getBatchLimitOplogEntries();
 
+        // Only batch boundaries are consistent points that reads can see, so end the batch where
+        // the earliest waiting read can be satisfied rather than making it wait for the whole
+        // batch.
+        batchLimits.forceBatchBoundaryAfter =
+            getBatchBoundaryForWaitingReads(ReplicationCoordinator::get(cc().getServiceContext()));
+
         // Use the OplogBuffer to populate a local OplogBatch. Note that the buffer may be empty.
         OplogBatch ops(batchLimits.ops);
         {
@@ -358,5 +376,13 @@ std::size_t getBatchLimitOplogBytes(OperationContext* opCtx, StorageInterface* s
     return std::min(oplogMaxSize / 10, std::size_t(replBatchLimitBytes.load()));
 }
 
+Timestamp getBatchBoundaryForWaitingReads(ReplicationCoordinator* replCoord) {
+    if (!replBatchBoundaryAtWaitingReads.load()) {
+        return Timestamp();
+    }
+    auto waitingFor = replCoord->getEarliestOpTimeWaitingForLastApplied();
+    return waitingFor ? waitingFor->getTimestamp() : Timestamp();
+}
+
 }  // namespace repl
 }  // namespace mongo
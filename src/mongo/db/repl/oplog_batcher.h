@@ -40,6 +40,7 @@ namespace mongo {
 namespace repl {
 
 class OplogApplier;
+class ReplicationCoordinator;
 
 /**
  * Stores a batch of oplog entries for oplog application.
@@ -151,6 +152,13 @@ public:
      */
     OplogBatch getNextBatch(Seconds maxWaitTime);
 
+    /**
+     * Returns the batch of oplog entries if one is ready, without waiting. Unlike getNextBatch(),
+     * this never consumes a shutdown or drain signal: if no entries are ready, an empty batch is
+     * returned and any pending signal is left for the next call to getNextBatch().
+     */
+    OplogBatch tryGetNextBatch();
+
     /**
      * Starts up a thread to continuously pull from the OplogBuffer into the OplogBatcher's oplog
      * batch.
@@ -214,5 +222,12 @@ std::size_t getBatchLimitOplogEntries();
  */
 std::size_t getBatchLimitOplogBytes(OperationContext* opCtx, StorageInterface* storageInterface);
 
+/**
+ * Returns the timestamp after which the next batch must end so that the earliest read waiting for
+ * lastApplied can be satisfied, or a null timestamp if replBatchBoundaryAtWaitingReads is disabled
+ * or no read is waiting.
+ */
+Timestamp getBatchBoundaryForWaitingReads(ReplicationCoordinator* replCoord);
+
 }  // namespace repl
 }  // namespace mongo
@@ -115,6 +115,15 @@ Milliseconds calculateAwaitDataTimeout(const ReplSetConfig& config) {
     return std::min((config.getElectionTimeoutPeriod() / 2), maximumAwaitDataTimeoutMS);
 }
 
+/**
+ * Whether the oplog fetcher sizes its batches with an OplogFetcherBatchSizer. An exhaust cursor
+ * keeps streaming batches of the size its stream was started with, so a new size would never reach
+ * the sync source.
+ */
+bool useAdaptiveBatchSize() {
+    return oplogFetcherAdaptiveBatchSize.load() && !oplogFetcherUsesExhaust;
+}
+
 /**
  * Checks the first batch of results from query.
  * 'documents' are the first batch of results returned from tailing the remote oplog.
@@ -300,6 +309,51 @@ StatusWith<OplogFetcher::DocumentsInfo> OplogFetcher::validateDocuments(
     return info;
 }
 
+OplogFetcherBatchSizer::OplogFetcherBatchSizer(int maxBatchSize)
+    : _maxBatchSize(maxBatchSize), _batchSize(maxBatchSize) {}
+
+int OplogFetcherBatchSizer::recordBatch(int numDocs, long long numBytes, Microseconds elapsed) {
+    // A batch that took no measurable time carries no timing signal, and taking it as the round
+    // trip time would make every later batch look link-limited.
+    if (numDocs <= 0 || elapsed <= Microseconds(0)) {
+        return _batchSize;
+    }
+
+    if (!_minRoundTrip || elapsed < *_minRoundTrip) {
+        _minRoundTrip = elapsed;
+    }
+
+    // A batch smaller than requested means the sync source sent everything it had, which tells us
+    // nothing about the link.
+    if (numDocs < _batchSize) {
+        return _batchSize;
+    }
+
+    const auto transferTime = elapsed - *_minRoundTrip;
+    long long targetBatchSize;
+    if (transferTime <= Microseconds(0)) {
+        // The batch took no longer than a round trip, so the link is not what limits us.
+        targetBatchSize = 2LL * _batchSize;
+    } else {
+        const double bytesPerMicro = double(numBytes) / durationCount<Microseconds>(transferTime);
+        const double bandwidthDelayProduct =
+            bytesPerMicro * durationCount<Microseconds>(*_minRoundTrip);
+        const double avgDocBytes = std::max(1.0, double(numBytes) / numDocs);
+        targetBatchSize =
+            static_cast<long long>(kRoundTripsPerBatch * bandwidthDelayProduct / avgDocBytes);
+
+        // Move at most a factor of two per batch so that a single noisy sample cannot swing the
+        // batch size.
+        targetBatchSize = std::max(targetBatchSize, _batchSize / 2LL);
+        targetBatchSize = std::min(targetBatchSize, 2LL * _batchSize);
+    }
+
+    const long long minBatchSize = std::min(kMinBatchSize, _maxBatchSize);
+    _batchSize = static_cast<int>(
+        std::max(minBatchSize, std::min(targetBatchSize, static_cast<long long>(_maxBatchSize))));
+    return _batchSize;
+}
+
 OplogFetcher::OplogFetcher(executor::TaskExecutor* executor,
                            OpTime lastFetched,
                            HostAndPort source,
@@ -325,6 +379,7 @@ OplogFetcher::OplogFetcher(executor::TaskExecutor* executor,
       _enqueueDocumentsFn(enqueueDocumentsFn),
       _awaitDataTimeout(calculateAwaitDataTimeout(config)),
       _batchSize(batchSize),
+      _batchSizer(batchSize),
       _startingPoint(startingPoint) {
     invariant(config.isInitialized());
     invariant(!_lastFetched.isNull());
@@ -624,6 +679,10 @@ BSONObj OplogFetcher::_makeFindQuery(long long findTimeout) const {
     return queryBob.obj();
 }
 
+int OplogFetcher::_getBatchSize() const {
+    return useAdaptiveBatchSize() ? _batchSizer.getBatchSize() : _batchSize;
+}
+
 void OplogFetcher::_createNewCursor(bool initialFind) {
     invariant(_conn);
 
@@ -641,7 +700,7 @@ void OplogFetcher::_createNewCursor(bool initialFind) {
         nullptr /* fieldsToReturn */,
         QueryOption_CursorTailable | QueryOption_AwaitData | QueryOption_OplogReplay |
             (oplogFetcherUsesExhaust ? QueryOption_Exhaust : 0),
-        _batchSize);
+        _getBatchSize());
 
     _firstBatch = true;
 
@@ -676,8 +735,8 @@ StatusWith<OplogFetcher::Documents> OplogFetcher::_getNextBatch() {
             // Due to a bug in DBClientCursor, it actually uses batchSize 2 if the given batchSize
             // is 1 for the find command. So if the given batchSize is 1, we need to set it
             // explicitly for getMores.
-            if (_batchSize == 1) {
-                _cursor->setBatchSize(_batchSize);
+            if (_getBatchSize() == 1) {
+                _cursor->setBatchSize(1);
             }
         } else {
             auto lastCommittedWithCurrentTerm =
@@ -689,13 +748,30 @@ StatusWith<OplogFetcher::Documents> OplogFetcher::_getNextBatch() {
             _cursor->more();
         }
 
+        long long batchBytes = 0;
         while (_cursor->moreInCurrentBatch()) {
             batch.emplace_back(_cursor->nextSafe());
+            batchBytes += batch.back().objsize();
         }
 
         // This value is only used on a successful batch for metrics.repl.network.getmores. This
         // metric intentionally tracks the time taken by the initial find as well.
-        _lastBatchElapsedMS = timer.millis();
+        const auto elapsed = Microseconds(timer.micros());
+        _lastBatchElapsedMS = durationCount<Milliseconds>(elapsed);
+
+        if (useAdaptiveBatchSize()) {
+            const auto requestedBatchSize = _batchSizer.getBatchSize();
+            const auto nextBatchSize =
+                _batchSizer.recordBatch(batch.size(), batchBytes, elapsed);
+            if (nextBatchSize != requestedBatchSize) {
+                LOGV2_DEBUG(4937900,
+                            2,
+                            "Oplog fetcher changed the batch size requested from the sync source",
+                            "batchSize"_attr = nextBatchSize,
+                            "previousBatchSize"_attr = requestedBatchSize);
+                _cursor->setBatchSize(nextBatchSize);
+            }
+        }
     } catch (const DBException& ex) {
         if (_cursor->connectionHasPendingReplies()) {
             // Close the connection because the connection cannot be used anymore as more data is on
@@ -48,6 +48,43 @@ namespace repl {
 
 extern FailPoint stopReplProducer;
 
+/**
+ * Chooses how many documents the oplog fetcher requests per batch from the bandwidth-delay
+ * product of the link to the sync source.
+ *
+ * The shortest batch seen is taken as the round trip time. A batch that filled the requested
+ * batch size was limited by the link rather than by the sync source having nothing more to send,
+ * so the time it took beyond a round trip gives the bandwidth. The batch size is then chosen so
+ * that a batch takes kRoundTripsPerBatch round trips to transfer, which keeps the round trip
+ * between batches to a small fraction of the time spent fetching.
+ */
+class OplogFetcherBatchSizer {
+public:
+    static constexpr int kMinBatchSize = 16;
+    static constexpr int kRoundTripsPerBatch = 9;
+
+    /**
+     * The batch size starts at and never exceeds 'maxBatchSize'.
+     */
+    explicit OplogFetcherBatchSizer(int maxBatchSize);
+
+    int getBatchSize() const {
+        return _batchSize;
+    }
+
+    /**
+     * Records a batch of 'numDocs' documents totalling 'numBytes' that took 'elapsed' to fetch
+     * with the current batch size. Returns the batch size to request next. Empty batches and
+     * batches that took no measurable time leave the batch size unchanged.
+     */
+    int recordBatch(int numDocs, long long numBytes, Microseconds elapsed);
+
+private:
+    const int _maxBatchSize;
+    int _batchSize;
+    boost::optional<Microseconds> _minRoundTrip;
+};
+
 /**
  * The oplog fetcher, once started, reads operations from a remote oplog using a tailable,
  * awaitData, exhaust cursor.
@@ -297,6 +334,11 @@ private:
      */
     void _createNewCursor(bool initialFind);
 
+    /**
+     * Returns the number of documents to request per batch from the sync source.
+     */
+    int _getBatchSize() const;
+
     /**
      * This function will create the `find` query to issue to the sync source. It is provided with
      * whether this is the initial attempt to create the `find` query to determine what the find
@@ -402,6 +444,10 @@ private:
     const Milliseconds _awaitDataTimeout;
     const int _batchSize;
 
+    // Sizes the batches requested from the sync source when oplogFetcherAdaptiveBatchSize is set
+    // and oplogFetcherUsesExhaust is not.
+    OplogFetcherBatchSizer _batchSizer;
+
     // Indicates if we want to skip the first document during oplog fetching or not.
     StartingPoint _startingPoint;
 
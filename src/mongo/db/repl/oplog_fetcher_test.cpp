@@ -2144,4 +2144,67 @@ TEST_F(OplogFetcherTest, HandleLogicalTimeMetaDataAndAdvanceClusterTime) {
     ASSERT_EQ(currentClusterTime, logicalTime);
     ASSERT_NE(oldClusterTime, logicalTime);
 }
+
+TEST(OplogFetcherBatchSizerTest, BatchesSmallerThanRequestedDoNotChangeBatchSize) {
+    OplogFetcherBatchSizer sizer(1000);
+    ASSERT_EQ(1000, sizer.getBatchSize());
+
+    // The sync source had nothing more to send, however long the batch took.
+    ASSERT_EQ(1000, sizer.recordBatch(10, 1000, Milliseconds(20)));
+    ASSERT_EQ(1000, sizer.recordBatch(999, 99900, Milliseconds(5000)));
+    ASSERT_EQ(1000, sizer.recordBatch(0, 0, Milliseconds(1)));
+}
+
+TEST(OplogFetcherBatchSizerTest, BatchSizeConvergesOnBandwidthDelayProduct) {
+    OplogFetcherBatchSizer sizer(1000);
+
+    // A 20ms round trip.
+    ASSERT_EQ(1000, sizer.recordBatch(10, 1000, Milliseconds(20)));
+
+    // Full batches of 100 byte documents at 100 bytes/ms. The bandwidth-delay product is 2000
+    // bytes, so we aim for 9 * 2000 / 100 = 180 documents, halving at most once per batch.
+    ASSERT_EQ(500, sizer.recordBatch(1000, 100000, Milliseconds(1020)));
+    ASSERT_EQ(250, sizer.recordBatch(500, 50000, Milliseconds(520)));
+    ASSERT_EQ(180, sizer.recordBatch(250, 25000, Milliseconds(270)));
+    ASSERT_EQ(180, sizer.recordBatch(180, 18000, Milliseconds(200)));
+}
+
+TEST(OplogFetcherBatchSizerTest, BatchSizeGrowsUpToMaximumWhenLinkIsNotTheBottleneck) {
+    OplogFetcherBatchSizer sizer(1000);
+    ASSERT_EQ(1000, sizer.recordBatch(10, 1000, Milliseconds(20)));
+    ASSERT_EQ(500, sizer.recordBatch(1000, 100000, Milliseconds(1020)));
+
+    // Full batches arriving within a round trip double the batch size, up to the maximum.
+    ASSERT_EQ(1000, sizer.recordBatch(500, 50000, Milliseconds(20)));
+    ASSERT_EQ(1000, sizer.recordBatch(1000, 100000, Milliseconds(20)));
+}
+
+TEST(OplogFetcherBatchSizerTest, BatchesWithNoMeasurableTimeDoNotChangeBatchSize) {
+    OplogFetcherBatchSizer sizer(1000);
+
+    // A zero elapsed time is no signal, so it neither becomes the round trip time nor shrinks the
+    // batch size.
+    ASSERT_EQ(1000, sizer.recordBatch(1000, 100000, Microseconds(0)));
+    ASSERT_EQ(1000, sizer.recordBatch(10, 1000, Microseconds(0)));
+
+    ASSERT_EQ(1000, sizer.recordBatch(10, 1000, Milliseconds(20)));
+    ASSERT_EQ(1000, sizer.recordBatch(1000, 100000, Microseconds(0)));
+    ASSERT_EQ(500, sizer.recordBatch(1000, 100000, Milliseconds(1020)));
+}
+
+TEST(OplogFetcherBatchSizerTest, BatchSizeStaysWithinBounds) {
+    OplogFetcherBatchSizer sizer(64);
+    ASSERT_EQ(64, sizer.recordBatch(1, 100, Microseconds(10)));
+
+    // A 10us round trip on a slow link shrinks every full batch down to the minimum.
+    ASSERT_EQ(32, sizer.recordBatch(64, 6400, Milliseconds(10)));
+    ASSERT_EQ(OplogFetcherBatchSizer::kMinBatchSize, sizer.recordBatch(32, 3200, Milliseconds(10)));
+    ASSERT_EQ(OplogFetcherBatchSizer::kMinBatchSize, sizer.recordBatch(16, 1600, Milliseconds(10)));
+
+    // A maximum below the minimum wins.
+    OplogFetcherBatchSizer singleDocSizer(1);
+    ASSERT_EQ(1, singleDocSizer.recordBatch(1, 100, Microseconds(10)));
+    ASSERT_EQ(1, singleDocSizer.recordBatch(1, 100, Milliseconds(10)));
+}
+
 }  // namespace
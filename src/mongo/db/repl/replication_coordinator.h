@@ -397,6 +397,12 @@ public:
      */
     virtual OpTimeAndWallTime getMyLastAppliedOpTimeAndWallTime() const = 0;
 
+    /**
+     * Returns the earliest optime that operations are waiting for this node to apply, such as
+     * reads with 'afterClusterTime' on a secondary, or boost::none if nothing is waiting.
+     */
+    virtual boost::optional<OpTime> getEarliestOpTimeWaitingForLastApplied() const = 0;
+
     /**
      * Returns the last optime recorded by setMyLastDurableOpTime.
      */
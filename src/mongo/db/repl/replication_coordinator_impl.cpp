@@ -204,62 +204,6 @@ StatusOrStatusWith<T> futureGetNoThrowWithDeadline(OperationContext* opCtx,
 
 }  // namespace
 
-void ReplicationCoordinatorImpl::WaiterList::add_inlock(const OpTime& opTime,
-                                                        SharedWaiterHandle waiter) {
-    _waiters.emplace(opTime, std::move(waiter));
-}
-
-SharedSemiFuture<void> ReplicationCoordinatorImpl::WaiterList::add_inlock(
-    const OpTime& opTime, boost::optional<WriteConcernOptions> wc) {
-    auto pf = makePromiseFuture<void>();
-    _waiters.emplace(opTime, std::make_shared<Waiter>(std::move(pf.promise), std::move(wc)));
-    return std::move(pf.future);
-}
-
-bool ReplicationCoordinatorImpl::WaiterList::remove_inlock(SharedWaiterHandle waiter) {
-    for (auto iter = _waiters.begin(); iter != _waiters.end(); iter++) {
-        if (iter->second == waiter) {
-            _waiters.erase(iter);
-            return true;
-        }
-    }
-    return false;
-}
-
-template <typename Func>
-void ReplicationCoordinatorImpl::WaiterList::setValueIf_inlock(Func&& func,
-                                                               boost::optional<OpTime> opTime) {
-    for (auto it = _waiters.begin(); it != _waiters.end() && (!opTime || it->first <= *opTime);) {
-        const auto& waiter = it->second;
-        try {
-            if (func(it->first, waiter)) {
-                waiter->promise.emplaceValue();
-                it = _waiters.erase(it);
-            } else {
-                ++it;
-            }
-        } catch (const DBException& e) {
-            waiter->promise.setError(e.toStatus());
-            it = _waiters.erase(it);
-        }
-    }
-}
-
-void ReplicationCoordinatorImpl::WaiterList::setValueAll_inlock() {
-    for (auto& [opTime, waiter] : _waiters) {
-        waiter->promise.emplaceValue();
-    }
-    _waiters.clear();
-}
-
-void ReplicationCoordinatorImpl::WaiterList::setErrorAll_inlock(Status status) {
-    invariant(!status.isOK());
-    for (auto& [opTime, waiter] : _waiters) {
-        waiter->promise.setError(status);
-    }
-    _waiters.clear();
-}
-
 namespace {
 ReplicationCoordinator::Mode getReplicationModeFromSettings(const ReplSettings& settings) {
     if (settings.usingReplSets()) {
@@ -1309,7 +1253,7 @@ void ReplicationCoordinatorImpl::_setMyLastAppliedOpTimeAndWallTime(
     // waiting on our own lastApplied.
 
     // Signal anyone waiting on optime changes.
-    _opTimeWaiterList.setValueIf_inlock(
+    _opTimeWaiterList.setValueIfMonotonic_inlock(
         [opTime](const OpTime& waitOpTime, const SharedWaiterHandle& waiter) {
             return waitOpTime <= opTime;
         },
@@ -1370,6 +1314,12 @@ OpTime ReplicationCoordinatorImpl::getMyLastAppliedOpTime() const {
     return _getMyLastAppliedOpTime_inlock();
 }
 
+boost::optional<OpTime> ReplicationCoordinatorImpl::getEarliestOpTimeWaitingForLastApplied()
+    const {
+    stdx::lock_guard<Latch> lock(_mutex);
+    return _opTimeWaiterList.getEarliestOpTime_inlock();
+}
+
 OpTimeAndWallTime ReplicationCoordinatorImpl::getMyLastAppliedOpTimeAndWallTime() const {
     stdx::lock_guard<Latch> lock(_mutex);
     return _getMyLastAppliedOpTimeAndWallTime_inlock();
@@ -4065,7 +4015,9 @@ ReplicationCoordinatorImpl::_setCurrentRSConfig(WithLock lk,
 }
 
 void ReplicationCoordinatorImpl::_wakeReadyWaiters(WithLock lk, boost::optional<OpTime> opTime) {
-    _replicationWaiterList.setValueIf_inlock(
+    // Whether a write concern is satisfied only depends on how far replication has progressed, so
+    // once a waiter is not satisfied, neither is any later waiter with the same write concern.
+    _replicationWaiterList.setValueIfMonotonic_inlock(
         [this](const OpTime& opTime, const SharedWaiterHandle& waiter) {
             invariant(waiter->writeConcern);
             return _doneWaitingForReplication_inlock(opTime, waiter->writeConcern.get());
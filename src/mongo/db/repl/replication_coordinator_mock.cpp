@@ -251,6 +251,16 @@ OpTime ReplicationCoordinatorMock::getMyLastAppliedOpTime() const {
     return _myLastAppliedOpTime;
 }
 
+boost::optional<OpTime> ReplicationCoordinatorMock::getEarliestOpTimeWaitingForLastApplied()
+    const {
+    return _earliestOpTimeWaitingForLastApplied;
+}
+
+void ReplicationCoordinatorMock::setEarliestOpTimeWaitingForLastApplied(
+    boost::optional<OpTime> opTime) {
+    _earliestOpTimeWaitingForLastApplied = opTime;
+}
+
 OpTimeAndWallTime ReplicationCoordinatorMock::getMyLastDurableOpTimeAndWallTime() const {
     return {_myLastDurableOpTime, _myLastDurableWallTime};
 }
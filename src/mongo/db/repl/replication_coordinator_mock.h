@@ -143,6 +143,7 @@ public:
 
     virtual OpTimeAndWallTime getMyLastAppliedOpTimeAndWallTime() const;
     virtual OpTime getMyLastAppliedOpTime() const;
+    virtual boost::optional<OpTime> getEarliestOpTimeWaitingForLastApplied() const;
 
     virtual OpTimeAndWallTime getMyLastDurableOpTimeAndWallTime() const;
     virtual OpTime getMyLastDurableOpTime() const;
@@ -286,6 +287,11 @@ public:
      */
     void setGetConfigReturnValue(ReplSetConfig returnValue);
 
+    /**
+     * Sets the return value for calls to getEarliestOpTimeWaitingForLastApplied.
+     */
+    void setEarliestOpTimeWaitingForLastApplied(boost::optional<OpTime> opTime);
+
     /**
      * Sets the function to generate the return value for calls to awaitReplication().
      * 'OperationContext' and 'opTime' are the parameters passed to awaitReplication().
@@ -360,6 +366,7 @@ private:
     OpTime _myLastAppliedOpTime;
     Date_t _myLastAppliedWallTime;
     ReplSetConfig _getConfigReturnValue;
+    boost::optional<OpTime> _earliestOpTimeWaitingForLastApplied;
     AwaitReplicationReturnValueFunction _awaitReplicationReturnValueFunction = [](OperationContext*,
                                                                                   const OpTime&) {
         return StatusAndDuration(Status::OK(), Milliseconds(0));
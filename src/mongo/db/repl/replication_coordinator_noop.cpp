@@ -61,6 +61,11 @@ OpTime ReplicationCoordinatorNoOp::getMyLastAppliedOpTime() const {
     return OpTime{};
 }
 
+boost::optional<OpTime> ReplicationCoordinatorNoOp::getEarliestOpTimeWaitingForLastApplied()
+    const {
+    return boost::none;
+}
+
 const ReplSettings& ReplicationCoordinatorNoOp::getSettings() const {
     MONGO_UNREACHABLE;
 }
@@ -124,6 +124,7 @@ public:
     void setMyHeartbeatMessage(const std::string&) final;
 
     OpTime getMyLastAppliedOpTime() const final;
+    boost::optional<OpTime> getEarliestOpTimeWaitingForLastApplied() const final;
     OpTimeAndWallTime getMyLastAppliedOpTimeAndWallTime() const final;
 
     OpTime getMyLastDurableOpTime() const final;
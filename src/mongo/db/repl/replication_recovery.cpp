@@ -43,6 +43,7 @@
 #include "mongo/db/repl/apply_ops.h"
 #include "mongo/db/repl/oplog_applier_impl.h"
 #include "mongo/db/repl/oplog_buffer.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/replication_consistency_markers_impl.h"
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/db/repl/transaction_oplog_application.h"
@@ -69,6 +70,9 @@ const auto kRecoveryOperationLogLevelV2 = logv2::LogSeverity::Debug(3);
  */
 class RecoveryOplogApplierStats : public OplogApplier::Observer {
 public:
+    RecoveryOplogApplierStats(Timestamp startPoint, Timestamp endPoint)
+        : _startPoint(startPoint), _endPoint(endPoint) {}
+
     void onBatchBegin(const std::vector<OplogEntry>& batch) final {
         _numBatches++;
         LOGV2_FOR_RECOVERY(24098,
@@ -101,7 +105,16 @@ public:
         }
     }
 
-    void onBatchEnd(const StatusWith<OpTime>&, const std::vector<OplogEntry>&) final {}
+    void onBatchEnd(const StatusWith<OpTime>& lastOpTimeApplied,
+                    const std::vector<OplogEntry>&) final {
+        const auto intervalSecs = replRecoveryProgressLogIntervalSecs.load();
+        if (!lastOpTimeApplied.isOK() || intervalSecs <= 0 ||
+            _sinceLastProgressLog.seconds() < intervalSecs) {
+            return;
+        }
+        _sinceLastProgressLog.reset();
+        _logProgress(lastOpTimeApplied.getValue().getTimestamp());
+    }
 
     void complete(const OpTime& applyThroughOpTime) const {
         LOGV2(21536,
@@ -109,12 +122,45 @@ public:
               "with optime: {applyThroughOpTime}",
               "numOpsApplied"_attr = _numOpsApplied,
               "numBatches"_attr = _numBatches,
-              "applyThroughOpTime"_attr = applyThroughOpTime);
+              "applyThroughOpTime"_attr = applyThroughOpTime,
+              "durationMillis"_attr = _elapsed.millis());
     }
 
 private:
+    /**
+     * Logs how far replay has progressed towards the end point. The remaining time is estimated
+     * from the fraction of the oplog's wall clock range covered so far, which assumes a roughly
+     * even write rate over that range.
+     */
+    void _logProgress(const Timestamp& appliedThrough) const {
+        const auto elapsedMillis = _elapsed.millis();
+        const auto totalSecs = static_cast<double>(_endPoint.getSecs()) - _startPoint.getSecs();
+        const auto doneSecs = static_cast<double>(appliedThrough.getSecs()) - _startPoint.getSecs();
+
+        BSONObjBuilder estimate;
+        if (totalSecs > 0 && doneSecs > 0) {
+            const double fraction = std::min(1.0, doneSecs / totalSecs);
+            estimate.append("percentComplete", static_cast<int>(fraction * 100));
+            estimate.append("remainingMillisEstimate",
+                            static_cast<long long>(elapsedMillis * (1 - fraction) / fraction));
+        }
+
+        LOGV2(4938200,
+              "Replaying oplog for recovery",
+              "numOpsApplied"_attr = _numOpsApplied,
+              "numBatches"_attr = _numBatches,
+              "appliedThrough"_attr = appliedThrough,
+              "endPoint"_attr = _endPoint,
+              "elapsedMillis"_attr = elapsedMillis,
+              "estimate"_attr = estimate.obj());
+    }
+
+    const Timestamp _startPoint;
+    const Timestamp _endPoint;
     std::size_t _numBatches = 0;
     std::size_t _numOpsApplied = 0;
+    Timer _elapsed;
+    Timer _sinceLastProgressLog;
 };
 
 /**
@@ -580,9 +626,11 @@ Timestamp ReplicationRecoveryImpl::_applyOplogOperations(OperationContext* opCtx
     OplogBufferLocalOplog oplogBuffer(startPoint, endPoint);
     oplogBuffer.startup(opCtx);
 
-    RecoveryOplogApplierStats stats;
+    RecoveryOplogApplierStats stats(startPoint, endPoint);
 
-    auto writerPool = makeReplWriterPool();
+    const auto recoveryWriterThreadCount = replRecoveryWriterThreadCount;
+    auto writerPool = recoveryWriterThreadCount > 0 ? makeReplWriterPool(recoveryWriterThreadCount)
+                                                    : makeReplWriterPool();
     OplogApplierImpl oplogApplier(nullptr,
                                   &oplogBuffer,
                                   &stats,
@@ -43,6 +43,7 @@
 #include "mongo/db/repl/oplog_applier_impl_test_fixture.h"
 #include "mongo/db/repl/oplog_entry.h"
 #include "mongo/db/repl/oplog_interface_local.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/replication_consistency_markers_mock.h"
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/db/repl/replication_recovery.h"
@@ -56,6 +57,7 @@
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
 namespace {
@@ -660,6 +662,15 @@ TEST_F(ReplicationRecoveryTest,
     testRecoveryAppliesDocumentsWhenAppliedThroughIsBehind(hasStableTimestamp, hasStableCheckpoint);
 }
 
+TEST_F(ReplicationRecoveryTest, RecoveryAppliesDocumentsWithRecoveryWriterThreadCount) {
+    const auto originalThreadCount = replRecoveryWriterThreadCount;
+    ON_BLOCK_EXIT([&] { replRecoveryWriterThreadCount = originalThreadCount; });
+    replRecoveryWriterThreadCount = 2;
+    bool hasStableTimestamp = false;
+    bool hasStableCheckpoint = true;
+    testRecoveryAppliesDocumentsWhenAppliedThroughIsBehind(hasStableTimestamp, hasStableCheckpoint);
+}
+
 void ReplicationRecoveryTest::testRecoveryToStableAppliesDocumentsWithNoAppliedThrough(
     bool hasStableTimestamp) {
     ReplicationRecoveryImpl recovery(getStorageInterface(), getConsistencyMarkers());
@@ -0,0 +1,118 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/replication_waiter_list.h"
+
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace repl {
+
+std::string ReplicationWaiterList::_shardKey(
+    const boost::optional<WriteConcernOptions>& writeConcern) {
+    if (!writeConcern) {
+        return std::string();
+    }
+    return str::stream() << writeConcern->wMode << '|' << writeConcern->wNumNodes << '|'
+                         << static_cast<int>(writeConcern->syncMode) << '|'
+                         << static_cast<int>(writeConcern->checkCondition);
+}
+
+void ReplicationWaiterList::add_inlock(const OpTime& opTime, SharedWaiterHandle waiter) {
+    waiter->opTime = opTime;
+    _waiters[_shardKey(waiter->writeConcern)].emplace(opTime, std::move(waiter));
+    ++_numWaiters;
+}
+
+SharedSemiFuture<void> ReplicationWaiterList::add_inlock(const OpTime& opTime,
+                                                         boost::optional<WriteConcernOptions> wc) {
+    auto pf = makePromiseFuture<void>();
+    add_inlock(opTime, std::make_shared<ReplicationWaiter>(std::move(pf.promise), std::move(wc)));
+    return std::move(pf.future);
+}
+
+bool ReplicationWaiterList::remove_inlock(SharedWaiterHandle waiter) {
+    auto shardIt = _waiters.find(_shardKey(waiter->writeConcern));
+    if (shardIt == _waiters.end()) {
+        return false;
+    }
+
+    auto& waiters = shardIt->second;
+    auto [begin, end] = waiters.equal_range(waiter->opTime);
+    for (auto iter = begin; iter != end; iter++) {
+        if (iter->second == waiter) {
+            waiters.erase(iter);
+            --_numWaiters;
+            if (waiters.empty()) {
+                _waiters.erase(shardIt);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void ReplicationWaiterList::setValueAll_inlock() {
+    for (auto& [key, waiters] : _waiters) {
+        for (auto& [opTime, waiter] : waiters) {
+            waiter->promise.emplaceValue();
+        }
+    }
+    _waiters.clear();
+    _numWaiters = 0;
+}
+
+boost::optional<OpTime> ReplicationWaiterList::getEarliestOpTime_inlock() const {
+    boost::optional<OpTime> earliest;
+    for (const auto& [key, waiters] : _waiters) {
+        // Empty shards are removed, so every shard has a first waiter.
+        const auto& opTime = waiters.begin()->first;
+        if (!earliest || opTime < *earliest) {
+            earliest = opTime;
+        }
+    }
+    return earliest;
+}
+
+void ReplicationWaiterList::setErrorAll_inlock(Status status) {
+    invariant(!status.isOK());
+    for (auto& [key, waiters] : _waiters) {
+        for (auto& [opTime, waiter] : waiters) {
+            waiter->promise.setError(status);
+        }
+    }
+    _waiters.clear();
+    _numWaiters = 0;
+}
+
+}  // namespace repl
+}  // namespace mongo
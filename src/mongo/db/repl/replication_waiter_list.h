@@ -0,0 +1,155 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "mongo/base/status.h"
+#include "mongo/db/repl/optime.h"
+#include "mongo/db/write_concern_options.h"
+#include "mongo/util/future.h"
+
+namespace mongo {
+namespace repl {
+
+struct ReplicationWaiter {
+    Promise<void> promise;
+    boost::optional<WriteConcernOptions> writeConcern;
+    // The OpTime this waiter was added to a ReplicationWaiterList with.
+    OpTime opTime;
+    explicit ReplicationWaiter(Promise<void> p,
+                               boost::optional<WriteConcernOptions> w = boost::none)
+        : promise(std::move(p)), writeConcern(w) {}
+};
+
+/**
+ * Waiters for replication progress, sorted by the OpTime they wait for.
+ *
+ * Waiters are sharded by write concern, so that a wake-up for a condition that is monotonic in the
+ * OpTime can stop at the first waiter of each shard that is not yet satisfied instead of visiting
+ * every waiter. Waiters without a write concern share a single shard.
+ *
+ * All functions must be called while holding the lock of the owner of the list.
+ */
+class ReplicationWaiterList {
+public:
+    using SharedWaiterHandle = std::shared_ptr<ReplicationWaiter>;
+
+    // Adds waiter into the list.
+    void add_inlock(const OpTime& opTime, SharedWaiterHandle waiter);
+    // Adds a waiter into the list and returns the future of the waiter's promise.
+    SharedSemiFuture<void> add_inlock(const OpTime& opTime,
+                                      boost::optional<WriteConcernOptions> w = boost::none);
+    // Returns whether waiter is found and removed.
+    bool remove_inlock(SharedWaiterHandle waiter);
+    // Signals all waiters whose opTime is <= the given opTime (if any) that satisfy the
+    // condition in func.
+    template <typename Func>
+    void setValueIf_inlock(Func&& func, boost::optional<OpTime> opTime = boost::none);
+    // Like setValueIf_inlock, but 'func' must be monotonic: if it returns false for a waiter, it
+    // must also return false for every waiter with the same write concern and a later OpTime. Only
+    // the satisfied waiters and the first unsatisfied waiter of each write concern are visited.
+    template <typename Func>
+    void setValueIfMonotonic_inlock(Func&& func, boost::optional<OpTime> opTime = boost::none);
+    // Signals all waiters from the list and fulfills promises with OK status.
+    void setValueAll_inlock();
+    // Signals all waiters from the list and fulfills promises with Error status.
+    void setErrorAll_inlock(Status status);
+    // Returns the number of waiters in the list.
+    size_t size_inlock() const {
+        return _numWaiters;
+    }
+    // Returns the earliest OpTime waited on, if there are any waiters.
+    boost::optional<OpTime> getEarliestOpTime_inlock() const;
+
+private:
+    using WaiterMap = std::multimap<OpTime, SharedWaiterHandle>;
+
+    // Returns the shard for waiters with the given write concern. Write concerns that only differ
+    // in their timeout share a shard.
+    static std::string _shardKey(const boost::optional<WriteConcernOptions>& writeConcern);
+
+    template <typename Func>
+    void _setValueIf(Func&& func, const boost::optional<OpTime>& opTime, bool monotonic);
+
+    // Waiters sorted by OpTime, sharded by write concern. Empty shards are removed.
+    std::map<std::string, WaiterMap> _waiters;
+    size_t _numWaiters = 0;
+};
+
+template <typename Func>
+void ReplicationWaiterList::setValueIf_inlock(Func&& func, boost::optional<OpTime> opTime) {
+    _setValueIf(std::forward<Func>(func), opTime, false /* monotonic */);
+}
+
+template <typename Func>
+void ReplicationWaiterList::setValueIfMonotonic_inlock(Func&& func,
+                                                       boost::optional<OpTime> opTime) {
+    _setValueIf(std::forward<Func>(func), opTime, true /* monotonic */);
+}
+
+template <typename Func>
+void ReplicationWaiterList::_setValueIf(Func&& func,
+                                        const boost::optional<OpTime>& opTime,
+                                        bool monotonic) {
+    for (auto shardIt = _waiters.begin(); shardIt != _waiters.end();) {
+        auto& waiters = shardIt->second;
+        for (auto it = waiters.begin(); it != waiters.end() && (!opTime || it->first <= *opTime);) {
+            const auto& waiter = it->second;
+            try {
+                if (func(it->first, waiter)) {
+                    waiter->promise.emplaceValue();
+                    it = waiters.erase(it);
+                    --_numWaiters;
+                } else if (monotonic) {
+                    break;
+                } else {
+                    ++it;
+                }
+            } catch (const DBException& e) {
+                waiter->promise.setError(e.toStatus());
+                it = waiters.erase(it);
+                --_numWaiters;
+            }
+        }
+
+        if (waiters.empty()) {
+            _waiters.erase(shardIt++);
+        } else {
+            ++shardIt;
+        }
+    }
+}
+
+}  // namespace repl
+}  // namespace mongo
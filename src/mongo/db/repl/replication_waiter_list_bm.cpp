@@ -0,0 +1,122 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/repl/replication_waiter_list.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+const WriteConcernOptions kMajority(
+    WriteConcernOptions::kMajority, WriteConcernOptions::SyncMode::JOURNAL, Milliseconds(0));
+const WriteConcernOptions kTwoNodes(2, WriteConcernOptions::SyncMode::NONE, Milliseconds(0));
+
+OpTime makeOpTime(int64_t i) {
+    return OpTime(Timestamp(i / 1000 + 1, i % 1000), 1);
+}
+
+/**
+ * Fills a list with 'numWaiters' waiters, alternating between two write concerns, and returns the
+ * futures of the waiters.
+ */
+std::vector<SharedSemiFuture<void>> fill(ReplicationWaiterList* list, int64_t numWaiters) {
+    std::vector<SharedSemiFuture<void>> futures;
+    futures.reserve(numWaiters);
+    for (int64_t i = 0; i < numWaiters; i++) {
+        futures.push_back(list->add_inlock(makeOpTime(i), (i % 2) ? kMajority : kTwoNodes));
+    }
+    return futures;
+}
+
+// Adds 'state.range(0)' waiters and wakes them all.
+void BM_AddAndWakeAll(benchmark::State& state) {
+    const int64_t numWaiters = state.range(0);
+    for (auto _ : state) {
+        ReplicationWaiterList list;
+        auto futures = fill(&list, numWaiters);
+        list.setValueIfMonotonic_inlock([](const OpTime&, const auto&) { return true; });
+        benchmark::DoNotOptimize(futures);
+    }
+    state.SetItemsProcessed(state.iterations() * numWaiters);
+}
+
+// With 'state.range(0)' waiters outstanding, each progress notification satisfies the oldest
+// waiter and a new waiter arrives, as with a steady stream of majority writes. The second argument
+// selects whether the wake-up may stop at the first unsatisfied waiter of each write concern.
+void BM_WakeOldestOfMany(benchmark::State& state) {
+    const int64_t numWaiters = state.range(0);
+    const bool monotonic = state.range(1);
+
+    ReplicationWaiterList list;
+    auto futures = fill(&list, numWaiters);
+    int64_t committed = -1;
+    int64_t next = numWaiters;
+    for (auto _ : state) {
+        ++committed;
+        auto isSatisfied = [&](const OpTime& opTime, const auto&) {
+            return opTime <= makeOpTime(committed);
+        };
+        if (monotonic) {
+            list.setValueIfMonotonic_inlock(isSatisfied);
+        } else {
+            list.setValueIf_inlock(isSatisfied);
+        }
+        benchmark::DoNotOptimize(list.add_inlock(makeOpTime(next++), kMajority));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Removes and re-adds a waiter in the middle of 'state.range(0)' waiters, as happens when a
+// write concern wait times out.
+void BM_RemoveOneOfMany(benchmark::State& state) {
+    const int64_t numWaiters = state.range(0);
+
+    ReplicationWaiterList list;
+    auto futures = fill(&list, numWaiters);
+    auto pf = makePromiseFuture<void>();
+    auto waiter = std::make_shared<ReplicationWaiter>(std::move(pf.promise), kMajority);
+    for (auto _ : state) {
+        list.add_inlock(makeOpTime(numWaiters / 2), waiter);
+        benchmark::DoNotOptimize(list.remove_inlock(waiter));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_AddAndWakeAll)->Arg(1000)->Arg(20000);
+BENCHMARK(BM_WakeOldestOfMany)->Args({1000, 0})->Args({1000, 1})->Args({20000, 0})->Args({20000, 1});
+BENCHMARK(BM_RemoveOneOfMany)->Arg(1000)->Arg(20000);
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
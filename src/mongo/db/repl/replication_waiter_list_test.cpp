@@ -0,0 +1,150 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+
+#include "mongo/db/repl/replication_waiter_list.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+const WriteConcernOptions kMajority(
+    WriteConcernOptions::kMajority, WriteConcernOptions::SyncMode::JOURNAL, Milliseconds(0));
+const WriteConcernOptions kTwoNodes(2, WriteConcernOptions::SyncMode::NONE, Milliseconds(0));
+
+OpTime makeOpTime(int secs) {
+    return OpTime(Timestamp(secs, 1), 1);
+}
+
+TEST(ReplicationWaiterListTest, MonotonicWakeStopsAtFirstUnsatisfiedWaiterOfEachWriteConcern) {
+    ReplicationWaiterList list;
+    auto majority1 = list.add_inlock(makeOpTime(1), kMajority);
+    auto majority2 = list.add_inlock(makeOpTime(2), kMajority);
+    auto majority3 = list.add_inlock(makeOpTime(3), kMajority);
+    auto majority4 = list.add_inlock(makeOpTime(4), kMajority);
+    auto twoNodes1 = list.add_inlock(makeOpTime(1), kTwoNodes);
+    auto twoNodes3 = list.add_inlock(makeOpTime(3), kTwoNodes);
+    ASSERT_EQ(6U, list.size_inlock());
+
+    // Majority is at 2, two nodes are at 1.
+    std::vector<OpTime> visited;
+    list.setValueIfMonotonic_inlock([&](const OpTime& opTime, const auto& waiter) {
+        visited.push_back(opTime);
+        const auto& wc = *waiter->writeConcern;
+        return opTime <= makeOpTime(wc.wMode == WriteConcernOptions::kMajority ? 2 : 1);
+    });
+
+    ASSERT_TRUE(majority1.isReady());
+    ASSERT_TRUE(majority2.isReady());
+    ASSERT_FALSE(majority3.isReady());
+    ASSERT_FALSE(majority4.isReady());
+    ASSERT_TRUE(twoNodes1.isReady());
+    ASSERT_FALSE(twoNodes3.isReady());
+    ASSERT_EQ(3U, list.size_inlock());
+
+    // Each write concern was visited up to and including its first unsatisfied waiter. The
+    // majority waiter after the first unsatisfied one was never visited.
+    ASSERT_EQ(5U, visited.size());
+    ASSERT(std::find(visited.begin(), visited.end(), makeOpTime(4)) == visited.end());
+}
+
+TEST(ReplicationWaiterListTest, WakeOnlyVisitsWaitersUpToOpTime) {
+    ReplicationWaiterList list;
+    auto waiter1 = list.add_inlock(makeOpTime(1));
+    auto waiter2 = list.add_inlock(makeOpTime(2));
+
+    int visited = 0;
+    list.setValueIf_inlock(
+        [&](const OpTime&, const auto&) {
+            visited++;
+            return true;
+        },
+        makeOpTime(1));
+
+    ASSERT_EQ(1, visited);
+    ASSERT_TRUE(waiter1.isReady());
+    ASSERT_FALSE(waiter2.isReady());
+    ASSERT_EQ(1U, list.size_inlock());
+}
+
+TEST(ReplicationWaiterListTest, ExceptionFromConditionFailsOnlyThatWaiter) {
+    ReplicationWaiterList list;
+    auto waiter1 = list.add_inlock(makeOpTime(1), kMajority);
+    auto waiter2 = list.add_inlock(makeOpTime(2), kMajority);
+
+    list.setValueIfMonotonic_inlock([&](const OpTime& opTime, const auto&) {
+        uassert(ErrorCodes::UnknownReplWriteConcern, "no such mode", opTime != makeOpTime(1));
+        return true;
+    });
+
+    ASSERT_EQ(ErrorCodes::UnknownReplWriteConcern, waiter1.getNoThrow());
+    ASSERT_OK(waiter2.getNoThrow());
+    ASSERT_EQ(0U, list.size_inlock());
+}
+
+TEST(ReplicationWaiterListTest, RemoveFindsWaiterByOpTimeAndWriteConcern) {
+    ReplicationWaiterList list;
+    auto other = list.add_inlock(makeOpTime(1), kMajority);
+
+    auto pf = makePromiseFuture<void>();
+    auto waiter = std::make_shared<ReplicationWaiter>(std::move(pf.promise), kMajority);
+    list.add_inlock(makeOpTime(1), waiter);
+    ASSERT_EQ(2U, list.size_inlock());
+
+    ASSERT_TRUE(list.remove_inlock(waiter));
+    ASSERT_FALSE(list.remove_inlock(waiter));
+    ASSERT_EQ(1U, list.size_inlock());
+
+    list.setErrorAll_inlock({ErrorCodes::ShutdownInProgress, "shutting down"});
+    ASSERT_EQ(ErrorCodes::ShutdownInProgress, other.getNoThrow());
+    ASSERT_FALSE(pf.future.isReady());
+    ASSERT_EQ(0U, list.size_inlock());
+}
+
+TEST(ReplicationWaiterListTest, EarliestOpTimeSpansWriteConcerns) {
+    ReplicationWaiterList list;
+    ASSERT_FALSE(list.getEarliestOpTime_inlock());
+
+    auto majority3 = list.add_inlock(makeOpTime(3), kMajority);
+    auto twoNodes2 = list.add_inlock(makeOpTime(2), kTwoNodes);
+    auto noWriteConcern4 = list.add_inlock(makeOpTime(4));
+    ASSERT_EQ(makeOpTime(2), *list.getEarliestOpTime_inlock());
+
+    list.setValueIf_inlock([](const OpTime&, const auto&) { return true; }, makeOpTime(2));
+    ASSERT_EQ(makeOpTime(3), *list.getEarliestOpTime_inlock());
+}
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
@@ -404,7 +404,8 @@ void Balancer::_mainThread() {
                 }
 
                 const auto candidateChunks =
-                    uassertStatusOK(_chunkSelectionPolicy->selectChunksToMove(opCtx.get()));
+                    uassertStatusOK(_chunkSelectionPolicy->selectChunksToMove(
+                        opCtx.get(), _migrationManager.getThrottledShards()));
 
                 if (candidateChunks.empty()) {
                     LOGV2_DEBUG(21862, 1, "no need to move any chunk");
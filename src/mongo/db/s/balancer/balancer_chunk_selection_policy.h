@@ -30,6 +30,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <set>
 #include <vector>
 
 #include "mongo/db/s/balancer/balancer_policy.h"
@@ -98,9 +99,11 @@ public:
                                                             const NamespaceString& nss) = 0;
 
     /**
-     * Potentially blocking method, which gives out a set of chunks to be moved.
+     * Potentially blocking method, which gives out a set of chunks to be moved. None of the
+     * returned migrations has any of the 'unavailableShards' as its donor or recipient.
      */
-    virtual StatusWith<MigrateInfoVector> selectChunksToMove(OperationContext* opCtx) = 0;
+    virtual StatusWith<MigrateInfoVector> selectChunksToMove(
+        OperationContext* opCtx, const std::set<ShardId>& unavailableShards) = 0;
 
     /**
      * Given a valid namespace returns all the Migrations the balancer would need to perform
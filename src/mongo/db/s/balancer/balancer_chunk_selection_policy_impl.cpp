@@ -34,11 +34,13 @@
 #include "mongo/db/s/balancer/balancer_chunk_selection_policy_impl.h"
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <vector>
 
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj_comparator_interface.h"
+#include "mongo/db/s/balancer/balancer_params_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/s/balancer_configuration.h"
 #include "mongo/s/catalog/type_chunk.h"
@@ -249,7 +251,7 @@ StatusWith<SplitInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToSpli
 }
 
 StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMove(
-    OperationContext* opCtx) {
+    OperationContext* opCtx, const std::set<ShardId>& unavailableShards) {
     auto shardStatsStatus = _clusterStats->getStats(opCtx);
     if (!shardStatsStatus.isOK()) {
         return shardStatsStatus.getStatus();
@@ -274,7 +276,10 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
     }
 
     MigrateInfoVector candidateChunks;
-    std::set<ShardId> usedShards;
+
+    // Number of migrations selected so far for each shard, as either donor or recipient
+    std::map<ShardId, int> migrationsPerShard;
+    const int maxMigrationsPerShard = balancerMaxMigrationsPerShard.load();
 
     std::shuffle(collections.begin(), collections.end(), _random);
 
@@ -291,6 +296,15 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
             continue;
         }
 
+        // A collection never gets more than one migration per shard in a round, because its
+        // distribution is not updated with the migrations already selected for it
+        std::set<ShardId> usedShards(unavailableShards);
+        for (const auto& shardMigrations : migrationsPerShard) {
+            if (shardMigrations.second >= maxMigrationsPerShard) {
+                usedShards.insert(shardMigrations.first);
+            }
+        }
+
         auto candidatesStatus =
             _getMigrateCandidatesForCollection(opCtx, nss, shardStats, &usedShards);
         if (candidatesStatus == ErrorCodes::NamespaceNotFound) {
@@ -306,6 +320,11 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
             continue;
         }
 
+        for (const auto& migrateInfo : candidatesStatus.getValue()) {
+            ++migrationsPerShard[migrateInfo.from];
+            ++migrationsPerShard[migrateInfo.to];
+        }
+
         candidateChunks.insert(candidateChunks.end(),
                                std::make_move_iterator(candidatesStatus.getValue().begin()),
                                std::make_move_iterator(candidatesStatus.getValue().end()));
@@ -46,7 +46,8 @@ public:
     StatusWith<SplitInfoVector> selectChunksToSplit(OperationContext* opCtx,
                                                     const NamespaceString& ns) override;
 
-    StatusWith<MigrateInfoVector> selectChunksToMove(OperationContext* opCtx) override;
+    StatusWith<MigrateInfoVector> selectChunksToMove(
+        OperationContext* opCtx, const std::set<ShardId>& unavailableShards) override;
 
     StatusWith<MigrateInfoVector> selectChunksToMove(OperationContext* opCtx,
                                                      const NamespaceString& ns) override;
@@ -196,8 +196,8 @@ TEST_F(BalancerChunkSelectionTest, TagRangeMaxNotAlignedWithChunkMax) {
             shardTargeterMock(operationContext(), kShardId0)->setFindHostReturnValue(kShardHost0);
             shardTargeterMock(operationContext(), kShardId1)->setFindHostReturnValue(kShardHost1);
 
-            auto candidateChunksStatus =
-                _chunkSelectionPolicy.get()->selectChunksToMove(operationContext());
+            auto candidateChunksStatus = _chunkSelectionPolicy.get()->selectChunksToMove(
+                operationContext(), std::set<ShardId>());
             ASSERT_OK(candidateChunksStatus.getStatus());
 
             // The balancer does not bubble up the IllegalOperation error, but it is expected
@@ -41,6 +41,7 @@
 #include "mongo/db/client.h"
 #include "mongo/db/repl/repl_set_config.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/s/balancer/balancer_params_gen.h"
 #include "mongo/db/s/balancer/scoped_migration_request.h"
 #include "mongo/db/s/balancer/type_migration.h"
 #include "mongo/executor/task_executor_pool.h"
@@ -123,39 +124,109 @@ MigrationStatuses MigrationManager::executeMigrationsForAutoBalance(
 
     {
         std::map<MigrationIdentifier, ScopedMigrationRequest> scopedMigrationRequests;
-        vector<std::pair<shared_ptr<Notification<RemoteCommandResponse>>, MigrateInfo>> responses;
-
-        for (const auto& migrateInfo : migrateInfos) {
-            // Write a document to the config.migrations collection, in case this migration must be
-            // recovered by the Balancer. Fail if the chunk is already moving.
-            auto statusWithScopedMigrationRequest =
-                ScopedMigrationRequest::writeMigration(opCtx, migrateInfo, waitForDelete);
-            if (!statusWithScopedMigrationRequest.isOK()) {
-                migrationStatuses.emplace(migrateInfo.getName(),
-                                          std::move(statusWithScopedMigrationRequest.getStatus()));
-                continue;
-            }
-            scopedMigrationRequests.emplace(migrateInfo.getName(),
-                                            std::move(statusWithScopedMigrationRequest.getValue()));
 
-            responses.emplace_back(
-                _schedule(opCtx, migrateInfo, maxChunkSizeBytes, secondaryThrottle, waitForDelete),
-                migrateInfo);
-        }
+        struct ScheduledMigration {
+            shared_ptr<Notification<RemoteCommandResponse>> notification;
+            MigrateInfo migrateInfo;
+            Date_t startTime;
+        };
+        std::list<ScheduledMigration> scheduledMigrations;
+
+        // A shard can only take part in one migration at a time, so migrations for shards, which
+        // are busy with an earlier migration, wait here until that migration completes.
+        std::list<MigrateInfo> pendingMigrations(migrateInfos.begin(), migrateInfos.end());
+        std::set<ShardId> busyShards;
+
+        auto scheduleReadyMigrations = [&] {
+            const auto throttledShards = getThrottledShards();
+
+            for (auto it = pendingMigrations.begin(); it != pendingMigrations.end();) {
+                const auto& migrateInfo = *it;
+                if (busyShards.count(migrateInfo.from) || busyShards.count(migrateInfo.to)) {
+                    ++it;
+                    continue;
+                }
+
+                if (throttledShards.count(migrateInfo.from) ||
+                    throttledShards.count(migrateInfo.to)) {
+                    migrationStatuses.emplace(
+                        migrateInfo.getName(),
+                        Status(ErrorCodes::OperationFailed,
+                               stream() << "Migration not started because shard "
+                                        << (throttledShards.count(migrateInfo.from)
+                                                ? migrateInfo.from
+                                                : migrateInfo.to)
+                                        << " is being throttled by the balancer"));
+                    it = pendingMigrations.erase(it);
+                    continue;
+                }
+
+                // Write a document to the config.migrations collection, in case this migration
+                // must be recovered by the Balancer. Fail if the chunk is already moving.
+                auto statusWithScopedMigrationRequest =
+                    ScopedMigrationRequest::writeMigration(opCtx, migrateInfo, waitForDelete);
+                if (!statusWithScopedMigrationRequest.isOK()) {
+                    migrationStatuses.emplace(
+                        migrateInfo.getName(),
+                        std::move(statusWithScopedMigrationRequest.getStatus()));
+                    it = pendingMigrations.erase(it);
+                    continue;
+                }
+                scopedMigrationRequests.emplace(
+                    migrateInfo.getName(), std::move(statusWithScopedMigrationRequest.getValue()));
+
+                busyShards.insert(migrateInfo.from);
+                busyShards.insert(migrateInfo.to);
+
+                scheduledMigrations.push_back(
+                    {_schedule(
+                         opCtx, migrateInfo, maxChunkSizeBytes, secondaryThrottle, waitForDelete),
+                     migrateInfo,
+                     _serviceContext->getFastClockSource()->now()});
+                it = pendingMigrations.erase(it);
+            }
+        };
+
+        scheduleReadyMigrations();
+
+        // Wait for the scheduled migrations to complete, in whatever order they do so, and start
+        // the pending ones as their shards become available.
+        while (!scheduledMigrations.empty()) {
+            auto itCompleted = scheduledMigrations.end();
+            {
+                stdx::unique_lock<Latch> lock(_mutex);
+                _migrationCompletedCondVar.wait(lock, [&] {
+                    itCompleted = std::find_if(scheduledMigrations.begin(),
+                                               scheduledMigrations.end(),
+                                               [](const ScheduledMigration& scheduledMigration) {
+                                                   return bool(*scheduledMigration.notification);
+                                               });
+                    return itCompleted != scheduledMigrations.end();
+                });
+            }
 
-        // Wait for all the scheduled migrations to complete.
-        for (auto& response : responses) {
-            auto notification = std::move(response.first);
-            auto migrateInfo = std::move(response.second);
+            const auto& migrateInfo = itCompleted->migrateInfo;
+            const auto& remoteCommandResponse = itCompleted->notification->get();
 
-            const auto& remoteCommandResponse = notification->get();
+            _recordMigrationOutcome(migrateInfo,
+                                    remoteCommandResponse,
+                                    _serviceContext->getFastClockSource()->now() -
+                                        itCompleted->startTime);
 
             auto it = scopedMigrationRequests.find(migrateInfo.getName());
             invariant(it != scopedMigrationRequests.end());
             Status commandStatus =
                 _processRemoteCommandResponse(remoteCommandResponse, &it->second);
             migrationStatuses.emplace(migrateInfo.getName(), std::move(commandStatus));
+
+            busyShards.erase(migrateInfo.from);
+            busyShards.erase(migrateInfo.to);
+            scheduledMigrations.erase(itCompleted);
+
+            scheduleReadyMigrations();
         }
+
+        invariant(pendingMigrations.empty());
     }
 
     invariant(migrationStatuses.size() == migrateInfos.size());
@@ -571,6 +642,7 @@ void MigrationManager::_complete(WithLock lock,
     }
 
     notificationToSignal->set(remoteCommandResponse);
+    _migrationCompletedCondVar.notify_all();
 }
 
 void MigrationManager::_checkDrained(WithLock) {
@@ -613,6 +685,64 @@ void MigrationManager::_abandonActiveMigrationsAndEnableManager(OperationContext
     _condVar.notify_all();
 }
 
+std::set<ShardId> MigrationManager::getThrottledShards() {
+    const auto now = _serviceContext->getFastClockSource()->now();
+
+    stdx::lock_guard<Latch> lock(_mutex);
+    std::set<ShardId> throttledShards;
+    for (auto it = _throttledShards.begin(); it != _throttledShards.end();) {
+        if (it->second <= now) {
+            it = _throttledShards.erase(it);
+            continue;
+        }
+        throttledShards.insert(it->first);
+        ++it;
+    }
+
+    return throttledShards;
+}
+
+void MigrationManager::_recordMigrationOutcome(const MigrateInfo& migrateInfo,
+                                               const RemoteCommandResponse& remoteCommandResponse,
+                                               Milliseconds duration) {
+    const Seconds throttlePeriod(balancerShardThrottlePeriodSecs.load());
+    if (throttlePeriod <= Seconds(0)) {
+        return;
+    }
+
+    const Status status = remoteCommandResponse.isOK()
+        ? extractMigrationStatusFromCommandResponse(remoteCommandResponse.data)
+        : remoteCommandResponse.status;
+    const Seconds slowMigrationThreshold(balancerSlowMigrationThresholdSecs.load());
+
+    // Both majority waits and the recipient's secondary throttle surface replication lag as write
+    // concern or time limit errors, while a slow disk on either side shows up as a slow migration.
+    const bool underPressure = status == ErrorCodes::WriteConcernFailed ||
+        ErrorCodes::isExceededTimeLimitError(status.code()) ||
+        (slowMigrationThreshold > Seconds(0) && duration > slowMigrationThreshold);
+    if (!underPressure) {
+        return;
+    }
+
+    LOGV2(4938400,
+          "Throttling balancer migrations for shards {donorShard} and {recipientShard} for "
+          "{throttlePeriod} after migration {migration} took {duration}{causedBy_status}",
+          "donorShard"_attr = migrateInfo.from,
+          "recipientShard"_attr = migrateInfo.to,
+          "throttlePeriod"_attr = throttlePeriod,
+          "migration"_attr = redact(migrateInfo.toString()),
+          "duration"_attr = duration,
+          "causedBy_status"_attr = causedBy(redact(status)));
+
+    const auto throttleUntil = _serviceContext->getFastClockSource()->now() + throttlePeriod;
+
+    stdx::lock_guard<Latch> lock(_mutex);
+    for (const auto& shardId : {migrateInfo.from, migrateInfo.to}) {
+        auto& shardThrottleUntil = _throttledShards[shardId];
+        shardThrottleUntil = std::max(shardThrottleUntil, throttleUntil);
+    }
+}
+
 Status MigrationManager::_processRemoteCommandResponse(
     const RemoteCommandResponse& remoteCommandResponse,
     ScopedMigrationRequest* scopedMigrationRequest) {
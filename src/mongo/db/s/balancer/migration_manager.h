@@ -31,6 +31,7 @@
 
 #include <list>
 #include <map>
+#include <set>
 #include <vector>
 
 #include "mongo/bson/bsonobj.h"
@@ -45,6 +46,7 @@
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/concurrency/notification.h"
 #include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -75,6 +77,10 @@ public:
      * "candidateMigrations" and wait for them to complete. Takes the distributed lock for each
      * collection with a chunk being migrated.
      *
+     * Migrations which do not share a shard are scheduled in parallel. A migration whose donor or
+     * recipient is busy with an earlier migration from the same call is held back until that one
+     * completes, and is not started at all if the shard has been throttled in the meantime.
+     *
      * If any of the migrations, which were scheduled in parallel fails with a LockBusy error
      * reported from the shard, retries it serially without the distributed lock.
      *
@@ -139,6 +145,13 @@ public:
      */
     void drainActiveMigrations();
 
+    /**
+     * Returns the shards which took part in a recent migration that showed signs of resource
+     * pressure on the donor or the recipient (see balancerShardThrottlePeriodSecs) and should not
+     * be selected for new migrations until their throttle period has elapsed.
+     */
+    std::set<ShardId> getThrottledShards();
+
 private:
     // The current state of the migration manager
     enum class State {  // Allowed transitions:
@@ -247,6 +260,14 @@ private:
         const executor::RemoteCommandResponse& remoteCommandResponse,
         ScopedMigrationRequest* scopedMigrationRequest);
 
+    /**
+     * Throttles the donor and recipient shards of a completed auto-balance migration if its
+     * outcome or duration indicates that either of them is short on disk or replication capacity.
+     */
+    void _recordMigrationOutcome(const MigrateInfo& migrateInfo,
+                                 const executor::RemoteCommandResponse& remoteCommandResponse,
+                                 Milliseconds duration);
+
     // The service context under which this migration manager runs.
     ServiceContext* const _serviceContext;
 
@@ -271,6 +292,12 @@ private:
 
     // Maps collection namespaces to that collection's active migrations.
     CollectionMigrationsStateMap _activeMigrations;
+
+    // Signaled whenever a scheduled migration completes.
+    stdx::condition_variable _migrationCompletedCondVar;
+
+    // Maps throttled shards to the time until which no new migrations should be selected for them.
+    std::map<ShardId, Date_t> _throttledShards;
 };
 
 }  // namespace mongo
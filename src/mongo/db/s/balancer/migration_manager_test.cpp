@@ -34,10 +34,12 @@
 #include "mongo/db/commands.h"
 #include "mongo/db/read_write_concern_defaults.h"
 #include "mongo/db/read_write_concern_defaults_cache_lookup_mock.h"
+#include "mongo/db/s/balancer/balancer_params_gen.h"
 #include "mongo/db/s/balancer/migration_manager.h"
 #include "mongo/db/s/balancer/migration_test_fixture.h"
 #include "mongo/db/s/config/sharding_catalog_manager.h"
 #include "mongo/s/request_types/move_chunk_request.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -237,6 +239,73 @@ TEST_F(MigrationManagerTest, TwoCollectionsTwoMigrationsEach) {
     future.default_timed_get();
 }
 
+// A migration which fails on replication errors throttles its shards, so the migrations queued
+// behind it for the same shards are not started.
+TEST_F(MigrationManagerTest, ThrottledShardsSkipQueuedMigrations) {
+    const auto originalThrottlePeriod = balancerShardThrottlePeriodSecs.load();
+    balancerShardThrottlePeriodSecs.store(3600);
+    ON_BLOCK_EXIT([&] { balancerShardThrottlePeriodSecs.store(originalThrottlePeriod); });
+
+    // Set up one shard in the metadata.
+    ASSERT_OK(catalogClient()->insertConfigDocument(
+        operationContext(), ShardType::ConfigNS, kShard0, kMajorityWriteConcern));
+
+    // Set up a database and two collections as sharded in the metadata.
+    std::string dbName = "foo";
+    const NamespaceString collName1(dbName, "bar");
+    const NamespaceString collName2(dbName, "baz");
+    ChunkVersion version1(2, 0, OID::gen());
+    ChunkVersion version2(2, 0, OID::gen());
+
+    setUpDatabase(dbName, kShardId0);
+    setUpCollection(collName1, version1);
+    setUpCollection(collName2, version2);
+
+    // Set up a chunk on the same shard for each collection.
+    ChunkType chunkColl1 = setUpChunk(
+        collName1, kKeyPattern.globalMin(), kKeyPattern.globalMax(), kShardId0, version1);
+    ChunkType chunkColl2 = setUpChunk(
+        collName2, kKeyPattern.globalMin(), kKeyPattern.globalMax(), kShardId0, version2);
+
+    // Going to request that both chunks get migrated to the same shard.
+    const std::vector<MigrateInfo> migrationRequests{{kShardId1,
+                                                      chunkColl1,
+                                                      MoveChunkRequest::ForceJumbo::kDoNotForce,
+                                                      MigrateInfo::chunksImbalance},
+                                                     {kShardId1,
+                                                      chunkColl2,
+                                                      MoveChunkRequest::ForceJumbo::kDoNotForce,
+                                                      MigrateInfo::chunksImbalance}};
+
+    auto future = launchAsync([this, migrationRequests] {
+        ThreadClient tc("Test", getGlobalServiceContext());
+        auto opCtx = cc().makeOperationContext();
+
+        // Scheduling the moveChunk commands requires finding a host to which to send the command.
+        // Set up a dummy host for the source shard.
+        shardTargeterMock(opCtx.get(), kShardId0)->setFindHostReturnValue(kShardHost0);
+
+        MigrationStatuses migrationStatuses = _migrationManager->executeMigrationsForAutoBalance(
+            opCtx.get(), migrationRequests, 0, kDefaultSecondaryThrottle, false);
+
+        ASSERT_NOT_OK(migrationStatuses.at(migrationRequests.front().getName()));
+        ASSERT_EQ(ErrorCodes::OperationFailed,
+                  migrationStatuses.at(migrationRequests.back().getName()));
+
+        const auto throttledShards = _migrationManager->getThrottledShards();
+        ASSERT_EQ(2U, throttledShards.size());
+        ASSERT_EQ(1U, throttledShards.count(kShardId0));
+        ASSERT_EQ(1U, throttledShards.count(kShardId1));
+    });
+
+    // Expect only the first moveChunk command, which fails waiting for replication.
+    expectMoveChunkCommand(
+        chunkColl1, kShardId1, Status(ErrorCodes::WriteConcernFailed, "waiting for replication"));
+
+    // Run the MigrationManager code.
+    future.default_timed_get();
+}
+
 // The MigrationManager should fail the migration if a host is not found for the source shard.
 // Scheduling a moveChunk command requires finding a host to which to send the command.
 TEST_F(MigrationManagerTest, SourceShardNotFound) {
@@ -716,38 +716,59 @@ void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromCloneLocs(OperationCon
                            internalQueryExecYieldIterations.load(),
                            Milliseconds(internalQueryExecYieldPeriodMS.load()));
 
-    stdx::unique_lock<Latch> lk(_mutex);
-    auto iter = _cloneLocs.begin();
+    bool batchFull = false;
+    while (!batchFull) {
+        // Claim the record ids expected to fit in the remainder of the batch up front, so that
+        // concurrent clone requests from the recipient are handed disjoint ranges of the chunk.
+        std::vector<RecordId> claimedIds;
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            const uint64_t remainingBytes = BSONObjMaxUserSize - arrBuilder->len();
+            const auto numToClaim = std::min<uint64_t>(
+                _cloneLocs.size(),
+                remainingBytes / std::max<uint64_t>(_averageObjectSizeForCloneLocs, 1) + 1);
+            auto claimEnd = std::next(_cloneLocs.begin(), numToClaim);
+            claimedIds.assign(_cloneLocs.begin(), claimEnd);
+            _cloneLocs.erase(_cloneLocs.begin(), claimEnd);
+        }
 
-    for (; iter != _cloneLocs.end(); ++iter) {
-        // We must always make progress in this method by at least one document because empty
-        // return indicates there is no more initial clone data.
-        if (arrBuilder->arrSize() && tracker.intervalHasElapsed()) {
+        if (claimedIds.empty()) {
             break;
         }
 
-        auto nextRecordId = *iter;
+        auto iter = claimedIds.begin();
 
-        lk.unlock();
-
-        Snapshotted<BSONObj> doc;
-        if (collection->findDoc(opCtx, nextRecordId, &doc)) {
-            // Use the builder size instead of accumulating the document sizes directly so
-            // that we take into consideration the overhead of BSONArray indices.
-            if (arrBuilder->arrSize() &&
-                (arrBuilder->len() + doc.value().objsize() + 1024) > BSONObjMaxUserSize) {
+        // Hand back whatever was claimed but did not make it into this batch
+        ON_BLOCK_EXIT([&] {
+            if (iter != claimedIds.end()) {
+                stdx::lock_guard<Latch> lk(_mutex);
+                _cloneLocs.insert(iter, claimedIds.end());
+            }
+        });
 
+        for (; iter != claimedIds.end(); ++iter) {
+            // We must always make progress in this method by at least one document because empty
+            // return indicates there is no more initial clone data.
+            if (arrBuilder->arrSize() && tracker.intervalHasElapsed()) {
+                batchFull = true;
                 break;
             }
 
-            arrBuilder->append(doc.value());
-            ShardingStatistics::get(opCtx).countDocsClonedOnDonor.addAndFetch(1);
+            Snapshotted<BSONObj> doc;
+            if (collection->findDoc(opCtx, *iter, &doc)) {
+                // Use the builder size instead of accumulating the document sizes directly so
+                // that we take into consideration the overhead of BSONArray indices.
+                if (arrBuilder->arrSize() &&
+                    (arrBuilder->len() + doc.value().objsize() + 1024) > BSONObjMaxUserSize) {
+                    batchFull = true;
+                    break;
+                }
+
+                arrBuilder->append(doc.value());
+                ShardingStatistics::get(opCtx).countDocsClonedOnDonor.addAndFetch(1);
+            }
         }
-
-        lk.lock();
     }
-
-    _cloneLocs.erase(_cloneLocs.begin(), iter);
 }
 
 uint64_t MigrationChunkClonerSourceLegacy::getCloneBatchBufferAllocationSize() {
@@ -767,6 +788,8 @@ Status MigrationChunkClonerSourceLegacy::nextCloneBatch(OperationContext* opCtx,
     // If this chunk is too large to store records in _cloneLocs and the command args specify to
     // attempt to move it, scan the collection directly.
     if (_jumboChunkCloneState && _forceJumbo) {
+        // The index scan executor can only be driven by one request at a time
+        stdx::lock_guard<Latch> jumboCloneLock(_jumboChunkCloneMutex);
         try {
             _nextCloneBatchFromIndexScan(opCtx, collection, arrBuilder);
             return Status::OK();
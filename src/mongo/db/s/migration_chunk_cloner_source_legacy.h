@@ -159,6 +159,9 @@ public:
      * give a chance to the caller to perform some form of yielding. It does not free or acquire any
      * locks on its own.
      *
+     * May be called by several clone requests concurrently, in which case each of them is handed a
+     * disjoint set of documents.
+     *
      * NOTE: Must be called with the collection lock held in at least IS mode.
      */
     Status nextCloneBatch(OperationContext* opCtx,
@@ -395,6 +398,11 @@ private:
         int docsCloned = 0;
     };
 
+    // Serializes concurrent clone requests which scan a jumbo chunk through
+    // '_jumboChunkCloneState'. Must be acquired before '_mutex'.
+    Mutex _jumboChunkCloneMutex =
+        MONGO_MAKE_LATCH("MigrationChunkClonerSourceLegacy::_jumboChunkCloneMutex");
+
     // Set only once its discovered a chunk is jumbo
     boost::optional<JumboChunkCloneState> _jumboChunkCloneState;
 };
@@ -407,12 +407,14 @@ Status MigrationDestinationManager::start(OperationContext* opCtx,
 repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
     OperationContext* opCtx,
     std::function<void(OperationContext*, BSONObj)> insertBatchFn,
-    std::function<BSONObj(OperationContext*)> fetchBatchFn) {
+    std::function<BSONObj(OperationContext*)> fetchBatchFn,
+    int numFetchers) {
+    invariant(numFetchers >= 1);
 
-    SingleProducerSingleConsumerQueue<BSONObj>::Options options;
-    options.maxQueueDepth = 1;
+    MultiProducerSingleConsumerQueue<BSONObj>::Options options;
+    options.maxQueueDepth = numFetchers;
 
-    SingleProducerSingleConsumerQueue<BSONObj> batches(options);
+    MultiProducerSingleConsumerQueue<BSONObj> batches(options);
     repl::OpTime lastOpApplied;
 
     stdx::thread inserterThread{[&] {
@@ -442,6 +444,28 @@ repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
         }
     }};
 
+    // State shared with the additional fetcher threads, which are only started when more than one
+    // concurrent fetcher is requested. The calling thread always acts as one of the fetchers.
+    AtomicWord<bool> stopFetching{false};
+    Mutex fetchersMutex = MONGO_MAKE_LATCH("MigrationDestinationManager::cloneDocumentsFromDonor");
+    stdx::condition_variable fetcherExitedCV;
+    int numRunningFetchers = numFetchers - 1;
+    std::vector<OperationContext*> fetcherOpCtxs;
+    Status fetchError = Status::OK();
+    std::vector<stdx::thread> fetcherThreads;
+
+    // Each fetcher keeps requesting batches until the donor hands it an empty one. The empty batch
+    // is not queued, so that the inserter only sees the end of the clone once all fetchers are
+    // done.
+    auto fetchUntilDone = [&](OperationContext* fetcherOpCtx) {
+        while (!stopFetching.load()) {
+            auto res = fetchBatchFn(fetcherOpCtx);
+            if (res["objects"].Obj().isEmpty()) {
+                return;
+            }
+            batches.push(res.getOwned(), fetcherOpCtx);
+        }
+    };
 
     {
         auto inserterThreadJoinGuard = makeGuard([&] {
@@ -449,19 +473,81 @@ repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
             inserterThread.join();
         });
 
-        while (true) {
-            auto res = fetchBatchFn(opCtx);
-            try {
-                batches.push(res.getOwned(), opCtx);
-                auto arr = res["objects"].Obj();
-                if (arr.isEmpty()) {
-                    break;
+        auto fetcherThreadsJoinGuard = makeGuard([&] {
+            {
+                stdx::lock_guard<Latch> lk(fetchersMutex);
+                stopFetching.store(true);
+                for (auto fetcherOpCtx : fetcherOpCtxs) {
+                    stdx::lock_guard<Client> clientLock(*fetcherOpCtx->getClient());
+                    fetcherOpCtx->getServiceContext()->killOperation(clientLock, fetcherOpCtx);
                 }
-            } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
-                break;
             }
+
+            for (auto& fetcherThread : fetcherThreads) {
+                if (fetcherThread.joinable()) {
+                    fetcherThread.join();
+                }
+            }
+        });
+
+        for (int i = 1; i < numFetchers; ++i) {
+            fetcherThreads.emplace_back([&] {
+                ON_BLOCK_EXIT([&] {
+                    stdx::lock_guard<Latch> lk(fetchersMutex);
+                    --numRunningFetchers;
+                    fetcherExitedCV.notify_all();
+                });
+                Client::initKillableThread("chunkFetcher", opCtx->getServiceContext());
+                auto fetcherOpCtx = Client::getCurrent()->makeOperationContext();
+
+                {
+                    stdx::lock_guard<Latch> lk(fetchersMutex);
+                    if (stopFetching.load()) {
+                        return;
+                    }
+                    fetcherOpCtxs.push_back(fetcherOpCtx.get());
+                }
+
+                ON_BLOCK_EXIT([&] {
+                    stdx::lock_guard<Latch> lk(fetchersMutex);
+                    fetcherOpCtxs.erase(
+                        std::find(fetcherOpCtxs.begin(), fetcherOpCtxs.end(), fetcherOpCtx.get()));
+                });
+
+                try {
+                    fetchUntilDone(fetcherOpCtx.get());
+                } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
+                    // The inserter failed and has already interrupted the calling thread
+                } catch (const DBException& ex) {
+                    stdx::lock_guard<Latch> lk(fetchersMutex);
+                    if (fetchError.isOK()) {
+                        fetchError = ex.toStatus();
+                    }
+                    stopFetching.store(true);
+                }
+            });
+        }
+
+        try {
+            fetchUntilDone(opCtx);
+
+            // Wait for the other fetchers interruptibly. If this operation is killed meanwhile, for
+            // instance because the migration was aborted, the guard kills theirs before joining.
+            {
+                stdx::unique_lock<Latch> lk(fetchersMutex);
+                opCtx->waitForConditionOrInterrupt(
+                    fetcherExitedCV, lk, [&] { return numRunningFetchers == 0; });
+            }
+            for (auto& fetcherThread : fetcherThreads) {
+                fetcherThread.join();
+            }
+            fetcherThreadsJoinGuard.dismiss();
+
+            uassertStatusOK(fetchError);
+            batches.push(BSON("objects" << BSONArray()), opCtx);
+        } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
         }
-    }  // This scope ensures that the guard is destroyed
+    }  // This scope ensures that the guards are destroyed
 
     // This check is necessary because the consumer thread uses killOp to propagate errors to the
     // producer thread (this thread)
@@ -486,6 +572,7 @@ Status MigrationDestinationManager::abort(const MigrationSessionId& sessionId) {
     _state = ABORT;
     _stateChangedCV.notify_all();
     _errmsg = "aborted";
+    _killCloneOperation(sl);
 
     return Status::OK();
 }
@@ -495,6 +582,14 @@ void MigrationDestinationManager::abortWithoutSessionIdCheck() {
     _state = ABORT;
     _stateChangedCV.notify_all();
     _errmsg = "aborted without session id check";
+    _killCloneOperation(sl);
+}
+
+void MigrationDestinationManager::_killCloneOperation(WithLock) {
+    if (_cloneOpCtx) {
+        stdx::lock_guard<Client> lk(*_cloneOpCtx->getClient());
+        _cloneOpCtx->getServiceContext()->killOperation(lk, _cloneOpCtx);
+    }
 }
 
 Status MigrationDestinationManager::startCommit(const MigrationSessionId& sessionId) {
@@ -1034,9 +1129,24 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
             return res.response;
         };
 
-        // If running on a replicated system, we'll need to flush the docs we cloned to the
-        // secondaries
-        lastOpApplied = cloneDocumentsFromDonor(opCtx, insertBatchFn, fetchBatchFn);
+        {
+            // Let abort() kill the clone, and with it the concurrent fetchers, instead of waiting
+            // for their _migrateClone requests in flight.
+            {
+                stdx::lock_guard<Latch> sl(_mutex);
+                uassert(50748, "Migration aborted while copying documents", _state != ABORT);
+                _cloneOpCtx = opCtx;
+            }
+            ON_BLOCK_EXIT([&] {
+                stdx::lock_guard<Latch> sl(_mutex);
+                _cloneOpCtx = nullptr;
+            });
+
+            // If running on a replicated system, we'll need to flush the docs we cloned to the
+            // secondaries
+            lastOpApplied = cloneDocumentsFromDonor(
+                opCtx, insertBatchFn, fetchBatchFn, migrateCloneConcurrentFetchers.load());
+        }
 
         timing.done(3);
         migrateThreadHangAtStep3.pauseWhileSet();
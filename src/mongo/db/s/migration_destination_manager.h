@@ -114,12 +114,14 @@ public:
                  const WriteConcernOptions& writeConcern);
 
     /**
-     * Clones documents from a donor shard.
+     * Clones documents from a donor shard. Batches are fetched by 'numFetchers' concurrent callers
+     * of 'fetchBatchFn' and inserted in the order they arrive by a single inserter thread.
      */
     static repl::OpTime cloneDocumentsFromDonor(
         OperationContext* opCtx,
         std::function<void(OperationContext*, BSONObj)> insertBatchFn,
-        std::function<BSONObj(OperationContext*)> fetchBatchFn);
+        std::function<BSONObj(OperationContext*)> fetchBatchFn,
+        int numFetchers = 1);
 
     /**
      * Idempotent method, which causes the current ongoing migration to abort only if it has the
@@ -189,6 +191,11 @@ private:
      */
     bool _isActive(WithLock) const;
 
+    /**
+     * Kills the operation cloning documents from the donor, if the clone is in progress.
+     */
+    void _killCloneOperation(WithLock);
+
     // Mutex to guard all fields
     mutable Mutex _mutex = MONGO_MAKE_LATCH("MigrationDestinationManager::_mutex");
 
@@ -234,6 +241,9 @@ private:
     State _state{READY};
     std::string _errmsg;
 
+    // The operation cloning documents from the donor while the clone is in progress.
+    OperationContext* _cloneOpCtx{nullptr};
+
     std::unique_ptr<SessionCatalogMigrationDestination> _sessionMigration;
 
     // Condition variable, which is signalled every time the state of the migration changes.
@@ -30,8 +30,12 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/s/migration_destination_manager.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/s/shard_server_test_fixture.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -105,6 +109,43 @@ TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWorksCorrectly) {
     }
 }
 
+// Tests that documents fetched by concurrent fetchers are all inserted exactly once.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWithConcurrentFetchers) {
+    auto mutex = MONGO_MAKE_LATCH();
+    auto docsToClone = createDocumentsToClone();
+    auto nextDocIt = docsToClone.begin();
+
+    // Hands out one document per batch, like a donor shared by several clone requests would
+    auto fetchBatchFn = [&](OperationContext* opCtx) {
+        stdx::lock_guard<Latch> lk(mutex);
+        BSONArrayBuilder arrayBuilder;
+        if (nextDocIt != docsToClone.end()) {
+            arrayBuilder.append(*nextDocIt++);
+        }
+        return BSON("objects" << arrayBuilder.arr());
+    };
+
+    std::vector<BSONObj> resultDocs;
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {
+        for (auto&& docToClone : docs) {
+            resultDocs.push_back(docToClone.Obj().getOwned());
+        }
+    };
+
+    MigrationDestinationManager::cloneDocumentsFromDonor(
+        operationContext(), insertBatchFn, fetchBatchFn, 3 /* numFetchers */);
+
+    std::sort(resultDocs.begin(), resultDocs.end(), [](const BSONObj& lhs, const BSONObj& rhs) {
+        return lhs["_id"].numberInt() < rhs["_id"].numberInt();
+    });
+
+    ASSERT_EQ(docsToClone.size(), resultDocs.size());
+    for (size_t i = 0; i < docsToClone.size(); ++i) {
+        ASSERT_BSONOBJ_EQ(docsToClone[i], resultDocs[i]);
+    }
+}
+
 // Tests that an exception in the fetch logic will successfully throw an exception on the main
 // thread.
 TEST_F(MigrationDestinationManagerTest, CloneDocumentsThrowsFetchErrors) {
@@ -132,6 +173,76 @@ TEST_F(MigrationDestinationManagerTest, CloneDocumentsThrowsFetchErrors) {
                                 "network error");
 }
 
+// Tests that an exception in the fetch logic of any of the concurrent fetchers will successfully
+// throw an exception on the main thread.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsWithConcurrentFetchersThrowsFetchErrors) {
+    AtomicWord<bool> ranOnce{false};
+
+    auto fetchBatchFn = [&](OperationContext* opCtx) {
+        if (ranOnce.swap(true)) {
+            uasserted(ErrorCodes::NetworkTimeout, "network error");
+        }
+
+        return BSON("objects" << createDocumentsToCloneArray());
+    };
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {};
+
+    ASSERT_THROWS_CODE_AND_WHAT(
+        MigrationDestinationManager::cloneDocumentsFromDonor(
+            operationContext(), insertBatchFn, fetchBatchFn, 3 /* numFetchers */),
+        DBException,
+        ErrorCodes::NetworkTimeout,
+        "network error");
+}
+
+// Tests that killing the main thread's operation, as aborting the migration does, also kills the
+// operations of the other fetchers instead of waiting for their requests to finish.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsWithConcurrentFetchersStopsWhenKilled) {
+    auto mutex = MONGO_MAKE_LATCH();
+    stdx::condition_variable cv;
+    int blockedFetchers = 0;
+    AtomicWord<int> interruptedFetchers{0};
+
+    // The main thread runs out of batches at once, while the other fetchers wait on a request
+    // which only ends when their operation is killed.
+    auto fetchBatchFn = [&](OperationContext* opCtx) {
+        if (opCtx == operationContext()) {
+            return BSON("objects" << BSONArray());
+        }
+        {
+            stdx::lock_guard<Latch> lk(mutex);
+            ++blockedFetchers;
+            cv.notify_all();
+        }
+        try {
+            opCtx->sleepFor(Hours(1));
+        } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
+            interruptedFetchers.addAndFetch(1);
+            throw;
+        }
+        return BSON("objects" << BSONArray());
+    };
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {};
+
+    stdx::thread killer([&] {
+        {
+            stdx::unique_lock<Latch> lk(mutex);
+            cv.wait(lk, [&] { return blockedFetchers == 2; });
+        }
+        stdx::lock_guard<Client> lk(*operationContext()->getClient());
+        getServiceContext()->killOperation(lk, operationContext());
+    });
+    ON_BLOCK_EXIT([&] { killer.join(); });
+
+    ASSERT_THROWS_CODE(MigrationDestinationManager::cloneDocumentsFromDonor(
+                           operationContext(), insertBatchFn, fetchBatchFn, 3 /* numFetchers */),
+                       DBException,
+                       ErrorCodes::Interrupted);
+    ASSERT_EQ(2, interruptedFetchers.load());
+}
+
 // Tests that an exception in the insertion logic will successfully throw an exception on the
 // main thread.
 TEST_F(MigrationDestinationManagerTest, CloneDocumentsCatchesInsertErrors) {
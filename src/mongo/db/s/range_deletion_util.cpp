@@ -34,7 +34,9 @@
 #include "mongo/db/s/range_deletion_util.h"
 
 #include <algorithm>
+#include <map>
 #include <utility>
+#include <vector>
 
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog_raii.h"
@@ -51,9 +53,11 @@
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/repl/repl_client_info.h"
+#include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/migration_util.h"
 #include "mongo/db/s/persistent_task_store.h"
 #include "mongo/db/s/range_deletion_task_gen.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/s/wait_for_majority_service.h"
 #include "mongo/db/service_context.h"
@@ -75,6 +79,82 @@ MONGO_FAIL_POINT_DEFINE(suspendRangeDeletion);
 MONGO_FAIL_POINT_DEFINE(throwWriteConflictExceptionInDeleteRange);
 MONGO_FAIL_POINT_DEFINE(throwInternalErrorInDeleteRange);
 
+/**
+ * Tracks the ranges of each collection which are queued or being deleted on this node, so that the
+ * amount of range deletion work left can be reported through serverStatus.
+ */
+class RangeDeletionBacklog {
+public:
+    struct Range {
+        // Number of documents found in the range when its deletion began, or -1 if they were not
+        // counted
+        AtomicWord<long long> numDocsAtStart{-1};
+
+        // Number of documents deleted from the range so far
+        AtomicWord<long long> numDocsDeleted{0};
+    };
+
+    static RangeDeletionBacklog& get(ServiceContext* serviceContext);
+
+    std::shared_ptr<Range> add(const NamespaceString& nss) {
+        auto range = std::make_shared<Range>();
+
+        stdx::lock_guard<Latch> lg(_mutex);
+        _ranges[nss].push_back(range);
+        return range;
+    }
+
+    void remove(const NamespaceString& nss, const std::shared_ptr<Range>& range) {
+        stdx::lock_guard<Latch> lg(_mutex);
+        auto it = _ranges.find(nss);
+        invariant(it != _ranges.end());
+
+        auto& collRanges = it->second;
+        collRanges.erase(std::find(collRanges.begin(), collRanges.end(), range));
+        if (collRanges.empty()) {
+            _ranges.erase(it);
+        }
+    }
+
+    void report(BSONObjBuilder* builder) const {
+        stdx::lock_guard<Latch> lg(_mutex);
+        for (const auto& [nss, collRanges] : _ranges) {
+            bool anyRangeCounted = false;
+            long long numDocsRemaining = 0;
+            long long numDocsDeleted = 0;
+            for (const auto& range : collRanges) {
+                const auto numDocsAtStart = range->numDocsAtStart.load();
+                const auto numDeleted = range->numDocsDeleted.load();
+                if (numDocsAtStart >= 0) {
+                    anyRangeCounted = true;
+                }
+                if (numDocsAtStart > numDeleted) {
+                    numDocsRemaining += numDocsAtStart - numDeleted;
+                }
+                numDocsDeleted += numDeleted;
+            }
+
+            BSONObjBuilder collBuilder(builder->subobjStart(nss.ns()));
+            collBuilder.appendNumber("ranges", static_cast<long long>(collRanges.size()));
+            if (anyRangeCounted) {
+                collBuilder.appendNumber("estimatedDocumentsRemaining", numDocsRemaining);
+            }
+            collBuilder.appendNumber("documentsDeleted", numDocsDeleted);
+        }
+    }
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("RangeDeletionBacklog::_mutex");
+
+    std::map<NamespaceString, std::vector<std::shared_ptr<Range>>> _ranges;
+};
+
+const auto getRangeDeletionBacklog = ServiceContext::declareDecoration<RangeDeletionBacklog>();
+
+RangeDeletionBacklog& RangeDeletionBacklog::get(ServiceContext* serviceContext) {
+    return getRangeDeletionBacklog(serviceContext);
+}
+
 /**
  * Returns whether the currentCollection has the same UUID as the expectedCollectionUuid. Used to
  * ensure that the collection has not been dropped or dropped and recreated since the range was
@@ -243,6 +323,80 @@ auto withTemporaryOperationContext(Callable&& callable) {
     return callable(opCtx);
 }
 
+/**
+ * Counts the documents in the range through the shard key index, for the range deletion backlog to
+ * report how much is left to delete. Returns -1 if the documents could not be counted.
+ */
+long long countDocumentsInRange(const NamespaceString& nss,
+                                const UUID& collectionUuid,
+                                const BSONObj& keyPattern,
+                                const ChunkRange& range) {
+    return withTemporaryOperationContext([&](OperationContext* opCtx) -> long long {
+        try {
+            AutoGetCollection autoColl(opCtx, nss, MODE_IS);
+            auto* const collection = autoColl.getCollection();
+            if (collectionUuidHasChanged(nss, collection, collectionUuid)) {
+                return -1;
+            }
+
+            const IndexDescriptor* idx =
+                collection->getIndexCatalog()->findShardKeyPrefixedIndex(opCtx, keyPattern, false);
+            if (!idx) {
+                return -1;
+            }
+
+            const KeyPattern indexKeyPattern(idx->keyPattern());
+            const auto extend = [&](const auto& key) {
+                return Helpers::toKeyFormat(indexKeyPattern.extendRangeBound(key, false));
+            };
+
+            auto exec = InternalPlanner::indexScan(opCtx,
+                                                   collection,
+                                                   idx,
+                                                   extend(range.getMin()),
+                                                   extend(range.getMax()),
+                                                   BoundInclusion::kIncludeStartKeyOnly,
+                                                   PlanExecutor::YIELD_AUTO);
+
+            long long numDocs = 0;
+            BSONObj obj;
+            PlanExecutor::ExecState state;
+            while (PlanExecutor::ADVANCED == (state = exec->getNext(&obj, nullptr))) {
+                ++numDocs;
+            }
+
+            return state == PlanExecutor::IS_EOF ? numDocs : -1;
+        } catch (const DBException& ex) {
+            LOGV2_DEBUG(4938401,
+                        1,
+                        "Unable to count the documents in range {range} of {nss} for the range "
+                        "deletion backlog{causedBy_ex}",
+                        "range"_attr = redact(range.toString()),
+                        "nss"_attr = nss,
+                        "causedBy_ex"_attr = causedBy(redact(ex)));
+            return -1;
+        }
+    });
+}
+
+/**
+ * Returns by how many seconds the majority commit point trails the given optime of a local write.
+ */
+Seconds majorityCommitLag(OperationContext* opCtx, const repl::OpTime& opTime) {
+    auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+    if (!replCoord->isReplEnabled() || opTime.isNull()) {
+        return Seconds(0);
+    }
+
+    const auto lastCommittedOpTime = replCoord->getLastCommittedOpTime();
+    if (lastCommittedOpTime >= opTime) {
+        return Seconds(0);
+    }
+
+    return Seconds(static_cast<long long>(opTime.getTimestamp().getSecs()) -
+                   static_cast<long long>(lastCommittedOpTime.getTimestamp().getSecs()));
+}
+
 /**
  * Delete the range in a sequence of batches until there are no more documents to
  * delete or deletion returns an error.
@@ -253,7 +407,8 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                                           const BSONObj& keyPattern,
                                           const ChunkRange& range,
                                           int numDocsToRemovePerBatch,
-                                          Milliseconds delayBetweenBatches) {
+                                          Milliseconds delayBetweenBatches,
+                                          std::shared_ptr<RangeDeletionBacklog::Range> backlog) {
     return AsyncTry([=] {
                return withTemporaryOperationContext([=](OperationContext* opCtx) {
                    AutoGetCollection autoColl(opCtx, nss, MODE_IX);
@@ -278,7 +433,33 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                                "collectionUuid"_attr = collectionUuid,
                                "range"_attr = range.toString());
 
-                   return numDeleted;
+                   backlog->numDocsDeleted.fetchAndAdd(numDeleted);
+
+                   // Let the secondaries catch up before deleting more if the majority commit
+                   // point has fallen too far behind the deletions
+                   const Seconds maxMajorityCommitLag(rangeDeleterMaxMajorityCommitLagSecs.load());
+                   const auto lastOpTime =
+                       repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp();
+                   if (numDeleted > 0 && maxMajorityCommitLag > Seconds(0)) {
+                       const auto lag = majorityCommitLag(opCtx, lastOpTime);
+                       if (lag > maxMajorityCommitLag) {
+                           LOGV2_DEBUG(4938402,
+                                       2,
+                                       "Waiting for the majority commit point, which trails by "
+                                       "{lag}, to reach the last deletion from {nss_ns} range "
+                                       "{range}",
+                                       "lag"_attr = lag,
+                                       "nss_ns"_attr = nss.ns(),
+                                       "range"_attr = redact(range.toString()));
+
+                           return WaitForMajorityService::get(opCtx->getServiceContext())
+                               .waitUntilMajority(lastOpTime)
+                               .thenRunOn(executor)
+                               .then([numDeleted] { return numDeleted; });
+                       }
+                   }
+
+                   return ExecutorFuture<int>(executor, numDeleted);
                });
            })
         .until([](StatusWith<int> swNumDeleted) {
@@ -372,6 +553,8 @@ SharedSemiFuture<void> removeDocumentsInRange(
     int numDocsToRemovePerBatch,
     Seconds delayForActiveQueriesOnSecondariesToComplete,
     Milliseconds delayBetweenBatches) {
+    auto backlog = RangeDeletionBacklog::get(getGlobalServiceContext()).add(nss);
+
     return std::move(waitForActiveQueriesToComplete)
         .thenRunOn(executor)
         .onError([&](Status s) {
@@ -396,13 +579,19 @@ SharedSemiFuture<void> removeDocumentsInRange(
 
             notifySecondariesThatDeletionIsOccurring(nss, collectionUuid, range);
 
+            if (rangeDeleterEstimateDocumentsRemaining.load()) {
+                backlog->numDocsAtStart.store(
+                    countDocumentsInRange(nss, collectionUuid, keyPattern, range));
+            }
+
             return deleteRangeInBatches(executor,
                                         nss,
                                         collectionUuid,
                                         keyPattern,
                                         range,
                                         numDocsToRemovePerBatch,
-                                        delayBetweenBatches);
+                                        delayBetweenBatches,
+                                        backlog);
         })
         .then([=] {
             // We only need to do this if previous rounds succeed, because the only errors that
@@ -411,6 +600,8 @@ SharedSemiFuture<void> removeDocumentsInRange(
             return waitForDeletionsToMajorityReplicate(executor, nss, collectionUuid, range);
         })
         .onCompletion([=](Status s) {
+            RangeDeletionBacklog::get(getGlobalServiceContext()).remove(nss, backlog);
+
             if (s.isOK()) {
                 LOGV2_DEBUG(23773,
                             2,
@@ -445,4 +636,9 @@ SharedSemiFuture<void> removeDocumentsInRange(
         .share();
 }  // namespace mongo
 
+void reportRangeDeletionBacklog(ServiceContext* serviceContext, BSONObjBuilder* builder) {
+    BSONObjBuilder backlogBuilder(builder->subobjStart("rangeDeleterBacklog"));
+    RangeDeletionBacklog::get(serviceContext).report(&backlogBuilder);
+}
+
 }  // namespace mongo
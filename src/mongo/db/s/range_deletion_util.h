@@ -37,6 +37,8 @@
 namespace mongo {
 
 class BSONObj;
+class BSONObjBuilder;
+class ServiceContext;
 
 // The maximum number of documents to delete in a single batch during range deletion.
 // secondaryThrottle and rangeDeleterBatchDelayMS apply between each batch.
@@ -59,7 +61,12 @@ extern AtomicWord<int> rangeDeleterBatchDelayMS;
  * 2. Waits for delayForActiveQueriesOnSecondariesToComplete seconds before deleting any documents,
  *    to give queries running on secondaries a chance to finish.
  * 3. Delete documents in a series of batches with up to numDocsToRemovePerBatch documents per
- *    batch, with a delay of delayBetweenBatches milliseconds in between batches.
+ *    batch, with a delay of delayBetweenBatches milliseconds in between batches. If the majority
+ *    commit point trails a batch by more than rangeDeleterMaxMajorityCommitLagSecs, the next batch
+ *    also waits for that batch to be majority committed.
+ *
+ * The range counts towards the range deletion backlog of its collection until the returned future
+ * is resolved.
  */
 SharedSemiFuture<void> removeDocumentsInRange(
     const std::shared_ptr<executor::TaskExecutor>& executor,
@@ -71,4 +78,12 @@ SharedSemiFuture<void> removeDocumentsInRange(
     int numDocsToRemovePerBatch,
     Seconds delayForActiveQueriesOnSecondariesToComplete,
     Milliseconds delayBetweenBatches);
+
+/**
+ * Appends to 'builder' the ranges which are queued or being deleted by removeDocumentsInRange on
+ * this node for each collection. If rangeDeleterEstimateDocumentsRemaining was set when their
+ * deletion began, also appends an estimate of the number of documents left in them.
+ */
+void reportRangeDeletionBacklog(ServiceContext* serviceContext, BSONObjBuilder* builder);
+
 }  // namespace mongo
@@ -42,6 +42,7 @@
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -597,6 +598,118 @@ TEST_F(RangeDeleterTest, RemoveDocumentsInRangeRespectsDelayInBetweenBatches) {
     ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 0);
 }
 
+TEST_F(RangeDeleterTest, RemoveDocumentsInRangeReportsBacklogUntilComplete) {
+    const ChunkRange range(BSON(kShardKey << 0), BSON(kShardKey << 10));
+    // More documents than the batch size.
+    const auto numDocsToInsert = 3;
+    const auto numDocsToRemovePerBatch = 1;
+    const auto delayBetweenBatches = Milliseconds(10);
+    auto queriesComplete = SemiFuture<void>::makeReady();
+
+    rangeDeleterEstimateDocumentsRemaining.store(true);
+    ON_BLOCK_EXIT([] { rangeDeleterEstimateDocumentsRemaining.store(false); });
+
+    // Insert documents in range.
+    DBDirectClient dbclient(operationContext());
+    for (auto i = 0; i < numDocsToInsert; ++i) {
+        dbclient.insert(kNss.toString(), BSON(kShardKey << i));
+    }
+
+    auto cleanupComplete =
+        removeDocumentsInRange(executor(),
+                               std::move(queriesComplete),
+                               kNss,
+                               uuid(),
+                               kShardKeyPattern,
+                               range,
+                               numDocsToRemovePerBatch,
+                               Seconds(0) /* delayForActiveQueriesOnSecondariesToComplete */,
+                               delayBetweenBatches);
+
+    // A best-effort wait for the first batch to be deleted, after which the deletion waits for the
+    // clock to advance.
+    sleepsecs(1);
+    ASSERT_FALSE(cleanupComplete.isReady());
+
+    auto reportBacklog = [&] {
+        BSONObjBuilder builder;
+        reportRangeDeletionBacklog(getServiceContext(), &builder);
+        return builder.obj()["rangeDeleterBacklog"].Obj().getOwned();
+    };
+
+    const auto collBacklog = reportBacklog()[kNss.ns()].Obj();
+    ASSERT_EQ(1, collBacklog["ranges"].numberLong());
+    ASSERT_EQ(numDocsToInsert,
+              collBacklog["estimatedDocumentsRemaining"].numberLong() +
+                  collBacklog["documentsDeleted"].numberLong());
+
+    while (!cleanupComplete.isReady()) {
+        executor::NetworkInterfaceMock::InNetworkGuard guard(network());
+        network()->advanceTime(network()->now() + Milliseconds(1));
+    }
+
+    cleanupComplete.get();
+    ASSERT_FALSE(reportBacklog().hasField(kNss.ns()));
+}
+
+TEST_F(RangeDeleterTest, RemoveDocumentsInRangeWaitsForMajorityWhenCommitLagExceedsMaximum) {
+    const ChunkRange range(BSON(kShardKey << 0), BSON(kShardKey << 10));
+    // More documents than the batch size.
+    const auto numDocsToInsert = 3;
+    const auto numDocsToRemovePerBatch = 1;
+    auto queriesComplete = SemiFuture<void>::makeReady();
+
+    // The mock's majority commit point never advances, so every batch trails it by more than this.
+    rangeDeleterMaxMajorityCommitLagSecs.store(1);
+    ON_BLOCK_EXIT([] { rangeDeleterMaxMajorityCommitLagSecs.store(0); });
+
+    // Hold majority waits, which WaitForMajorityService makes through the replication coordinator,
+    // until the first batch is known to be blocked.
+    auto replCoord = checked_cast<repl::ReplicationCoordinatorMock*>(
+        repl::ReplicationCoordinator::get(getServiceContext()));
+    SharedPromise<void> majorityCommitted;
+    AtomicWord<int> numTimesWaitedForMajority{0};
+    replCoord->setAwaitReplicationReturnValueFunction(
+        [&](OperationContext* opCtx, const repl::OpTime& opTime) {
+            numTimesWaitedForMajority.fetchAndAdd(1);
+            majorityCommitted.getFuture().get();
+            return repl::ReplicationCoordinator::StatusAndDuration(Status::OK(), Milliseconds(0));
+        });
+    ON_BLOCK_EXIT([&] {
+        if (!majorityCommitted.getFuture().isReady()) {
+            majorityCommitted.emplaceValue();
+        }
+    });
+
+    // Insert documents in range.
+    DBDirectClient dbclient(operationContext());
+    for (auto i = 0; i < numDocsToInsert; ++i) {
+        dbclient.insert(kNss.toString(), BSON(kShardKey << i));
+    }
+
+    auto cleanupComplete =
+        removeDocumentsInRange(executor(),
+                               std::move(queriesComplete),
+                               kNss,
+                               uuid(),
+                               kShardKeyPattern,
+                               range,
+                               numDocsToRemovePerBatch,
+                               Seconds(0) /* delayForActiveQueriesOnSecondariesToComplete */,
+                               Milliseconds(0) /* delayBetweenBatches */);
+
+    // A best-effort wait for the first batch to be deleted. Without the throttling the remaining
+    // batches would follow immediately.
+    sleepsecs(1);
+    ASSERT_FALSE(cleanupComplete.isReady());
+    ASSERT_EQ(1, numTimesWaitedForMajority.load());
+    ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), numDocsToInsert - numDocsToRemovePerBatch);
+
+    majorityCommitted.emplaceValue();
+    cleanupComplete.get();
+    ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 0);
+}
+
 TEST_F(RangeDeleterTest, RemoveDocumentsInRangeRespectsOrphanCleanupDelay) {
     const ChunkRange range(BSON(kShardKey << 0), BSON(kShardKey << 10));
     // More documents than the batch size.
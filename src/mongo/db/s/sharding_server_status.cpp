@@ -33,6 +33,7 @@
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/s/active_migrations_registry.h"
 #include "mongo/db/s/collection_sharding_state.h"
+#include "mongo/db/s/range_deletion_util.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/s/sharding_statistics.h"
 #include "mongo/s/balancer_configuration.h"
@@ -113,6 +114,7 @@ public:
         ShardingStatistics::get(opCtx).report(&result);
         catalogCache->report(&result);
         CollectionShardingState::appendInfoForServerStatus(opCtx, &result);
+        reportRangeDeletionBacklog(opCtx->getServiceContext(), &result);
 
         return result.obj();
     }
@@ -39,10 +39,13 @@
 #include "mongo/db/s/transaction_coordinator_document_gen.h"
 #include "mongo/db/s/transaction_coordinator_metrics_observer.h"
 #include "mongo/db/s/transaction_coordinator_test_fixture.h"
+#include "mongo/db/s/transaction_coordinator_util.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/log_test.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
+#include "mongo/util/fail_point.h"
 #include "mongo/util/tick_source_mock.h"
 
 namespace mongo {
@@ -638,6 +641,70 @@ protected:
         ASSERT_EQUALS(allCoordinatorDocs.size(), size_t(0));
     }
 
+    /**
+     * Returns an update which sets an abort decision on the document for (lsid, _txnNumber), if it
+     * has the participant list '_participants'.
+     */
+    write_ops::UpdateOpEntry makeAbortDecisionUpdate(const LogicalSessionId& lsid) {
+        OperationSessionInfo sessionInfo;
+        sessionInfo.setSessionId(lsid);
+        sessionInfo.setTxnNumber(_txnNumber);
+
+        txn::CoordinatorCommitDecision decision(txn::CommitDecision::kAbort);
+        decision.setAbortStatus(Status(ErrorCodes::NoSuchTransaction, "Test abort status"));
+
+        TransactionCoordinatorDocument doc;
+        doc.setId(sessionInfo);
+        doc.setParticipants(_participants);
+        doc.setDecision(decision);
+
+        write_ops::UpdateOpEntry update;
+        update.setQ(BSON(TransactionCoordinatorDocument::kIdFieldName << sessionInfo.toBSON()));
+        update.setU(doc.toBSON());
+        return update;
+    }
+
+    /**
+     * Writes each of 'updates' through the DecisionWriteBatcher from its own thread. The first
+     * update is held in a batch of its own until all the others are queued, so that they are
+     * written together as a second batch. Returns what the batcher returned for each update.
+     */
+    std::vector<boost::optional<repl::OpTime>> writeDecisionsInTwoBatches(
+        const std::vector<write_ops::UpdateOpEntry>& updates) {
+        auto& batcher = txn::DecisionWriteBatcher::get(getServiceContext());
+        const auto numBatchesWrittenBefore = batcher.getNumBatchesWritten();
+
+        std::vector<boost::optional<repl::OpTime>> opTimes(updates.size());
+        std::vector<stdx::thread> threads;
+        const auto startWriter = [&](size_t i) {
+            threads.emplace_back([&, i] {
+                ThreadClient tc("DecisionWriter", getServiceContext());
+                auto opCtx = tc->makeOperationContext();
+                opTimes[i] = batcher.write(opCtx.get(), updates[i]);
+            });
+        };
+
+        auto fp = globalFailPointRegistry().find("hangBeforeWritingDecisionBatch");
+        const auto initialTimesEntered = fp->setMode(FailPoint::alwaysOn);
+        startWriter(0);
+        fp->waitForTimesEntered(initialTimesEntered + 1);
+
+        for (size_t i = 1; i < updates.size(); ++i) {
+            startWriter(i);
+        }
+        while (batcher.getNumPendingWrites() < updates.size() - 1) {
+            sleepmillis(10);
+        }
+
+        fp->setMode(FailPoint::off);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        ASSERT_EQ(numBatchesWrittenBefore + 2, batcher.getNumBatchesWritten());
+        return opTimes;
+    }
+
     const std::vector<ShardId> _participants{
         ShardId("shard0001"), ShardId("shard0002"), ShardId("shard0003")};
 
@@ -747,6 +814,52 @@ TEST_F(TransactionCoordinatorDriverPersistenceTest,
         operationContext(), _lsid, _txnNumber, _participants, _commitTimestamp /* commit */);
 }
 
+TEST_F(TransactionCoordinatorDriverPersistenceTest,
+       ConcurrentDecisionWritesShareOneBatchWhenAllMatch) {
+    std::vector<LogicalSessionId> lsids;
+    std::vector<write_ops::UpdateOpEntry> updates;
+    for (int i = 0; i < 4; ++i) {
+        lsids.push_back(makeLogicalSessionIdForTest());
+        txn::persistParticipantsList(*_aws, lsids.back(), _txnNumber, _participants).get();
+        updates.push_back(makeAbortDecisionUpdate(lsids.back()));
+    }
+
+    const auto opTimes = writeDecisionsInTwoBatches(updates);
+    for (const auto& opTime : opTimes) {
+        ASSERT(opTime);
+    }
+    // The decisions queued behind the first batch were applied by one write.
+    ASSERT_EQ(*opTimes[1], *opTimes[2]);
+    ASSERT_EQ(*opTimes[1], *opTimes[3]);
+    ASSERT_GT(*opTimes[1], *opTimes[0]);
+
+    auto allCoordinatorDocs = txn::readAllCoordinatorDocs(operationContext());
+    ASSERT_EQUALS(allCoordinatorDocs.size(), lsids.size());
+    for (const auto& doc : allCoordinatorDocs) {
+        ASSERT(doc.getDecision());
+        ASSERT(doc.getDecision()->getDecision() == txn::CommitDecision::kAbort);
+    }
+}
+
+TEST_F(TransactionCoordinatorDriverPersistenceTest,
+       ConcurrentDecisionWritesFallBackWhenAnUpdateInTheirBatchDoesNotMatch) {
+    std::vector<write_ops::UpdateOpEntry> updates;
+    for (int i = 0; i < 3; ++i) {
+        auto lsid = makeLogicalSessionIdForTest();
+        txn::persistParticipantsList(*_aws, lsid, _txnNumber, _participants).get();
+        updates.push_back(makeAbortDecisionUpdate(lsid));
+    }
+    // No document exists for the last transaction.
+    updates.push_back(makeAbortDecisionUpdate(makeLogicalSessionIdForTest()));
+
+    const auto opTimes = writeDecisionsInTwoBatches(updates);
+    ASSERT(opTimes[0]);
+    // Every update in the second batch has to be written again on its own.
+    ASSERT_FALSE(opTimes[1]);
+    ASSERT_FALSE(opTimes[2]);
+    ASSERT_FALSE(opTimes[3]);
+}
+
 TEST_F(TransactionCoordinatorDriverPersistenceTest, DeleteCoordinatorDocWhenNoDocumentExistsFails) {
     ASSERT_THROWS_CODE(
         txn::deleteCoordinatorDoc(*_aws, _lsid, _txnNumber).get(), AssertionException, 51027);
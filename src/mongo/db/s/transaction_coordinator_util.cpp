@@ -54,6 +54,7 @@ namespace {
 MONGO_FAIL_POINT_DEFINE(hangBeforeWritingParticipantList);
 MONGO_FAIL_POINT_DEFINE(hangBeforeSendingPrepare);
 MONGO_FAIL_POINT_DEFINE(hangBeforeWritingDecision);
+MONGO_FAIL_POINT_DEFINE(hangBeforeWritingDecisionBatch);
 MONGO_FAIL_POINT_DEFINE(hangBeforeSendingCommit);
 MONGO_FAIL_POINT_DEFINE(hangBeforeSendingAbort);
 MONGO_FAIL_POINT_DEFINE(hangBeforeDeletingCoordinatorDoc);
@@ -64,6 +65,11 @@ using CoordinatorAction = TransactionCoordinatorWorkerCurOpRepository::Coordinat
 
 const Backoff kExponentialBackoff(Seconds(1), Milliseconds::max());
 
+// Bounds the size of a batched decision update command well below the maximum BSON object size.
+const size_t kMaxDecisionWriteBatchSize = 500;
+
+const auto getDecisionWriteBatcher = ServiceContext::declareDecoration<DecisionWriteBatcher>();
+
 const ReadPreferenceSetting kPrimaryReadPreference{ReadPreference::PrimaryOnly};
 
 BSONArray buildParticipantListMatchesConditions(const std::vector<ShardId>& participantList) {
@@ -288,6 +294,102 @@ Future<PrepareVoteConsensus> sendPrepare(ServiceContext* service,
         });
 }
 
+DecisionWriteBatcher& DecisionWriteBatcher::get(ServiceContext* service) {
+    return getDecisionWriteBatcher(service);
+}
+
+boost::optional<repl::OpTime> DecisionWriteBatcher::write(OperationContext* opCtx,
+                                                          write_ops::UpdateOpEntry update) {
+    auto pendingWrite = std::make_shared<PendingWrite>();
+    pendingWrite->update = std::move(update);
+
+    stdx::unique_lock<Latch> ul(_mutex);
+    _pendingWrites.push_back(pendingWrite);
+
+    while (!pendingWrite->done) {
+        try {
+            opCtx->waitForConditionOrInterrupt(
+                _batchWrittenCV, ul, [&] { return pendingWrite->done || !_writeInProgress; });
+        } catch (const DBException&) {
+            // Withdraw the update unless a batch has already picked it up, in which case the batch
+            // completes it without anyone waiting.
+            auto it = std::find(_pendingWrites.begin(), _pendingWrites.end(), pendingWrite);
+            if (it != _pendingWrites.end()) {
+                _pendingWrites.erase(it);
+            }
+            throw;
+        }
+
+        if (pendingWrite->done) {
+            break;
+        }
+
+        // No batch is being written, so write the next one. It holds this caller's update unless
+        // more than a full batch is queued ahead of it, in which case the caller goes round again.
+        const auto batchEnd = _pendingWrites.begin() +
+            std::min(_pendingWrites.size(), kMaxDecisionWriteBatchSize);
+        const std::vector<std::shared_ptr<PendingWrite>> batch(_pendingWrites.begin(), batchEnd);
+        _pendingWrites.erase(_pendingWrites.begin(), batchEnd);
+        _writeInProgress = true;
+        ul.unlock();
+
+        boost::optional<repl::OpTime> opTime;
+        try {
+            if (MONGO_unlikely(hangBeforeWritingDecisionBatch.shouldFail())) {
+                LOGV2(4938103, "Hit hangBeforeWritingDecisionBatch failpoint");
+                hangBeforeWritingDecisionBatch.pauseWhileSet(opCtx);
+            }
+
+            DBDirectClient client(opCtx);
+            const auto commandResponse = client.runCommand([&] {
+                write_ops::Update updateOp(NamespaceString::kTransactionCoordinatorsNamespace);
+                std::vector<write_ops::UpdateOpEntry> updates;
+                updates.reserve(batch.size());
+                for (const auto& write : batch) {
+                    updates.push_back(write->update);
+                }
+                updateOp.setUpdates(std::move(updates));
+                return updateOp.serialize({});
+            }());
+
+            // The reply only reports how many updates matched in total, so unless all of them
+            // did, every caller has to find out on its own whether its update matched.
+            const auto commandReply = commandResponse->getCommandReply();
+            if (getStatusFromWriteCommandReply(commandReply).isOK() &&
+                commandReply.getIntField("n") == static_cast<int>(batch.size())) {
+                opTime = repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp();
+            }
+        } catch (const DBException& ex) {
+            LOGV2_DEBUG(4938104,
+                        3,
+                        "Failed to write a batch of transaction coordinator decisions",
+                        "batchSize"_attr = batch.size(),
+                        "error"_attr = redact(ex));
+        }
+
+        ul.lock();
+        for (const auto& write : batch) {
+            write->opTime = opTime;
+            write->done = true;
+        }
+        _writeInProgress = false;
+        ++_numBatchesWritten;
+        _batchWrittenCV.notify_all();
+    }
+
+    return pendingWrite->opTime;
+}
+
+size_t DecisionWriteBatcher::getNumPendingWrites() const {
+    stdx::lock_guard<Latch> lg(_mutex);
+    return _pendingWrites.size();
+}
+
+long long DecisionWriteBatcher::getNumBatchesWritten() const {
+    stdx::lock_guard<Latch> lg(_mutex);
+    return _numBatchesWritten;
+}
+
 namespace {
 repl::OpTime persistDecisionBlocking(OperationContext* opCtx,
                                      const LogicalSessionId& lsid,
@@ -310,60 +412,70 @@ repl::OpTime persistDecisionBlocking(OperationContext* opCtx,
     sessionInfo.setSessionId(lsid);
     sessionInfo.setTxnNumber(txnNumber);
 
-    DBDirectClient client(opCtx);
+    const auto entry = [&] {
+        write_ops::UpdateOpEntry entry;
 
-    // Throws if serializing the request or deserializing the response fails.
-    const auto commandResponse = client.runCommand([&] {
-        write_ops::Update updateOp(NamespaceString::kTransactionCoordinatorsNamespace);
-        updateOp.setUpdates({[&] {
-            write_ops::UpdateOpEntry entry;
-
-            // Ensure that the document for the (lsid, txnNumber) has the same participant list and
-            // either has no decision or the same decision. The document may have the same decision
-            // if an earlier attempt to write the decision failed waiting for writeConcern.
-            BSONObj noDecision = BSON(TransactionCoordinatorDocument::kDecisionFieldName
-                                      << BSON("$exists" << false));
-            BSONObj sameDecision =
-                BSON(TransactionCoordinatorDocument::kDecisionFieldName << decision.toBSON());
-
-            entry.setQ(BSON(TransactionCoordinatorDocument::kIdFieldName
-                            << sessionInfo.toBSON() << "$and"
-                            << buildParticipantListMatchesConditions(participantList) << "$or"
-                            << BSON_ARRAY(noDecision << sameDecision)));
-
-            entry.setU([&] {
-                TransactionCoordinatorDocument doc;
-                doc.setId(sessionInfo);
-                doc.setParticipants(std::move(participantList));
-                doc.setDecision(decision);
-                return doc.toBSON();
-            }());
+        // Ensure that the document for the (lsid, txnNumber) has the same participant list and
+        // either has no decision or the same decision. The document may have the same decision
+        // if an earlier attempt to write the decision failed waiting for writeConcern.
+        BSONObj noDecision = BSON(TransactionCoordinatorDocument::kDecisionFieldName
+                                  << BSON("$exists" << false));
+        BSONObj sameDecision =
+            BSON(TransactionCoordinatorDocument::kDecisionFieldName << decision.toBSON());
 
-            return entry;
-        }()});
-        return updateOp.serialize({});
-    }());
+        entry.setQ(BSON(TransactionCoordinatorDocument::kIdFieldName
+                        << sessionInfo.toBSON() << "$and"
+                        << buildParticipantListMatchesConditions(participantList) << "$or"
+                        << BSON_ARRAY(noDecision << sameDecision)));
 
-    const auto commandReply = commandResponse->getCommandReply();
-    uassertStatusOK(getStatusFromWriteCommandReply(commandReply));
+        entry.setU([&] {
+            TransactionCoordinatorDocument doc;
+            doc.setId(sessionInfo);
+            doc.setParticipants(participantList);
+            doc.setDecision(decision);
+            return doc.toBSON();
+        }());
+
+        return entry;
+    }();
+
+    auto opTime = DecisionWriteBatcher::get(opCtx->getServiceContext()).write(opCtx, entry);
+    if (!opTime) {
+        // This update or another one in its batch did not match, or the batched write failed, so
+        // write the decision on its own to find out whether this one matches.
+        DBDirectClient client(opCtx);
+
+        // Throws if serializing the request or deserializing the response fails.
+        const auto commandResponse = client.runCommand([&] {
+            write_ops::Update updateOp(NamespaceString::kTransactionCoordinatorsNamespace);
+            updateOp.setUpdates({entry});
+            return updateOp.serialize({});
+        }());
+
+        const auto commandReply = commandResponse->getCommandReply();
+        uassertStatusOK(getStatusFromWriteCommandReply(commandReply));
+
+        // If no document matched, throw an anonymous error. (The update itself will not have
+        // thrown an error, because it's legal for an update to match no documents.)
+        if (commandReply.getIntField("n") != 1) {
+            // Attempt to include the document for this (lsid, txnNumber) in the error message, if
+            // one exists. Note that this is best-effort: the document may have been deleted or
+            // manually changed since the update above ran.
+            const auto doc = client.findOne(
+                NamespaceString::kTransactionCoordinatorsNamespace.ns(),
+                QUERY(TransactionCoordinatorDocument::kIdFieldName << sessionInfo.toBSON()));
+            uasserted(51026,
+                      str::stream()
+                          << "While attempting to write decision "
+                          << (isCommit ? "'commit'" : "'abort'") << " for" << lsid.getId() << ':'
+                          << txnNumber
+                          << ", either failed to find document for this lsid:txnNumber or "
+                             "document existed with a different participant list, decision "
+                             "or commitTimestamp: "
+                          << doc);
+        }
 
-    // If no document matched, throw an anonymous error. (The update itself will not have thrown an
-    // error, because it's legal for an update to match no documents.)
-    if (commandReply.getIntField("n") != 1) {
-        // Attempt to include the document for this (lsid, txnNumber) in the error message, if one
-        // exists. Note that this is best-effort: the document may have been deleted or manually
-        // changed since the update above ran.
-        const auto doc = client.findOne(
-            NamespaceString::kTransactionCoordinatorsNamespace.ns(),
-            QUERY(TransactionCoordinatorDocument::kIdFieldName << sessionInfo.toBSON()));
-        uasserted(51026,
-                  str::stream() << "While attempting to write decision "
-                                << (isCommit ? "'commit'" : "'abort'") << " for" << lsid.getId()
-                                << ':' << txnNumber
-                                << ", either failed to find document for this lsid:txnNumber or "
-                                   "document existed with a different participant list, decision "
-                                   "or commitTimestamp: "
-                                << doc);
+        opTime = repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp();
     }
 
     LOGV2_DEBUG(22469,
@@ -372,7 +484,7 @@ repl::OpTime persistDecisionBlocking(OperationContext* opCtx,
                 "txnIdToString_lsid_txnNumber"_attr = txnIdToString(lsid, txnNumber),
                 "isCommit_commit_abort"_attr = (isCommit ? "commit" : "abort"));
 
-    return repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp();
+    return *opTime;
 }
 }  // namespace
 
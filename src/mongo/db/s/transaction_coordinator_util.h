@@ -29,11 +29,16 @@
 
 #pragma once
 
+#include <deque>
+#include <memory>
 #include <vector>
 
+#include "mongo/db/ops/write_ops_gen.h"
 #include "mongo/db/repl/optime.h"
 #include "mongo/db/s/transaction_coordinator_document_gen.h"
 #include "mongo/db/s/transaction_coordinator_futures_util.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
 
 namespace mongo {
 namespace txn {
@@ -135,6 +140,61 @@ Future<repl::OpTime> persistDecision(txn::AsyncWorkScheduler& scheduler,
                                      const txn::ParticipantsList& participants,
                                      const txn::CoordinatorCommitDecision& decision);
 
+/**
+ * Groups the decision updates of concurrently committing transactions into a single update command
+ * on config.transaction_coordinators (group commit), so that they are applied by one local write
+ * and share the wait for that write to become majority committed.
+ *
+ * The caller which finds no batch being written writes the next one, made of its own update and
+ * those queued behind the previous batch. The other callers wait for the batch holding their update
+ * to complete.
+ */
+class DecisionWriteBatcher {
+public:
+    static DecisionWriteBatcher& get(ServiceContext* service);
+
+    /**
+     * Applies 'update' to config.transaction_coordinators together with the updates of other
+     * concurrent callers. Returns the opTime of the batched write if every update in the batch
+     * matched a document. Otherwise, or if the batched write failed, returns boost::none. The
+     * caller must then apply its update on its own to find out whether it matched. An update
+     * which already matched in the batch will match again, since a decision update also
+     * matches a document that already has the same decision.
+     */
+    boost::optional<repl::OpTime> write(OperationContext* opCtx, write_ops::UpdateOpEntry update);
+
+    /**
+     * Returns the number of updates queued behind the batch being written.
+     */
+    size_t getNumPendingWrites() const;
+
+    /**
+     * Returns the number of batches written so far.
+     */
+    long long getNumBatchesWritten() const;
+
+private:
+    struct PendingWrite {
+        write_ops::UpdateOpEntry update;
+
+        // Set once the batch holding the update has been written, along with the opTime of the
+        // write if every update in the batch matched a document.
+        bool done{false};
+        boost::optional<repl::OpTime> opTime;
+    };
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("DecisionWriteBatcher::_mutex");
+
+    // Notified each time a batch has been written.
+    stdx::condition_variable _batchWrittenCV;
+
+    // Updates waiting for the batch being written to complete, in arrival order.
+    std::deque<std::shared_ptr<PendingWrite>> _pendingWrites;
+
+    bool _writeInProgress{false};
+    long long _numBatchesWritten{0};
+};
+
 /**
  * Sends commit to all shards and returns a future that will be resolved when all participants have
  * responded with success.
@@ -33,8 +33,10 @@
 
 #include "mongo/db/s/wait_for_majority_service.h"
 
+#include <algorithm>
 #include <utility>
 
+#include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/write_concern.h"
 #include "mongo/executor/network_interface_factory.h"
@@ -162,22 +164,30 @@ void WaitForMajorityService::_periodicallyWaitForMajority(ServiceContext* servic
 
             lk.lock();
 
-            if (status.isOK()) {
-                _lastOpTimeWaited = lowestOpTime;
-            }
-
             if (status == ErrorCodes::WaitForMajorityServiceEarlierOpTimeAvailable) {
                 _opCtx = nullptr;
                 continue;
             }
 
             if (status.isOK()) {
-                lowestOpTimeIter->second.emplaceValue();
+                // Every queued opTime up to the current majority commit point is now majority
+                // committed as well, so complete them all at once instead of waiting for each of
+                // them in turn. This lets the concurrent writers of the queued opTimes (such as
+                // transaction coordinators persisting their decisions) share a single wait.
+                auto const replCoord = repl::ReplicationCoordinator::get(service);
+                const auto committedOpTime =
+                    std::max(lowestOpTime, replCoord->getCurrentCommittedSnapshotOpTime());
+                _lastOpTimeWaited = committedOpTime;
+
+                while (!_queuedOpTimes.empty() &&
+                       _queuedOpTimes.begin()->first <= committedOpTime) {
+                    _queuedOpTimes.begin()->second.emplaceValue();
+                    _queuedOpTimes.erase(_queuedOpTimes.begin());
+                }
             } else {
                 lowestOpTimeIter->second.setError(status);
+                _queuedOpTimes.erase(lowestOpTimeIter);
             }
-
-            _queuedOpTimes.erase(lowestOpTimeIter);
         }
 
         try {
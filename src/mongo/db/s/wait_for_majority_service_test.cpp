@@ -38,13 +38,36 @@
 namespace mongo {
 namespace {
 
+/**
+ * Reports the last opTime which the test let the service wait for as the majority commit point,
+ * unless the test has advanced the commit point beyond it.
+ */
+class CommittedSnapshotReplicationCoordinatorMock : public repl::ReplicationCoordinatorMock {
+public:
+    CommittedSnapshotReplicationCoordinatorMock(ServiceContext* service,
+                                                std::function<repl::OpTime()> getCommittedOpTime)
+        : repl::ReplicationCoordinatorMock(service),
+          _getCommittedOpTime(std::move(getCommittedOpTime)) {}
+
+    repl::OpTime getCurrentCommittedSnapshotOpTime() const override {
+        return _getCommittedOpTime();
+    }
+
+private:
+    std::function<repl::OpTime()> _getCommittedOpTime;
+};
+
 class WaitForMajorityServiceTest : public ServiceContextMongoDTest {
 public:
     void setUp() override {
         auto service = getServiceContext();
         waitService()->setUp(service);
 
-        auto replCoord = std::make_unique<repl::ReplicationCoordinatorMock>(service);
+        auto replCoord =
+            std::make_unique<CommittedSnapshotReplicationCoordinatorMock>(service, [this] {
+                stdx::lock_guard<Latch> lk(_mutex);
+                return std::max(_lastOpTimeWaited, _committedOpTime);
+            });
 
         replCoord->setAwaitReplicationReturnValueFunction(
             [this](OperationContext* opCtx, const repl::OpTime& opTime) {
@@ -105,6 +128,16 @@ public:
         _callCountChangedCV.wait(lk, [&] { return _waitForMajorityCallCount > expectedCount; });
     }
 
+    int getWaitForMajorityCallCount() {
+        stdx::lock_guard<Latch> lk(_mutex);
+        return _waitForMajorityCallCount;
+    }
+
+    void advanceCommittedOpTime(const repl::OpTime& opTime) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _committedOpTime = opTime;
+    }
+
 private:
     WaitForMajorityService _waitForMajorityService;
 
@@ -115,6 +148,7 @@ private:
 
     bool _isTestReady{false};
     repl::OpTime _lastOpTimeWaited;
+    repl::OpTime _committedOpTime;
     int _waitForMajorityCallCount{0};
 };
 
@@ -236,6 +270,35 @@ TEST_F(WaitForMajorityServiceTest, WaitWithOpTimeEarlierThanOpTimeAlreadyWaited)
     ASSERT_EQ(t2, getLastOpTimeWaited());
 }
 
+TEST_F(WaitForMajorityServiceTest, CompletesAllQueuedOpTimesUpToMajorityCommitPoint) {
+    repl::OpTime t1(Timestamp(1, 0), 2);
+    repl::OpTime t2(Timestamp(5, 0), 2);
+    repl::OpTime t3(Timestamp(14, 0), 2);
+
+    auto future1 = waitService()->waitUntilMajority(t1);
+    auto future2 = waitService()->waitUntilMajority(t2);
+    auto future3 = waitService()->waitUntilMajority(t3);
+
+    waitForMajorityCallCountGreaterThan(0);
+
+    // By the time the wait for 't1' returns, the majority commit point has already moved past 't2'.
+    advanceCommittedOpTime(t2);
+    finishWaitingOneOpTime();
+
+    future1.get();
+    future2.get();
+    ASSERT_FALSE(future3.isReady());
+
+    // Requests at or below the commit point are satisfied without queueing another wait.
+    waitService()->waitUntilMajority(repl::OpTime(Timestamp(3, 0), 2)).get();
+
+    finishWaitingOneOpTime();
+    future3.get();
+
+    ASSERT_EQ(t3, getLastOpTimeWaited());
+    ASSERT_EQ(2, getWaitForMajorityCallCount());
+}
+
 TEST_F(WaitForMajorityServiceTest, ShutdownShouldCancelQueuedRequests) {
     repl::OpTime t1(Timestamp(5, 0), 2);
     repl::OpTime t2(Timestamp(14, 0), 2);
@@ -211,6 +211,18 @@ BSONObj FlowControl::generateSection(OperationContext* opCtx,
     bob.append("isLaggedCount", _isLaggedCount.load());
     bob.append("isLaggedTimeMicros", _isLaggedTimeMicros.load());
 
+    {
+        BSONObjBuilder namespacesBob(bob.subobjStart("throttledNamespaces"));
+        stdx::lock_guard<Latch> lk(_namespaceMutex);
+        for (auto&& [ns, throttled] : _throttledNamespaces) {
+            BSONObjBuilder nsBob(namespacesBob.subobjStart(ns));
+            nsBob.append("budget", throttled.budget);
+            nsBob.append("costShare", throttled.costShare);
+            nsBob.append("opsLastPeriod", throttled.lastPeriod.ops);
+            nsBob.append("costLastPeriod", throttled.lastPeriod.cost);
+        }
+    }
+
     return bob.obj();
 }
 
@@ -333,6 +345,7 @@ int FlowControl::getNumTickets() {
         gFlowControlEnabled.load() == false || canAcceptWrites == false || locksPerOp < 0.0) {
         _trimSamples(std::min(lastCommitted.opTime.getTimestamp(),
                               getMedianAppliedTimestamp(_prevMemberData)));
+        _updateNamespaceBudgets(false);
         return _kMaxTickets;
     }
 
@@ -422,10 +435,119 @@ int FlowControl::getNumTickets() {
 
     _trimSamples(
         std::min(lastCommitted.opTime.getTimestamp(), getMedianAppliedTimestamp(_prevMemberData)));
+    _updateNamespaceBudgets(_isLagged.load());
 
     return ret;
 }
 
+std::int64_t FlowControl::writeCost(std::int64_t numDocs,
+                                    std::int64_t bytes,
+                                    std::int64_t numIndexes) {
+    return numDocs * (1 + numIndexes) + bytes / gFlowControlWriteCostBytesPerUnit.load();
+}
+
+void FlowControl::recordWrite(const NamespaceString& nss, std::int64_t cost) {
+    if (!gFlowControlNamespaceThrottling.load()) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_namespaceMutex);
+    _namespaceUsage[nss.ns()].cost += cost;
+}
+
+void FlowControl::waitForNamespaceBudget(OperationContext* opCtx, const NamespaceString& nss) {
+    if (!gFlowControlNamespaceThrottling.load()) {
+        return;
+    }
+
+    std::shared_ptr<FlowControlTicketholder> tickets;
+    {
+        stdx::lock_guard<Latch> lk(_namespaceMutex);
+        _namespaceUsage[nss.ns()].ops++;
+        auto it = _throttledNamespaces.find(nss.ns());
+        if (it == _throttledNamespaces.end()) {
+            return;
+        }
+        tickets = it->second.tickets;
+    }
+
+    FlowControlTicketholder::CurOp stats;
+    tickets->getTicket(opCtx, &stats);
+}
+
+void FlowControl::_updateNamespaceBudgets(bool isLagged) {
+    stdx::lock_guard<Latch> lk(_namespaceMutex);
+    auto usage = std::exchange(_namespaceUsage, {});
+    auto prevThrottled = std::exchange(_throttledNamespaces, {});
+
+    std::int64_t totalCost = 0;
+    for (auto&& entry : usage) {
+        totalCost += entry.second.cost;
+    }
+
+    if (isLagged && totalCost > 0 && gFlowControlNamespaceThrottling.load()) {
+        const double shareThreshold = gFlowControlNamespaceShareThreshold.load();
+        const int minTickets = std::max(1, gFlowControlMinTicketsPerSecond.load());
+
+        for (auto&& [ns, nsUsage] : usage) {
+            const double costShare = static_cast<double>(nsUsage.cost) / totalCost;
+            auto prev = prevThrottled.find(ns);
+            const bool wasThrottled = prev != prevThrottled.end();
+            if (costShare <= shareThreshold && !wasThrottled) {
+                continue;
+            }
+
+            int budget;
+            if (costShare > shareThreshold) {
+                // Scale the namespace's operation rate down to what would have kept its share of
+                // the write cost at the threshold.
+                budget = multiplyWithOverflowCheck(
+                    nsUsage.ops, shareThreshold / costShare, _kMaxTickets);
+            } else {
+                // The namespace is back under its share while the set is still lagged. Ramp its
+                // budget up the same way the global ticket count recovers.
+                budget = multiplyWithOverflowCheck(prev->second.budget +
+                                                       gFlowControlTicketAdderConstant.load(),
+                                                   gFlowControlTicketMultiplierConstant.load(),
+                                                   _kMaxTickets);
+            }
+            budget = std::max(budget, minTickets);
+
+            ThrottledNamespace throttled;
+            if (wasThrottled) {
+                throttled.tickets = std::move(prev->second.tickets);
+                throttled.tickets->refreshTo(budget);
+                prevThrottled.erase(prev);
+            } else {
+                throttled.tickets = std::make_shared<FlowControlTicketholder>(budget);
+                LOGV2(4938300,
+                      "Flow control is throttling writes to a namespace",
+                      "namespace"_attr = ns,
+                      "costShare"_attr = costShare,
+                      "budget"_attr = budget);
+            }
+            throttled.budget = budget;
+            throttled.costShare = costShare;
+            throttled.lastPeriod = nsUsage;
+            _throttledNamespaces.emplace(ns, std::move(throttled));
+        }
+    }
+
+    // Release any writers still waiting on namespaces that are no longer throttled.
+    for (auto&& entry : prevThrottled) {
+        entry.second.tickets->refreshTo(_kMaxTickets);
+        LOGV2(4938301,
+              "Flow control stopped throttling writes to a namespace",
+              "namespace"_attr = entry.first);
+    }
+}
+
+int FlowControl::_getNamespaceBudget_forTest(const NamespaceString& nss) const {
+    stdx::lock_guard<Latch> lk(_namespaceMutex);
+    auto it = _throttledNamespaces.find(nss.ns());
+    return it == _throttledNamespaces.end() ? -1 : it->second.budget;
+}
+
 std::int64_t FlowControl::_approximateOpsBetween(Timestamp prevTs, Timestamp currTs) {
     std::int64_t prevApplied = -1;
     std::int64_t currApplied = -1;
@@ -32,12 +32,15 @@
 #include <deque>
 
 #include "mongo/db/commands/server_status.h"
+#include "mongo/db/concurrency/flow_control_ticketholder.h"
+#include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/repl/member_data.h"
 #include "mongo/db/repl/replication_coordinator_fwd.h"
 #include "mongo/db/service_context.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -74,6 +77,26 @@ public:
      */
     void sample(Timestamp timestamp, std::uint64_t opsApplied);
 
+    /**
+     * Returns the cost of writing `numDocs` documents totalling `bytes` bytes to a collection with
+     * `numIndexes` indexes, as used for attributing write cost to namespaces.
+     */
+    static std::int64_t writeCost(std::int64_t numDocs,
+                                  std::int64_t bytes,
+                                  std::int64_t numIndexes);
+
+    /**
+     * Attributes `cost` units of write cost to `nss` for the current flow control period. This is
+     * a no-op unless namespace throttling is enabled.
+     */
+    void recordWrite(const NamespaceString& nss, std::int64_t cost);
+
+    /**
+     * Called before a write operation on `nss` takes any locks. Blocks until `nss` has budget
+     * left in the current period if flow control is throttling writes to it.
+     */
+    void waitForNamespaceBudget(OperationContext* opCtx, const NamespaceString& nss);
+
     /**
      * <ServerStatusSection>
      */
@@ -104,6 +127,15 @@ public:
                                    std::uint64_t thresholdLagMillis);
     void _trimSamples(const Timestamp trimSamplesTo);
 
+    /**
+     * Recomputes the per-namespace write budgets from the write cost recorded during the last
+     * period. Namespaces are only throttled while the replica set is lagged.
+     */
+    void _updateNamespaceBudgets(bool isLagged);
+
+    // Returns the budget of a throttled namespace, or -1 if writes to it are not throttled.
+    int _getNamespaceBudget_forTest(const NamespaceString& nss) const;
+
     // Sample of (timestamp, ops, lock acquisitions) where ops and lock acquisitions are
     // observations of the corresponding counter at (roughly) <timestamp>.
     typedef std::tuple<std::uint64_t, std::uint64_t, std::int64_t> Sample;
@@ -112,6 +144,20 @@ public:
     }
 
 private:
+    // Write operations and write cost attributed to a namespace during a flow control period.
+    struct NamespaceUsage {
+        std::int64_t ops = 0;
+        std::int64_t cost = 0;
+    };
+
+    // A namespace whose writes flow control currently limits to `budget` operations per period.
+    struct ThrottledNamespace {
+        std::shared_ptr<FlowControlTicketholder> tickets;
+        int budget = 0;
+        double costShare = 0.0;
+        NamespaceUsage lastPeriod;
+    };
+
     const int _kMaxTickets = 1000 * 1000 * 1000;
     repl::ReplicationCoordinator* _replCoord;
 
@@ -142,6 +188,10 @@ private:
     // This value is used for calculating server status metrics.
     std::uint64_t _startWaitTime = 0;
 
+    mutable Mutex _namespaceMutex = MONGO_MAKE_LATCH("FlowControl::_namespaceMutex");
+    StringMap<NamespaceUsage> _namespaceUsage;
+    StringMap<ThrottledNamespace> _throttledNamespaces;
+
     PeriodicJobAnchor _jobAnchor;
 };
 
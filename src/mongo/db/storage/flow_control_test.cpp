@@ -39,6 +39,7 @@
 #include "mongo/db/storage/flow_control.h"
 #include "mongo/db/storage/flow_control_parameters_gen.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -245,4 +246,50 @@ TEST_F(FlowControlTest, CalculatingTickets) {
                                                       currLag,
                                                       thresholdLag));
 }
+
+TEST_F(FlowControlTest, ThrottlingNamespaces) {
+    gFlowControlNamespaceThrottling.store(true);
+    ON_BLOCK_EXIT([] { gFlowControlNamespaceThrottling.store(false); });
+
+    const NamespaceString noisyNss("test.noisy");
+    const NamespaceString quietNss("test.quiet");
+    auto recordWrites = [&](const NamespaceString& nss, int numOps, std::int64_t costPerOp) {
+        for (int idx = 0; idx < numOps; ++idx) {
+            flowControl->waitForNamespaceBudget(opCtx.get(), nss);
+            flowControl->recordWrite(nss, costPerOp);
+        }
+    };
+
+    // The noisy namespace accounts for 90% of the write cost. Its operation rate is scaled down
+    // to what would have kept its share at the 50% threshold.
+    recordWrites(noisyNss, 1000, 9);
+    recordWrites(quietNss, 100, 10);
+    flowControl->_updateNamespaceBudgets(true);
+    ASSERT_EQ(555, flowControl->_getNamespaceBudget_forTest(noisyNss));
+    ASSERT_EQ(-1, flowControl->_getNamespaceBudget_forTest(quietNss));
+
+    // Once back under the threshold while still lagged, the budget ramps up instead of being
+    // lifted outright.
+    recordWrites(noisyNss, 100, 1);
+    recordWrites(quietNss, 100, 10);
+    flowControl->_updateNamespaceBudgets(true);
+    ASSERT_EQ(static_cast<int>((555 + gFlowControlTicketAdderConstant.load()) *
+                               gFlowControlTicketMultiplierConstant.load()),
+              flowControl->_getNamespaceBudget_forTest(noisyNss));
+
+    // Namespaces are no longer throttled when the replica set is not lagged.
+    recordWrites(noisyNss, 1000, 9);
+    flowControl->_updateNamespaceBudgets(false);
+    ASSERT_EQ(-1, flowControl->_getNamespaceBudget_forTest(noisyNss));
+}
+
+TEST_F(FlowControlTest, WriteCost) {
+    gFlowControlWriteCostBytesPerUnit.store(1024);
+    ON_BLOCK_EXIT([] { gFlowControlWriteCostBytesPerUnit.store(16 * 1024); });
+
+    // One unit per document plus one per index, and one unit per 1KB written.
+    ASSERT_EQ(1, FlowControl::writeCost(1, 100, 0));
+    ASSERT_EQ(3, FlowControl::writeCost(1, 100, 2));
+    ASSERT_EQ(2 * 3 + 4, FlowControl::writeCost(2, 4 * 1024, 2));
+}
 }  // namespace mongo
@@ -0,0 +1,175 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_cursor_cache_stats.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+
+namespace mongo {
+
+namespace {
+// The number of tables listed in serverStatus, ordered by their number of cursor cache misses.
+const size_t kMaxReportedTables = 10;
+
+// Tables on which no cursor has been requested for this long are forgotten. Checked at most once
+// per kTableAgingInterval, so that merging does not scan all tables each time.
+const Minutes kTableIdleTime{10};
+const Minutes kTableAgingInterval{1};
+
+// The hottest tables snapshot is rebuilt at most this often when only the counters have changed.
+const Seconds kHottestTablesRefreshInterval{1};
+
+WiredTigerCursorCacheStats globalCursorCacheStats;
+}  // namespace
+
+WiredTigerCursorCacheStats& WiredTigerCursorCacheStats::get() {
+    return globalCursorCacheStats;
+}
+
+void WiredTigerCursorCacheStats::merge(const TableStatsMap& sessionStats, Date_t now) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    // Whether a table was added to or removed from the ones eligible for the hottest tables.
+    bool tablesChanged = false;
+    for (auto&& [tableId, sessionTable] : sessionStats) {
+        auto& table = _tables[tableId];
+        if (!sessionTable.uri.empty()) {
+            tablesChanged = tablesChanged || table.uri.empty();
+            table.uri = sessionTable.uri;
+            table.config = sessionTable.config;
+        }
+        table.hits += sessionTable.hits;
+        table.misses += sessionTable.misses;
+        table.lastRequested = now;
+        _hits += sessionTable.hits;
+        _misses += sessionTable.misses;
+    }
+
+    if (now - _lastAged >= kTableAgingInterval) {
+        _lastAged = now;
+        for (auto it = _tables.begin(); it != _tables.end();) {
+            if (now - it->second.lastRequested >= kTableIdleTime) {
+                tablesChanged = tablesChanged || !it->second.uri.empty();
+                _tables.erase(it++);
+            } else {
+                ++it;
+            }
+        }
+    }
+    _numTables.store(_tables.size());
+
+    if (tablesChanged || now - _lastRefreshedHottestTables >= kHottestTablesRefreshInterval) {
+        _refreshHottestTables(lk, now);
+    }
+}
+
+void WiredTigerCursorCacheStats::onTableDropped(const std::string& uri) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    for (auto it = _tables.begin(); it != _tables.end();) {
+        if (it->second.uri == uri) {
+            _tables.erase(it++);
+        } else {
+            ++it;
+        }
+    }
+    _numTables.store(_tables.size());
+    _refreshHottestTables(lk, Date_t::now());
+}
+
+std::shared_ptr<const WiredTigerCursorCacheStats::HottestTables>
+WiredTigerCursorCacheStats::hottestTables() const {
+    stdx::lock_guard<Latch> lk(_hottestTablesMutex);
+    return _hottestTables;
+}
+
+void WiredTigerCursorCacheStats::_refreshHottestTables(WithLock, Date_t now) {
+    _lastRefreshedHottestTables = now;
+
+    std::vector<TableStatsMap::const_pointer> byRequests;
+    for (auto&& entry : _tables) {
+        if (!entry.second.uri.empty()) {
+            byRequests.push_back(&entry);
+        }
+    }
+
+    auto numHottest = std::min(byRequests.size(), kMaxHottestTables);
+    std::partial_sort(byRequests.begin(),
+                      byRequests.begin() + numHottest,
+                      byRequests.end(),
+                      [](TableStatsMap::const_pointer lhs, TableStatsMap::const_pointer rhs) {
+                          return lhs->second.hits + lhs->second.misses >
+                              rhs->second.hits + rhs->second.misses;
+                      });
+
+    auto hottest = std::make_shared<HottestTables>();
+    hottest->reserve(numHottest);
+    for (size_t i = 0; i < numHottest; ++i) {
+        hottest->push_back(*byRequests[i]);
+    }
+
+    stdx::lock_guard<Latch> lk(_hottestTablesMutex);
+    _hottestTables = std::move(hottest);
+}
+
+void WiredTigerCursorCacheStats::appendStats(BSONObjBuilder* builder) const {
+    std::vector<const TableStats*> byMisses;
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    for (auto&& entry : _tables) {
+        if (!entry.second.uri.empty()) {
+            byMisses.push_back(&entry.second);
+        }
+    }
+
+    auto numReported = std::min(byMisses.size(), kMaxReportedTables);
+    std::partial_sort(byMisses.begin(),
+                      byMisses.begin() + numReported,
+                      byMisses.end(),
+                      [](const TableStats* lhs, const TableStats* rhs) {
+                          return lhs->misses > rhs->misses;
+                      });
+
+    builder->append("hits", _hits);
+    builder->append("misses", _misses);
+    builder->append("tables", static_cast<long long>(_tables.size()));
+
+    BSONArrayBuilder tablesBuilder(builder->subarrayStart("mostMissedTables"));
+    for (size_t i = 0; i < numReported; ++i) {
+        BSONObjBuilder tableBuilder(tablesBuilder.subobjStart());
+        tableBuilder.append("uri", byMisses[i]->uri);
+        tableBuilder.append("hits", byMisses[i]->hits);
+        tableBuilder.append("misses", byMisses[i]->misses);
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,149 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * Process-wide hit and miss counters for the cursor caches of all WiredTigerSessions, broken down
+ * by table.
+ *
+ * Sessions count their hits and misses locally and fold them in here in batches, so the shared
+ * state is only touched once every so many cursor requests per session rather than on each one.
+ * The counters reported may therefore lag slightly behind the actual cursor cache activity.
+ *
+ * Tables on which no cursor has been requested for ten minutes are forgotten, so that the tables
+ * tracked are the recently used ones. The hit and miss totals still include them.
+ *
+ * The most frequently requested tables are kept in a separate snapshot for cursor cache warm-up,
+ * which every new session reads. It is rebuilt when tables are added or forgotten, and otherwise at
+ * most once a second, so that new sessions neither sort all tables nor wait on merges.
+ */
+class WiredTigerCursorCacheStats {
+    WiredTigerCursorCacheStats(const WiredTigerCursorCacheStats&) = delete;
+    WiredTigerCursorCacheStats& operator=(const WiredTigerCursorCacheStats&) = delete;
+
+public:
+    struct TableStats {
+        // The uri and cursor configuration the table's cursors were last opened with. Empty until
+        // a miss on the table has been recorded.
+        std::string uri;
+        std::string config;
+        long long hits = 0;
+        long long misses = 0;
+        // When the counters of a session that requested a cursor on the table were last merged.
+        Date_t lastRequested;
+    };
+
+    using TableStatsMap = stdx::unordered_map<uint64_t, TableStats>;
+    using HottestTables = std::vector<std::pair<uint64_t, TableStats>>;
+
+    // The number of tables kept in the hottestTables() snapshot. Matches the largest accepted
+    // value of wiredTigerCursorCacheWarmTables.
+    static constexpr size_t kMaxHottestTables = 1000;
+
+    WiredTigerCursorCacheStats() = default;
+
+    static WiredTigerCursorCacheStats& get();
+
+    /**
+     * Adds the counters accumulated by a single session, keyed by table id, and forgets the tables
+     * that have not been requested recently as of 'now'.
+     */
+    void merge(const TableStatsMap& sessionStats, Date_t now);
+
+    /**
+     * Forgets about the table with the given uri, so that it is no longer reported or picked for
+     * cursor cache warm-up.
+     */
+    void onTableDropped(const std::string& uri);
+
+    /**
+     * Returns the number of tables on which a cursor was recently requested from a cursor cache.
+     * Does not take the mutex.
+     */
+    size_t numTables() const {
+        return _numTables.load();
+    }
+
+    /**
+     * Returns up to kMaxHottestTables tables with a known uri, most frequently requested first, as
+     * of the last time the snapshot was rebuilt. Does not take the mutex guarding the counters.
+     */
+    std::shared_ptr<const HottestTables> hottestTables() const;
+
+    /**
+     * Appends the totals and the tables that missed the cursor caches most often to 'builder'.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    /**
+     * Rebuilds the snapshot returned by hottestTables() from _tables.
+     */
+    void _refreshHottestTables(WithLock, Date_t now);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerCursorCacheStats::_mutex");
+    TableStatsMap _tables;
+
+    // Totals over all tables, including the ones that have since been forgotten.
+    long long _hits = 0;
+    long long _misses = 0;
+
+    // When _tables was last checked for tables that have not been requested recently.
+    Date_t _lastAged;
+
+    // Mirrors _tables.size() so that it can be read without taking the mutex.
+    AtomicWord<size_t> _numTables{0};
+
+    // When the hottestTables() snapshot was last rebuilt. Guarded by _mutex.
+    Date_t _lastRefreshedHottestTables;
+
+    // Guards only the pointer to the snapshot, so that readers do not contend with merges.
+    mutable Mutex _hottestTablesMutex =
+        MONGO_MAKE_LATCH("WiredTigerCursorCacheStats::_hottestTablesMutex");
+    std::shared_ptr<const HottestTables> _hottestTables = std::make_shared<HottestTables>();
+};
+
+}  // namespace mongo
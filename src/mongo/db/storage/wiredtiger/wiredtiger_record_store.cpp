@@ -725,7 +725,14 @@ StatusWith<std::string> WiredTigerRecordStore::generateCreateString(
         ss << "prefix_compression,";
     }
 
-    ss << "block_compressor=" << wiredTigerGlobalOptions.collectionBlockCompressor << ",";
+    // The oplog is append-only and read mostly by tailing cursors, so it may be worth compressing
+    // harder than the collections are.
+    const bool useOplogBlockCompressor =
+        NamespaceString::oplog(ns) && !wiredTigerGlobalOptions.oplogBlockCompressor.empty();
+    ss << "block_compressor="
+       << (useOplogBlockCompressor ? wiredTigerGlobalOptions.oplogBlockCompressor
+                                   : wiredTigerGlobalOptions.collectionBlockCompressor)
+       << ",";
 
     ss << WiredTigerCustomizationHooks::get(getGlobalServiceContext())->getTableCreateConfig(ns);
 
@@ -33,8 +33,13 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 
+#include <algorithm>
 #include <memory>
 
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
 #include "mongo/base/error_codes.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/global_settings.h"
@@ -45,6 +50,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
@@ -78,12 +84,21 @@ WiredTigerSession::WiredTigerSession(WT_CONNECTION* conn,
 }
 
 WiredTigerSession::~WiredTigerSession() {
+    _flushCursorCacheStats();
     if (_session) {
         invariantWTOK(_session->close(_session, nullptr));
     }
 }
 
 namespace {
+// The number of cursor cache requests a session serves before folding its counters into the global
+// WiredTigerCursorCacheStats.
+const uint32_t kCursorCacheStatsFlushInterval = 256;
+
+// Upper bound on the cursor cache size when it scales with the number of recently used tables.
+// Lookups in the cursor cache are linear in its size.
+const size_t kMaxTableScaledCursorCacheSize = 1000;
+
 void _openCursor(WT_SESSION* session,
                  const std::string& uri,
                  const char* config,
@@ -117,12 +132,17 @@ void _openCursor(WT_SESSION* session,
 WT_CURSOR* WiredTigerSession::getCachedCursor(const std::string& uri,
                                               uint64_t id,
                                               const char* config) {
+    if (++_cursorCacheRequests >= kCursorCacheStatsFlushInterval) {
+        _flushCursorCacheStats();
+    }
+
     // Find the most recently used cursor
     for (CursorCache::iterator i = _cursors.begin(); i != _cursors.end(); ++i) {
         if (i->_id == id) {
             WT_CURSOR* c = i->_cursor;
             _cursors.erase(i);
             _cursorsOut++;
+            _cursorCacheHits.push_back(id);
             return c;
         }
     }
@@ -130,9 +150,51 @@ WT_CURSOR* WiredTigerSession::getCachedCursor(const std::string& uri,
     WT_CURSOR* cursor = nullptr;
     _openCursor(_session, uri, config, &cursor);
     _cursorsOut++;
+    auto& tableStats = _cursorCacheStats[id];
+    tableStats.misses++;
+    if (tableStats.uri.empty()) {
+        tableStats.uri = uri;
+        tableStats.config = config ? config : "";
+    }
     return cursor;
 }
 
+void WiredTigerSession::_warmCursorCache(size_t numTables) {
+    auto hottestTables = WiredTigerCursorCacheStats::get().hottestTables();
+    numTables = std::min(numTables, hottestTables->size());
+    for (auto it = hottestTables->begin(); it != hottestTables->begin() + numTables; ++it) {
+        const auto& [id, table] = *it;
+        WT_CURSOR* cursor = nullptr;
+        int ret = _session->open_cursor(
+            _session, table.uri.c_str(), nullptr, table.config.c_str(), &cursor);
+        if (ret != 0) {
+            // The table may have been dropped, or be locked by a verify or salvage. Warming the
+            // cache is only an optimization, so leave it to the first operation on the table.
+            continue;
+        }
+        _cursors.push_front(WiredTigerCachedCursor(id, _cursorGen++, cursor));
+    }
+}
+
+void WiredTigerSession::_flushCursorCacheStats() {
+    _cursorCacheRequests = 0;
+
+    // Sorting groups the hits on each table, so they are counted with one lookup per table.
+    std::sort(_cursorCacheHits.begin(), _cursorCacheHits.end());
+    for (auto it = _cursorCacheHits.begin(); it != _cursorCacheHits.end();) {
+        auto end = std::upper_bound(it, _cursorCacheHits.end(), *it);
+        _cursorCacheStats[*it].hits += end - it;
+        it = end;
+    }
+    _cursorCacheHits.clear();
+
+    if (_cursorCacheStats.empty()) {
+        return;
+    }
+    WiredTigerCursorCacheStats::get().merge(_cursorCacheStats, Date_t::now());
+    _cursorCacheStats.clear();
+}
+
 WT_CURSOR* WiredTigerSession::getNewCursor(const std::string& uri, const char* config) {
     WT_CURSOR* cursor = nullptr;
     _openCursor(_session, uri, config, &cursor);
@@ -152,6 +214,12 @@ void WiredTigerSession::releaseCursor(uint64_t id, WT_CURSOR* cursor) {
 
     // A negative value for wiredTigercursorCacheSize means to use hybrid caching.
     std::uint32_t cacheSize = abs(gWiredTigerCursorCacheSize.load());
+    if (gWiredTigerCursorCacheScaleWithTables.load()) {
+        cacheSize = std::max<std::uint32_t>(
+            cacheSize,
+            std::min(WiredTigerCursorCacheStats::get().numTables(),
+                     kMaxTableScaledCursorCacheSize));
+    }
 
     while (!_cursors.empty() && _cursorGen - _cursors.back()._gen > cacheSize) {
         cursor = _cursors.back()._cursor;
@@ -206,11 +274,30 @@ uint64_t WiredTigerSession::genTableId() {
 
 // -----------------------
 
+namespace {
+// Upper bound on the number of session cache shards when the number is derived from the number of
+// available cores.
+const size_t kMaxDefaultSessionCacheShards = 64;
+
+size_t numSessionCacheShards() {
+    if (gWiredTigerSessionCacheShards > 0) {
+        return gWiredTigerSessionCacheShards;
+    }
+    return std::max<size_t>(
+        1, std::min<size_t>(ProcessInfo::getNumAvailableCores(), kMaxDefaultSessionCacheShards));
+}
+
+// Hands out shard slots to threads on platforms where the current CPU cannot be queried.
+AtomicWord<unsigned> nextThreadShardSlot{0};
+}  // namespace
+
 WiredTigerSessionCache::WiredTigerSessionCache(WiredTigerKVEngine* engine)
     : _engine(engine),
       _conn(engine->getConnection()),
       _clockSource(_engine->getClockSource()),
       _shuttingDown(0),
+      _numShards(numSessionCacheShards()),
+      _shards(std::make_unique<SessionShard[]>(_numShards)),
       _prepareCommitOrAbortCounter(0) {}
 
 WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource* cs)
@@ -218,6 +305,8 @@ WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource*
       _conn(conn),
       _clockSource(cs),
       _shuttingDown(0),
+      _numShards(numSessionCacheShards()),
+      _shards(std::make_unique<SessionShard[]>(_numShards)),
       _prepareCommitOrAbortCounter(0) {}
 
 WiredTigerSessionCache::~WiredTigerSessionCache() {
@@ -407,9 +496,11 @@ void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted() {
 
 
 void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors(uri);
+    for (size_t shard = 0; shard < _numShards; ++shard) {
+        stdx::lock_guard<Latch> lock(_shards[shard].lock);
+        for (auto&& session : _shards[shard].sessions) {
+            session->closeAllCursors(uri);
+        }
     }
 }
 
@@ -417,15 +508,21 @@ void WiredTigerSessionCache::closeCursorsForQueuedDrops() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeCursorsForQueuedDrops(_engine);
+    for (size_t shard = 0; shard < _numShards; ++shard) {
+        stdx::lock_guard<Latch> lock(_shards[shard].lock);
+        for (auto&& session : _shards[shard].sessions) {
+            session->closeCursorsForQueuedDrops(_engine);
+        }
     }
 }
 
 size_t WiredTigerSessionCache::getIdleSessionsCount() {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    return _sessions.size();
+    size_t count = 0;
+    for (size_t shard = 0; shard < _numShards; ++shard) {
+        stdx::lock_guard<Latch> lock(_shards[shard].lock);
+        count += _shards[shard].sessions.size();
+    }
+    return count;
 }
 
 void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
@@ -435,34 +532,45 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
     }
 
     auto cutoffTime = _clockSource->now() - Milliseconds(idleTimeMillis);
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        // Discard all sessions that became idle before the cutoff time
-        for (auto it = _sessions.begin(); it != _sessions.end();) {
-            auto session = *it;
-            invariant(session->getIdleExpireTime() != Date_t::min());
-            if (session->getIdleExpireTime() < cutoffTime) {
-                it = _sessions.erase(it);
-                delete (session);
-            } else {
-                ++it;
-            }
+    for (size_t shard = 0; shard < _numShards; ++shard) {
+        SessionCache expired;
+        {
+            stdx::lock_guard<Latch> lock(_shards[shard].lock);
+            auto& sessions = _shards[shard].sessions;
+
+            // Sessions are returned to the back of a shard, so the ones that became idle before
+            // the cutoff time form a prefix of it. Only that prefix needs to be visited.
+            auto firstLive = std::find_if(sessions.begin(), sessions.end(), [&](auto session) {
+                invariant(session->getIdleExpireTime() != Date_t::min());
+                return session->getIdleExpireTime() >= cutoffTime;
+            });
+            expired.assign(sessions.begin(), firstLive);
+            sessions.erase(sessions.begin(), firstLive);
+        }
+
+        // Close the sessions outside of the shard lock.
+        for (auto session : expired) {
+            delete session;
         }
     }
 }
 
 void WiredTigerSessionCache::closeAll() {
-    // Increment the epoch as we are now closing all sessions with this epoch.
-    SessionCache swap;
+    // Increment the epoch as we are now closing all sessions with this epoch. This happens before
+    // any shard is emptied so that a session released concurrently either lands in a shard that is
+    // yet to be emptied or observes the new epoch and is deleted by its releaser.
+    _epoch.fetchAndAdd(1);
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
-    }
+    for (size_t shard = 0; shard < _numShards; ++shard) {
+        SessionCache swap;
+        {
+            stdx::lock_guard<Latch> lock(_shards[shard].lock);
+            _shards[shard].sessions.swap(swap);
+        }
 
-    for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
-        delete (*i);
+        for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
+            delete (*i);
+        }
     }
 }
 
@@ -470,27 +578,63 @@ bool WiredTigerSessionCache::isEphemeral() {
     return _engine && _engine->isEphemeral();
 }
 
+size_t WiredTigerSessionCache::_localShardIndex() const {
+    if (_numShards == 1) {
+        return 0;
+    }
+
+#if defined(__linux__)
+    const int cpu = sched_getcpu();
+    if (cpu >= 0) {
+        return static_cast<size_t>(cpu) % _numShards;
+    }
+#endif
+
+    thread_local const unsigned threadShardSlot = nextThreadShardSlot.fetchAndAdd(1);
+    return threadShardSlot % _numShards;
+}
+
 UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // We should never be able to get here after _shuttingDown is set, because no new
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        if (!_sessions.empty()) {
+    // Look in the local shard first and steal from the other shards only if it is empty.
+    const size_t localShard = _localShardIndex();
+    for (size_t i = 0; i < _numShards; ++i) {
+        auto& shard = _shards[(localShard + i) % _numShards];
+
+        WiredTigerSession* cachedSession = nullptr;
+        {
+            stdx::lock_guard<Latch> lock(shard.lock);
+            if (shard.sessions.empty()) {
+                continue;
+            }
             // Get the most recently used session so that if we discard sessions, we're
             // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
-            // Reset the idle time
-            cachedSession->setIdleExpireTime(Date_t::min());
-            return UniqueWiredTigerSession(cachedSession);
+            cachedSession = shard.sessions.back();
+            shard.sessions.pop_back();
+        }
+
+        // A concurrent closeAll() may have bumped the epoch before reaching this shard. Such a
+        // session must not be handed out again.
+        if (cachedSession->_getEpoch() != _epoch.load()) {
+            delete cachedSession;
+            continue;
         }
+
+        // Reset the idle time
+        cachedSession->setIdleExpireTime(Date_t::min());
+        return UniqueWiredTigerSession(cachedSession);
     }
 
     // Outside of the cache partition lock, but on release will be put back on the cache
-    return UniqueWiredTigerSession(
+    auto session = UniqueWiredTigerSession(
         new WiredTigerSession(_conn, this, _epoch.load(), _cursorEpoch.load()));
+    if (auto numTables = gWiredTigerCursorCacheWarmTables.load(); numTables > 0) {
+        session->_warmCursorCache(numTables);
+    }
+    return session;
 }
 
 void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
@@ -543,10 +687,11 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     session->setIdleExpireTime(_clockSource->now());
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<Latch> lock(_cacheLock);
+        auto& shard = _shards[_localShardIndex()];
+        stdx::lock_guard<Latch> lock(shard.lock);
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            shard.sessions.push_back(session);
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
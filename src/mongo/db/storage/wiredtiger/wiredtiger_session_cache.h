@@ -30,14 +30,18 @@
 #pragma once
 
 #include <list>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <wiredtiger.h>
 
 #include "mongo/db/storage/journal_listener.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_cursor_cache_stats.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/new.h"
 #include "mongo/util/concurrency/spin_lock.h"
 
 namespace mongo {
@@ -99,7 +103,8 @@ public:
      * cursor cache, then a new cached cursor will be created with the given config specification.
      *
      * This may return a cursor from the cursor cache and these cursors should *always* be released
-     * into the cache by calling releaseCursor().
+     * into the cache by calling releaseCursor(). Hits and misses are counted towards the
+     * per-table WiredTigerCursorCacheStats.
      */
     WT_CURSOR* getCachedCursor(const std::string& uri, uint64_t id, const char* config);
 
@@ -118,7 +123,8 @@ public:
 
     /**
      * Release a cursor into the cursor cache and close old cursors if the number of cursors in the
-     * cache exceeds wiredTigerCursorCacheSize.
+     * cache exceeds wiredTigerCursorCacheSize, or the number of tables used in the last ten minutes
+     * when wiredTigerCursorCacheScaleWithTables is enabled.
      */
     void releaseCursor(uint64_t id, WT_CURSOR* cursor);
 
@@ -190,6 +196,18 @@ private:
         return _cursorEpoch;
     }
 
+    /**
+     * Opens cursors on up to 'numTables' of the most frequently used tables and places them in the
+     * cursor cache, so that the first operations on a new session do not have to open them.
+     */
+    void _warmCursorCache(size_t numTables);
+
+    /**
+     * Folds the cursor cache hits and misses counted by this session into the global
+     * WiredTigerCursorCacheStats.
+     */
+    void _flushCursorCacheStats();
+
     const uint64_t _epoch;
     uint64_t _cursorEpoch;
     WiredTigerSessionCache* _cache;  // not owned
@@ -199,11 +217,23 @@ private:
     int _cursorsOut;
     bool _dropQueuedIdentsAtSessionEnd = true;
     Date_t _idleExpireTime;
+
+    // Cursor cache hits and misses not yet folded into the global WiredTigerCursorCacheStats. A hit
+    // only appends the table id to _cursorCacheHits, so that the common case of getCachedCursor()
+    // does not look up the table in a map. Misses open a cursor anyway and are counted in
+    // _cursorCacheStats directly, along with the uri and config the cursor was opened with.
+    std::vector<uint64_t> _cursorCacheHits;
+    WiredTigerCursorCacheStats::TableStatsMap _cursorCacheStats;
+    uint32_t _cursorCacheRequests = 0;
 };
 
 /**
  *  This cache implements a shared pool of WiredTiger sessions with the goal to amortize the
  *  cost of session creation and destruction over multiple uses.
+ *
+ *  Idle sessions are kept in a number of independently locked shards. A thread releases sessions
+ *  into, and reuses sessions from, the shard associated with the CPU it is running on, and only
+ *  falls back to stealing from the other shards when its own shard is empty.
  */
 class WiredTigerSessionCache {
 public:
@@ -257,6 +287,13 @@ public:
      */
     size_t getIdleSessionsCount();
 
+    /**
+     * Returns the number of shards the idle sessions are partitioned into.
+     */
+    size_t getNumShards() const {
+        return _numShards;
+    }
+
     /**
      * Closes all cached sessions whose idle expiration time has been reached.
      */
@@ -373,11 +410,29 @@ private:
     AtomicWord<unsigned> _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    Mutex _cacheLock = MONGO_MAKE_LATCH("WiredTigerSessionCache::_cacheLock");
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
 
-    // Bumped when all open sessions need to be closed
+    /**
+     * A partition of the idle sessions. Each shard sits on its own cache line so that threads
+     * releasing and reusing sessions on different CPUs do not contend with each other. Sessions
+     * are pushed to and popped from the back, so the front holds the longest idle sessions.
+     */
+    struct alignas(stdx::hardware_destructive_interference_size) SessionShard {
+        Mutex lock = MONGO_MAKE_LATCH("WiredTigerSessionCache::SessionShard::lock");
+        SessionCache sessions;
+    };
+
+    /**
+     * Returns the shard that the calling thread should release sessions into and reuse sessions
+     * from.
+     */
+    size_t _localShardIndex() const;
+
+    const size_t _numShards;
+    std::unique_ptr<SessionShard[]> _shards;
+
+    // Bumped when all open sessions need to be closed. Sessions from an older epoch are discarded
+    // rather than returned to, or handed out from, the cache.
     AtomicWord<unsigned long long> _epoch;  // atomic so we can check it outside of the lock
 
     // Bumped when all open cursors need to be closed
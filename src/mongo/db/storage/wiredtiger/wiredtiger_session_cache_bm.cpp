@@ -0,0 +1,115 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/util/clock_source_mock.h"
+#include "mongo/util/processinfo.h"
+
+namespace mongo {
+namespace {
+
+class WiredTigerConnection {
+public:
+    WiredTigerConnection(StringData dbpath, StringData extraStrings) : _conn(nullptr) {
+        std::stringstream ss;
+        ss << "create,";
+        ss << extraStrings;
+        std::string config = ss.str();
+        int ret = wiredtiger_open(dbpath.toString().c_str(), nullptr, config.c_str(), &_conn);
+        invariant(wtRCToStatus(ret).isOK());
+    }
+    ~WiredTigerConnection() {
+        _conn->close(_conn, nullptr);
+    }
+    WT_CONNECTION* getConnection() const {
+        return _conn;
+    }
+
+private:
+    WT_CONNECTION* _conn;
+};
+
+class WiredTigerSessionCacheHelper {
+public:
+    WiredTigerSessionCacheHelper()
+        : _dbpath("wt_test"),
+          _connection(_dbpath.path(), "session_max=1000"),
+          _sessionCache(_connection.getConnection(), &_clockSource) {}
+
+    WiredTigerSessionCache* getSessionCache() {
+        return &_sessionCache;
+    }
+
+private:
+    unittest::TempDir _dbpath;
+    WiredTigerConnection _connection;
+    ClockSourceMock _clockSource;
+    WiredTigerSessionCache _sessionCache;
+};
+
+/**
+ * Benchmark getting a session from the session cache and releasing it back, which every recovery
+ * unit does at least once per operation. The argument is the number of session cache shards, where
+ * 0 means one shard per available core.
+ *
+ * All threads executing the benchmark share the same session cache, to allow benchmarking to
+ * identify synchronization costs of getSession() and releaseSession().
+ */
+void BM_WiredTigerSessionCacheGetAndRelease(benchmark::State& state) {
+    static std::unique_ptr<WiredTigerSessionCacheHelper> helper;
+    if (state.thread_index == 0) {
+        gWiredTigerSessionCacheShards = state.range(0);
+        helper = std::make_unique<WiredTigerSessionCacheHelper>();
+    }
+
+    for (auto keepRunning : state) {
+        UniqueWiredTigerSession session = helper->getSessionCache()->getSession();
+        benchmark::DoNotOptimize(session->getSession());
+    }
+
+    if (state.thread_index == 0) {
+        helper.reset();
+    }
+}
+
+BENCHMARK(BM_WiredTigerSessionCacheGetAndRelease)
+    ->ThreadRange(1, ProcessInfo::getNumAvailableCores())
+    ->ArgName("shards")
+    ->Arg(1)
+    ->Arg(0);
+
+}  // namespace
+}  // namespace mongo
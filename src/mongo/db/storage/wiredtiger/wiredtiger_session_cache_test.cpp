@@ -29,10 +29,14 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+#include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/unittest/temp_dir.h"
@@ -113,4 +117,147 @@ TEST(WiredTigerSessionCacheTest, CheckSessionCacheCleanup) {
     ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
 }
 
+TEST(WiredTigerSessionCacheTest, ReleasedSessionsAreReusedFromAnyShard) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+    ASSERT_GTE(sessionCache->getNumShards(), 1U);
+
+    // Release more sessions than there are shards. Whichever shards they are released to,
+    // getSession() must find every one of them before opening a new session.
+    const size_t numSessions = sessionCache->getNumShards() + 2;
+    std::set<WiredTigerSession*> releasedSessions;
+    {
+        std::vector<UniqueWiredTigerSession> sessions;
+        for (size_t i = 0; i < numSessions; ++i) {
+            sessions.push_back(sessionCache->getSession());
+            releasedSessions.insert(sessions.back().get());
+        }
+        ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+    }
+    ASSERT_EQUALS(releasedSessions.size(), numSessions);
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), numSessions);
+
+    {
+        std::vector<UniqueWiredTigerSession> sessions;
+        std::set<WiredTigerSession*> reusedSessions;
+        for (size_t i = 0; i < numSessions; ++i) {
+            sessions.push_back(sessionCache->getSession());
+            reusedSessions.insert(sessions.back().get());
+        }
+        ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+
+        // Every idle session was handed out again and no new session was opened.
+        ASSERT(reusedSessions == releasedSessions);
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), numSessions);
+
+    // Closing all sessions empties every shard.
+    sessionCache->closeAll();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+}
+
+TEST(WiredTigerSessionCacheTest, CursorCacheHitsAndMissesAreCountedPerTable) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+    const std::string uri = "table:cursor_cache_stats";
+    const uint64_t tableId = WiredTigerSession::genTableId();
+    {
+        UniqueWiredTigerSession session = sessionCache->getSession();
+        WT_SESSION* wtSession = session->getSession();
+        ASSERT_OK(wtRCToStatus(wtSession->create(wtSession, uri.c_str(), nullptr)));
+
+        // The first request opens a cursor, the second one reuses it from the cursor cache.
+        for (int i = 0; i < 2; ++i) {
+            WT_CURSOR* cursor = session->getCachedCursor(uri, tableId, nullptr);
+            session->releaseCursor(tableId, cursor);
+        }
+    }
+
+    // Close the cached session so that its counters are folded into the global statistics.
+    sessionCache->closeAll();
+
+    auto& stats = WiredTigerCursorCacheStats::get();
+    auto tables = *stats.hottestTables();
+    auto it = std::find_if(
+        tables.begin(), tables.end(), [&](const auto& table) { return table.first == tableId; });
+    ASSERT(it != tables.end());
+    ASSERT_EQUALS(it->second.uri, uri);
+    ASSERT_EQUALS(it->second.hits, 1);
+    ASSERT_EQUALS(it->second.misses, 1);
+
+    stats.onTableDropped(uri);
+    tables = *stats.hottestTables();
+    ASSERT(std::none_of(tables.begin(), tables.end(), [&](const auto& table) {
+        return table.first == tableId;
+    }));
+}
+
+TEST(WiredTigerSessionCacheTest, CursorCacheStatsForgetTablesNotRequestedRecently) {
+    auto& stats = WiredTigerCursorCacheStats::get();
+    auto totalMisses = [&] {
+        BSONObjBuilder builder;
+        stats.appendStats(&builder);
+        return builder.obj()["misses"].numberLong();
+    };
+    const long long missesBefore = totalMisses();
+
+    const uint64_t idleTableId = WiredTigerSession::genTableId();
+    const uint64_t activeTableId = WiredTigerSession::genTableId();
+    const auto now = Date_t::now();
+
+    WiredTigerCursorCacheStats::TableStatsMap sessionStats;
+    sessionStats[idleTableId].uri = "table:idle";
+    sessionStats[idleTableId].misses = 1;
+    stats.merge(sessionStats, now);
+
+    // An hour later, only the table requested since then is still tracked.
+    sessionStats.clear();
+    sessionStats[activeTableId].uri = "table:active";
+    sessionStats[activeTableId].misses = 1;
+    stats.merge(sessionStats, now + Hours(1));
+
+    auto tables = *stats.hottestTables();
+    auto isTable = [](uint64_t id) {
+        return [id](const auto& table) { return table.first == id; };
+    };
+    ASSERT(std::any_of(tables.begin(), tables.end(), isTable(activeTableId)));
+    ASSERT(std::none_of(tables.begin(), tables.end(), isTable(idleTableId)));
+
+    // The totals still count the misses on the forgotten table.
+    ASSERT_EQUALS(missesBefore + 2, totalMisses());
+    stats.onTableDropped("table:active");
+}
+
+TEST(WiredTigerSessionCacheTest, CursorCacheStatsRefreshHottestTablesPeriodically) {
+    auto& stats = WiredTigerCursorCacheStats::get();
+    const uint64_t tableId = WiredTigerSession::genTableId();
+    const auto now = Date_t::now() + Days(1);
+    auto requestsOnTable = [&] {
+        auto tables = stats.hottestTables();
+        auto it = std::find_if(tables->begin(), tables->end(), [&](const auto& table) {
+            return table.first == tableId;
+        });
+        ASSERT(it != tables->end());
+        return it->second.hits + it->second.misses;
+    };
+
+    // A newly known table shows up in the snapshot right away.
+    WiredTigerCursorCacheStats::TableStatsMap sessionStats;
+    sessionStats[tableId].uri = "table:hot";
+    sessionStats[tableId].misses = 1;
+    stats.merge(sessionStats, now);
+    ASSERT_EQUALS(1, requestsOnTable());
+
+    // New counters on it are only reflected once the snapshot is due for a refresh.
+    sessionStats[tableId].uri.clear();
+    sessionStats[tableId].misses = 0;
+    sessionStats[tableId].hits = 1;
+    stats.merge(sessionStats, now);
+    ASSERT_EQUALS(1, requestsOnTable());
+    stats.merge(sessionStats, now + Seconds(1));
+    ASSERT_EQUALS(3, requestsOnTable());
+
+    stats.onTableDropped("table:hot");
+}
+
 }  // namespace mongo
@@ -46,6 +46,7 @@
 #include "mongo/db/exec/queued_data_stage.h"
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/dbtests/dbtests.h"
 
 namespace QueryStageFetch {
@@ -226,6 +227,79 @@ public:
     }
 };
 
+//
+// Test that batched fetching returns the documents in the order the child produced them.
+//
+class FetchStageBatched : public QueryStageFetchBase {
+public:
+    FetchStageBatched()
+        : _internalQueryFetchStageMaxBatchSize(internalQueryFetchStageMaxBatchSize.load()) {
+        internalQueryFetchStageMaxBatchSize.store(4);
+    }
+
+    ~FetchStageBatched() {
+        internalQueryFetchStageMaxBatchSize.store(_internalQueryFetchStageMaxBatchSize);
+    }
+
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns());
+        Database* db = ctx.db();
+        Collection* coll =
+            CollectionCatalog::get(&_opCtx).lookupCollectionByNamespace(&_opCtx, nss());
+        if (!coll) {
+            WriteUnitOfWork wuow(&_opCtx);
+            coll = db->createCollection(&_opCtx, nss());
+            wuow.commit();
+        }
+
+        WorkingSet ws;
+
+        const int numDocs = 5;
+        for (int i = 0; i < numDocs; ++i) {
+            insert(BSON("foo" << i));
+        }
+        set<RecordId> recordIds;
+        getRecordIds(&recordIds, coll);
+        ASSERT_EQUALS(size_t(numDocs), recordIds.size());
+
+        // Queue up the RecordIds in descending order, so that each batch is fetched in the
+        // opposite order from the one in which it is returned.
+        auto mockStage = std::make_unique<QueuedDataStage>(_expCtx.get(), &ws);
+        for (auto it = recordIds.rbegin(); it != recordIds.rend(); ++it) {
+            WorkingSetID id = ws.allocate();
+            WorkingSetMember* mockMember = ws.get(id);
+            mockMember->recordId = *it;
+            ws.transitionToRecordIdAndIdx(id);
+            mockStage->pushBack(id);
+        }
+
+        auto fetchStage =
+            std::make_unique<FetchStage>(_expCtx.get(), &ws, std::move(mockStage), nullptr, coll);
+
+        std::vector<int> results;
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        PlanStage::StageState state;
+        while ((state = fetchStage->work(&id)) != PlanStage::IS_EOF) {
+            if (PlanStage::ADVANCED == state) {
+                WorkingSetMember* member = ws.get(id);
+                ASSERT_TRUE(member->hasObj());
+                results.push_back(member->doc.value()["foo"].getInt());
+            }
+        }
+
+        ASSERT(results == std::vector<int>({4, 3, 2, 1, 0}));
+
+        // The batches grow from one to two to four members, the last one holding the two
+        // remaining members.
+        auto stats = static_cast<const FetchStats*>(fetchStage->getSpecificStats());
+        ASSERT_EQUALS(size_t(3), stats->batches);
+        ASSERT_EQUALS(size_t(numDocs), stats->docsExamined);
+    }
+
+private:
+    int _internalQueryFetchStageMaxBatchSize;
+};
+
 class All : public OldStyleSuiteSpecification {
 public:
     All() : OldStyleSuiteSpecification("query_stage_fetch") {}
@@ -233,6 +307,7 @@ public:
     void setupTests() {
         add<FetchStageAlreadyFetched>();
         add<FetchStageFilter>();
+        add<FetchStageBatched>();
     }
 };
 
@@ -236,6 +236,11 @@ OpTime ReplicationCoordinatorEmbedded::getMyLastAppliedOpTime() const {
     UASSERT_NOT_IMPLEMENTED;
 }
 
+boost::optional<OpTime> ReplicationCoordinatorEmbedded::getEarliestOpTimeWaitingForLastApplied()
+    const {
+    UASSERT_NOT_IMPLEMENTED;
+}
+
 OpTimeAndWallTime ReplicationCoordinatorEmbedded::getMyLastDurableOpTimeAndWallTime() const {
     UASSERT_NOT_IMPLEMENTED;
 }
@@ -131,6 +131,7 @@ public:
     void setMyHeartbeatMessage(const std::string&) override;
 
     repl::OpTime getMyLastAppliedOpTime() const override;
+    boost::optional<repl::OpTime> getEarliestOpTimeWaitingForLastApplied() const override;
     repl::OpTimeAndWallTime getMyLastAppliedOpTimeAndWallTime() const override;
 
     repl::OpTime getMyLastDurableOpTime() const override;
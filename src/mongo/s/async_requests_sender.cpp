@@ -77,7 +77,6 @@ AsyncRequestsSender::AsyncRequestsSender(OperationContext* opCtx,
     // Initialize command metadata to handle the read preference.
     _metadataObj = readPreference.toContainingBSON();
 
-    _remotes.reserve(requests.size());
     for (const auto& request : requests) {
         // Kick off requests immediately.
         _remotes.emplace_back(this, request.shardId, request.cmdObj).executeRequest();
@@ -125,6 +124,18 @@ void AsyncRequestsSender::stopRetrying() noexcept {
     _stopRetrying = true;
 }
 
+void AsyncRequestsSender::addRequest(const AsyncRequestsSender::Request& request) {
+    _remotesLeft++;
+
+    auto& remote = _remotes.emplace_back(this, request.shardId, request.cmdObj);
+    if (!_interruptStatus.isOK()) {
+        _responseQueue.push(std::move(remote).makeFailedResponse(_interruptStatus));
+        return;
+    }
+
+    remote.executeRequest();
+}
+
 bool AsyncRequestsSender::done() noexcept {
     return !_remotesLeft;
 }
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <deque>
 #include <vector>
 
 #include "mongo/base/status_with.h"
@@ -162,6 +163,16 @@ public:
      */
     void stopRetrying() noexcept;
 
+    /**
+     * Schedules an additional request after construction, for callers which decide what to send
+     * next based on the responses already received. The response is returned via next() like
+     * those of the initial requests, so done() is false until it has been consumed.
+     *
+     * If the ARS has already been interrupted, no request is sent and the response carries the
+     * interruption status.
+     */
+    void addRequest(const AsyncRequestsSender::Request& request);
+
 private:
     /**
      * We instantiate one of these per remote host.
@@ -267,8 +278,9 @@ private:
     // The policy to use when deciding whether to retry on an error.
     Shard::RetryPolicy _retryPolicy;
 
-    // Data tracking the state of our communication with each of the remote nodes.
-    std::vector<RemoteData> _remotes;
+    // Data tracking the state of our communication with each of the remote nodes. A deque so that
+    // requests added through addRequest() don't invalidate the RemoteData captured by callbacks.
+    std::deque<RemoteData> _remotes;
 
     // Number of remotes we haven't returned final results from.
     size_t _remotesLeft;
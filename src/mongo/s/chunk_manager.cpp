@@ -70,8 +70,147 @@ std::string extractKeyStringInternal(const BSONObj& shardKeyValue, Ordering orde
     return {ks.getBuffer(), ks.getSize()};
 }
 
+void checkContiguous(const ChunkInfo& lower, const ChunkInfo& upper) {
+    const auto& lowerMax = lower.getMax();
+    const auto& upperMin = upper.getMin();
+    if (SimpleBSONObjComparator::kInstance.evaluate(lowerMax == upperMin)) {
+        return;
+    }
+
+    uasserted(ErrorCodes::ConflictingOperationInProgress,
+              str::stream() << (SimpleBSONObjComparator::kInstance.evaluate(lowerMax < upperMin)
+                                    ? "Gap"
+                                    : "Overlap")
+                            << " exists in the routing table between chunks "
+                            << lower.getRange().toString() << " and "
+                            << upper.getRange().toString());
+}
+
 }  // namespace
 
+ChunkInfoMap::const_iterator ChunkInfoMap::upper_bound(StringData key) const {
+    const auto segmentIt =
+        std::partition_point(_segments.begin(), _segments.end(), [&](const auto& segment) {
+            return StringData(segment->back().first) <= key;
+        });
+    if (segmentIt == _segments.end()) {
+        return end();
+    }
+
+    const auto& segment = **segmentIt;
+    const auto pos = std::partition_point(segment.begin(), segment.end(), [&](const auto& entry) {
+        return StringData(entry.first) <= key;
+    });
+    return {&_segments,
+            static_cast<size_t>(segmentIt - _segments.begin()),
+            static_cast<size_t>(pos - segment.begin())};
+}
+
+ChunkInfoMap::const_iterator ChunkInfoMap::lower_bound(StringData key) const {
+    const auto segmentIt =
+        std::partition_point(_segments.begin(), _segments.end(), [&](const auto& segment) {
+            return StringData(segment->back().first) < key;
+        });
+    if (segmentIt == _segments.end()) {
+        return end();
+    }
+
+    const auto& segment = **segmentIt;
+    const auto pos = std::partition_point(segment.begin(), segment.end(), [&](const auto& entry) {
+        return StringData(entry.first) < key;
+    });
+    return {&_segments,
+            static_cast<size_t>(segmentIt - _segments.begin()),
+            static_cast<size_t>(pos - segment.begin())};
+}
+
+const std::shared_ptr<ChunkInfo>& ChunkInfoMap::at(StringData key) const {
+    const auto it = lower_bound(key);
+    invariant(it != end() && StringData(it->first) == key);
+    return it->second;
+}
+
+ChunkInfoMap::Segment& ChunkInfoMap::_mutableSegment(size_t segmentIdx) {
+    auto& segment = _segments[segmentIdx];
+    if (segment.use_count() > 1) {
+        segment = std::make_shared<Segment>(*segment);
+    }
+    return *segment;
+}
+
+void ChunkInfoMap::erase(const_iterator first, const_iterator last) {
+    if (first == last) {
+        return;
+    }
+
+    if (first._segmentIdx == last._segmentIdx) {
+        auto& segment = _mutableSegment(first._segmentIdx);
+        segment.erase(segment.begin() + first._pos, segment.begin() + last._pos);
+        _size -= last._pos - first._pos;
+        if (segment.empty()) {
+            _segments.erase(_segments.begin() + first._segmentIdx);
+        }
+        return;
+    }
+
+    // Trim the partially erased segments at either end of the range, then drop the segments which
+    // are erased entirely without copying them.
+    auto firstWholeSegment = first._segmentIdx;
+    if (first._pos > 0) {
+        auto& segment = _mutableSegment(first._segmentIdx);
+        _size -= segment.size() - first._pos;
+        segment.erase(segment.begin() + first._pos, segment.end());
+        ++firstWholeSegment;
+    }
+
+    if (last._pos > 0) {
+        auto& segment = _mutableSegment(last._segmentIdx);
+        segment.erase(segment.begin(), segment.begin() + last._pos);
+        _size -= last._pos;
+    }
+
+    for (auto idx = firstWholeSegment; idx < last._segmentIdx; ++idx) {
+        _size -= _segments[idx]->size();
+    }
+    _segments.erase(_segments.begin() + firstWholeSegment,
+                    _segments.begin() + last._segmentIdx);
+}
+
+void ChunkInfoMap::insert(value_type entry) {
+    ++_size;
+    if (_segments.empty()) {
+        _segments.push_back(std::make_shared<Segment>());
+        _segments.back()->push_back(std::move(entry));
+        return;
+    }
+
+    // Insert into the first segment whose max sorts after the new entry, or append to the last.
+    auto segmentIt =
+        std::partition_point(_segments.begin(), _segments.end(), [&](const auto& segment) {
+            return segment->back().first < entry.first;
+        });
+    if (segmentIt == _segments.end()) {
+        --segmentIt;
+    }
+    const auto segmentIdx = static_cast<size_t>(segmentIt - _segments.begin());
+
+    auto& segment = _mutableSegment(segmentIdx);
+    const auto pos =
+        std::partition_point(segment.begin(), segment.end(), [&](const value_type& existing) {
+            return existing.first < entry.first;
+        });
+    invariant(pos == segment.end() || pos->first != entry.first);
+    segment.insert(pos, std::move(entry));
+
+    if (segment.size() > 2 * kTargetSegmentSize) {
+        const auto mid = segment.begin() + segment.size() / 2;
+        auto upperHalf = std::make_shared<Segment>(std::make_move_iterator(mid),
+                                                   std::make_move_iterator(segment.end()));
+        segment.erase(mid, segment.end());
+        _segments.insert(_segments.begin() + segmentIdx + 1, std::move(upperHalf));
+    }
+}
+
 ShardVersionTargetingInfo::ShardVersionTargetingInfo(const OID& epoch)
     : shardVersion(0, 0, epoch) {}
 
@@ -91,7 +230,30 @@ RoutingTableHistory::RoutingTableHistory(NamespaceString nss,
       _unique(unique),
       _chunkMap(std::move(chunkMap)),
       _collectionVersion(collectionVersion),
-      _shardVersions(_constructShardVersionMap()) {}
+      _shardVersions(_constructShardVersionMap()),
+      _targetingCacheSize(gRoutingTableTargetingCacheSize.load()),
+      _targetingCache(_targetingCacheSize) {}
+
+RoutingTableHistory::RoutingTableHistory(NamespaceString nss,
+                                         boost::optional<UUID> uuid,
+                                         KeyPattern shardKeyPattern,
+                                         std::unique_ptr<CollatorInterface> defaultCollator,
+                                         bool unique,
+                                         ChunkInfoMap chunkMap,
+                                         ChunkVersion collectionVersion,
+                                         ShardVersionMap shardVersions)
+    : _sequenceNumber(nextCMSequenceNumber.addAndFetch(1)),
+      _nss(std::move(nss)),
+      _uuid(uuid),
+      _shardKeyPattern(shardKeyPattern),
+      _shardKeyOrdering(Ordering::make(_shardKeyPattern.toBSON())),
+      _defaultCollator(std::move(defaultCollator)),
+      _unique(unique),
+      _chunkMap(std::move(chunkMap)),
+      _collectionVersion(collectionVersion),
+      _shardVersions(std::move(shardVersions)),
+      _targetingCacheSize(gRoutingTableTargetingCacheSize.load()),
+      _targetingCache(_targetingCacheSize) {}
 
 void RoutingTableHistory::setShardStale(const ShardId& shardId) {
     if (gEnableFinerGrainedCatalogCacheRefresh) {
@@ -148,6 +310,48 @@ void ChunkManager::getShardIdsForQuery(OperationContext* opCtx,
                                        const BSONObj& query,
                                        const BSONObj& collation,
                                        std::set<ShardId>* shardIds) const {
+    // Targeting as of a cluster time depends on the chunk history, so only the current placement
+    // of the chunks is cached.
+    if (_rt->_targetingCacheSize == 0 || _clusterTime) {
+        _targetShardIdsForQuery(opCtx, query, collation, shardIds);
+        return;
+    }
+
+    const auto cacheKey = [&] {
+        BSONObjBuilder keyBuilder;
+        keyBuilder.append("filter", query);
+        keyBuilder.append("collation", collation);
+        const auto key = keyBuilder.done();
+        return std::string(key.objdata(), key.objsize());
+    }();
+
+    {
+        stdx::lock_guard<Latch> lk(_rt->_targetingCacheMutex);
+        auto it = _rt->_targetingCache.find(cacheKey);
+        if (it != _rt->_targetingCache.end()) {
+            shardIds->insert(it->second.begin(), it->second.end());
+            ++_rt->_targetingCacheHits;
+            return;
+        }
+    }
+
+    std::set<ShardId> targetedShardIds;
+    _targetShardIdsForQuery(opCtx, query, collation, &targetedShardIds);
+    shardIds->insert(targetedShardIds.begin(), targetedShardIds.end());
+
+    stdx::lock_guard<Latch> lk(_rt->_targetingCacheMutex);
+    _rt->_targetingCache.add(cacheKey, std::move(targetedShardIds));
+}
+
+uint64_t ChunkManager::getTargetingCacheHits() const {
+    stdx::lock_guard<Latch> lk(_rt->_targetingCacheMutex);
+    return _rt->_targetingCacheHits;
+}
+
+void ChunkManager::_targetShardIdsForQuery(OperationContext* opCtx,
+                                           const BSONObj& query,
+                                           const BSONObj& collation,
+                                           std::set<ShardId>* shardIds) const {
     auto qr = std::make_unique<QueryRequest>(_rt->getns());
     qr->setFilter(query);
 
@@ -192,13 +396,40 @@ void ChunkManager::getShardIdsForQuery(OperationContext* opCtx,
     //   => Ranges { a : 1, b : 3 } => { a : 2, b : 4 }
     BoundList ranges = _rt->getShardKeyPattern().flattenBounds(bounds);
 
-    for (BoundList::const_iterator it = ranges.begin(); it != ranges.end(); ++it) {
-        getShardIdsForRange(it->first /*min*/, it->second /*max*/, shardIds);
+    // The ranges come out in ascending shard key order, so rather than searching the chunk map for
+    // both ends of every range (which dominates targeting of large $in lists), walk the chunk map
+    // forward alongside the ranges and only search it when a range starts past the current chunk.
+    const auto& chunkMap = _rt->getChunkMap();
+    auto chunkIt = chunkMap.end();
+    std::string prevMaxKey;
+    for (const auto& [min, max] : ranges) {
+        auto minKey = _rt->_extractKeyString(min);
+        auto maxKey = SimpleBSONObjComparator::kInstance.evaluate(min == max)
+            ? minKey
+            : _rt->_extractKeyString(max);
+
+        // The current chunk contains the previous range's max, so it also contains this range's min
+        // if that lies between the two.
+        if (chunkIt == chunkMap.end() || StringData(minKey) < StringData(prevMaxKey) ||
+            StringData(chunkIt->first) <= StringData(minKey)) {
+            chunkIt = chunkMap.upper_bound(minKey);
+        }
+
+        // Visit the chunks overlapping [min, max], stopping at the one which contains max.
+        for (; chunkIt != chunkMap.end(); ++chunkIt) {
+            shardIds->insert(chunkIt->second->getShardIdAt(_clusterTime));
+            if (shardIds->size() == _rt->_shardVersions.size() ||
+                StringData(chunkIt->first) > StringData(maxKey)) {
+                break;
+            }
+        }
 
         // once we know we need to visit all shards no need to keep looping
         if (shardIds->size() == _rt->_shardVersions.size()) {
             break;
         }
+
+        prevMaxKey = std::move(maxKey);
     }
 
     // SERVER-4914 Some clients of getShardIdsForQuery() assume at least one shard will be returned.
@@ -462,22 +693,24 @@ ShardVersionMap RoutingTableHistory::_constructShardVersionMap() const {
         }
 
         auto& maxShardVersion = shardVersionIt->second.shardVersion;
+        auto& numChunks = shardVersionIt->second.numChunks;
 
-        current =
-            std::find_if(current,
-                         _chunkMap.cend(),
-                         [&currentRangeShardId,
-                          &maxShardVersion](const ChunkInfoMap::value_type& chunkMapEntry) {
-                             const auto& currentChunk = chunkMapEntry.second;
+        current = std::find_if(current,
+                               _chunkMap.cend(),
+                               [&currentRangeShardId, &maxShardVersion, &numChunks](
+                                   const ChunkInfoMap::value_type& chunkMapEntry) {
+                                   const auto& currentChunk = chunkMapEntry.second;
 
-                             if (currentChunk->getShardIdAt(boost::none) != currentRangeShardId)
-                                 return true;
+                                   if (currentChunk->getShardIdAt(boost::none) !=
+                                       currentRangeShardId)
+                                       return true;
 
-                             if (currentChunk->getLastmod() > maxShardVersion)
-                                 maxShardVersion = currentChunk->getLastmod();
+                                   if (currentChunk->getLastmod() > maxShardVersion)
+                                       maxShardVersion = currentChunk->getLastmod();
 
-                             return false;
-                         });
+                                   ++numChunks;
+                                   return false;
+                               });
 
         const auto rangeLast = std::prev(current);
 
@@ -522,6 +755,30 @@ ShardVersionMap RoutingTableHistory::_constructShardVersionMap() const {
     return shardVersions;
 }
 
+void RoutingTableHistory::_checkContinuityAround(
+    const ChunkInfoMap& chunkMap, const std::vector<std::string>& maxKeyStrings) const {
+    for (const auto& maxKeyString : maxKeyStrings) {
+        auto it = chunkMap.lower_bound(maxKeyString);
+        if (it == chunkMap.end() || it->first != maxKeyString) {
+            // Replaced by a later change, which is checked on its own.
+            continue;
+        }
+
+        const auto& chunk = it->second;
+        if (it == chunkMap.begin()) {
+            checkAllElementsAreOfType(MinKey, chunk->getMin());
+        } else {
+            checkContiguous(*std::prev(it)->second, *chunk);
+        }
+
+        if (++it == chunkMap.end()) {
+            checkAllElementsAreOfType(MaxKey, chunk->getMax());
+        } else {
+            checkContiguous(*chunk, *it->second);
+        }
+    }
+}
+
 std::string RoutingTableHistory::_extractKeyString(const BSONObj& shardKeyValue) const {
     return extractKeyStringInternal(shardKeyValue, _shardKeyOrdering);
 }
@@ -550,6 +807,27 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
     const auto startingCollectionVersion = getVersion();
     auto chunkMap = _chunkMap;
 
+    // How the changed chunks affect each shard. A shard's version only needs to be recomputed from
+    // all of its chunks when its highest versioned chunk was replaced by chunks on other shards.
+    struct ShardChanges {
+        std::int64_t chunksAdded = 0;
+        ChunkVersion maxVersion;
+        bool removedMaxVersionChunk = false;
+    };
+    std::map<ShardId, ShardChanges> shardChanges;
+    auto getShardChanges = [&](const ShardId& shardId) -> ShardChanges& {
+        auto it = shardChanges.find(shardId);
+        if (it == shardChanges.end()) {
+            it = shardChanges.emplace(shardId, ShardChanges()).first;
+            auto itVersion = _shardVersions.find(shardId);
+            it->second.maxVersion = itVersion != _shardVersions.end()
+                ? itVersion->second.shardVersion
+                : ChunkVersion(0, 0, startingCollectionVersion.epoch());
+        }
+        return it->second;
+    };
+    std::vector<std::string> changedMaxKeyStrings;
+
     ChunkVersion collectionVersion = startingCollectionVersion;
     for (const auto& chunk : changedChunks) {
         const auto& chunkVersion = chunk.getVersion();
@@ -598,11 +876,27 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
             newChunk->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
         }
 
+        for (auto it = low; it != high; ++it) {
+            const auto& replacedChunk = it->second;
+            auto& changes = getShardChanges(replacedChunk->getShardIdAt(boost::none));
+            --changes.chunksAdded;
+            if (replacedChunk->getLastmod() == changes.maxVersion) {
+                changes.removedMaxVersionChunk = true;
+            }
+        }
+
+        // Chunks arrive in increasing version order, so the new chunk becomes its shard's highest
+        auto& changes = getShardChanges(chunk.getShard());
+        ++changes.chunksAdded;
+        changes.maxVersion = chunkVersion;
+        changes.removedMaxVersionChunk = false;
+
         // Erase all chunks from the map, which overlap the chunk we got from the persistent store
         chunkMap.erase(low, high);
 
         // Insert only the chunk itself
         chunkMap.insert(std::make_pair(chunkMaxKeyString, newChunk));
+        changedMaxKeyStrings.push_back(chunkMaxKeyString);
     }
 
     // If at least one diff was applied, the metadata is correct, but it might not have changed so
@@ -617,6 +911,47 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
         return shared_from_this();
     }
 
+    const bool needsFullRebuild = _chunkMap.empty() ||
+        std::any_of(shardChanges.begin(), shardChanges.end(), [](const auto& entry) {
+            return entry.second.removedMaxVersionChunk;
+        });
+    if (needsFullRebuild) {
+        return std::shared_ptr<RoutingTableHistory>(
+            new RoutingTableHistory(_nss,
+                                    _uuid,
+                                    KeyPattern(getShardKeyPattern().getKeyPattern()),
+                                    CollatorInterface::cloneCollator(getDefaultCollator()),
+                                    isUnique(),
+                                    std::move(chunkMap),
+                                    collectionVersion));
+    }
+
+    // Only the neighbourhood of the changed chunks needs to be validated and only the shards which
+    // own them need new versions, so the cost of the refresh is independent of the total number
+    // of chunks.
+    _checkContinuityAround(chunkMap, changedMaxKeyStrings);
+
+    ShardVersionMap shardVersions;
+    for (const auto& [shardId, targetingInfo] : _shardVersions) {
+        auto& newTargetingInfo =
+            shardVersions.emplace(shardId, collectionVersion.epoch()).first->second;
+        newTargetingInfo.shardVersion = targetingInfo.shardVersion;
+        newTargetingInfo.numChunks = targetingInfo.numChunks;
+    }
+    for (const auto& [shardId, changes] : shardChanges) {
+        auto& targetingInfo =
+            shardVersions.emplace(shardId, collectionVersion.epoch()).first->second;
+        const auto numChunks =
+            static_cast<std::int64_t>(targetingInfo.numChunks) + changes.chunksAdded;
+        invariant(numChunks >= 0);
+        if (numChunks == 0) {
+            shardVersions.erase(shardId);
+            continue;
+        }
+        targetingInfo.numChunks = static_cast<size_t>(numChunks);
+        targetingInfo.shardVersion = changes.maxVersion;
+    }
+
     return std::shared_ptr<RoutingTableHistory>(
         new RoutingTableHistory(_nss,
                                 _uuid,
@@ -624,7 +959,8 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
                                 CollatorInterface::cloneCollator(getDefaultCollator()),
                                 isUnique(),
                                 std::move(chunkMap),
-                                collectionVersion));
+                                collectionVersion,
+                                std::move(shardVersions)));
 }
 
 }  // namespace mongo
@@ -29,7 +29,9 @@
 
 #pragma once
 
+#include <iterator>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -39,8 +41,10 @@
 #include "mongo/s/chunk.h"
 #include "mongo/s/chunk_version.h"
 #include "mongo/s/client/shard.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/s/shard_key_pattern.h"
 #include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/lru_cache.h"
 
 namespace mongo {
 
@@ -49,8 +53,147 @@ struct QuerySolutionNode;
 class OperationContext;
 class ChunkManager;
 
-// Ordered map from the max for each chunk to an entry describing the chunk
-using ChunkInfoMap = std::map<std::string, std::shared_ptr<ChunkInfo>>;
+/**
+ * Ordered map from the max for each chunk (as a KeyString) to an entry describing the chunk.
+ *
+ * The entries are kept in sorted, contiguous segments of bounded size, so lookups are a binary
+ * search over the segments followed by a binary search within one segment. Segments are shared
+ * between copies of the map and are only copied when a copy modifies them, so building the routing
+ * table for a refresh copies the segment pointers plus the segments the refresh touches, instead of
+ * every chunk.
+ */
+class ChunkInfoMap {
+public:
+    using value_type = std::pair<std::string, std::shared_ptr<ChunkInfo>>;
+
+private:
+    using Segment = std::vector<value_type>;
+    using SegmentVector = std::vector<std::shared_ptr<Segment>>;
+
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = ChunkInfoMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator() = default;
+
+        reference operator*() const {
+            return (*(*_segments)[_segmentIdx])[_pos];
+        }
+        pointer operator->() const {
+            return &**this;
+        }
+
+        const_iterator& operator++() {
+            if (++_pos == (*_segments)[_segmentIdx]->size()) {
+                ++_segmentIdx;
+                _pos = 0;
+            }
+            return *this;
+        }
+        const_iterator operator++(int) {
+            auto prev = *this;
+            ++*this;
+            return prev;
+        }
+
+        const_iterator& operator--() {
+            if (_pos == 0) {
+                --_segmentIdx;
+                _pos = (*_segments)[_segmentIdx]->size() - 1;
+            } else {
+                --_pos;
+            }
+            return *this;
+        }
+        const_iterator operator--(int) {
+            auto prev = *this;
+            --*this;
+            return prev;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return _segmentIdx == other._segmentIdx && _pos == other._pos;
+        }
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        friend class ChunkInfoMap;
+
+        const_iterator(const SegmentVector* segments, size_t segmentIdx, size_t pos)
+            : _segments(segments), _segmentIdx(segmentIdx), _pos(pos) {}
+
+        const SegmentVector* _segments = nullptr;
+        size_t _segmentIdx = 0;
+        size_t _pos = 0;
+    };
+
+    // Segments are split once they grow past twice this many entries.
+    static constexpr size_t kTargetSegmentSize = 512;
+
+    const_iterator begin() const {
+        return {&_segments, 0, 0};
+    }
+    const_iterator end() const {
+        return {&_segments, _segments.size(), 0};
+    }
+    const_iterator cbegin() const {
+        return begin();
+    }
+    const_iterator cend() const {
+        return end();
+    }
+
+    size_t size() const {
+        return _size;
+    }
+    bool empty() const {
+        return _size == 0;
+    }
+
+    /**
+     * Returns the first entry whose key is greater than (upper_bound) or not less than
+     * (lower_bound) 'key'.
+     */
+    const_iterator upper_bound(StringData key) const;
+    const_iterator lower_bound(StringData key) const;
+
+    /**
+     * Returns the chunk whose max is exactly 'key', which must exist.
+     */
+    const std::shared_ptr<ChunkInfo>& at(StringData key) const;
+
+    /**
+     * Removes the entries in [first, last). Iterators into this map are invalidated.
+     */
+    void erase(const_iterator first, const_iterator last);
+
+    /**
+     * Inserts 'entry', whose key must not already be present. Iterators into this map are
+     * invalidated.
+     */
+    void insert(value_type entry);
+
+    size_t numSegments_forTest() const {
+        return _segments.size();
+    }
+
+private:
+    /**
+     * Returns the segment at 'segmentIdx' for modification, first copying it if it is shared with
+     * another map.
+     */
+    Segment& _mutableSegment(size_t segmentIdx);
+
+    SegmentVector _segments;
+    size_t _size = 0;
+};
 
 struct ShardVersionTargetingInfo {
     // Indicates whether the shard is stale and thus needs a catalog cache refresh. Is false by
@@ -60,6 +203,10 @@ struct ShardVersionTargetingInfo {
     // Max chunk version for the shard.
     ChunkVersion shardVersion;
 
+    // Number of chunks on the shard. Lets a refresh maintain the shard versions from the changed
+    // chunks alone.
+    size_t numChunks = 0;
+
     ShardVersionTargetingInfo(const OID& epoch);
 };
 
@@ -188,11 +335,28 @@ private:
                         ChunkInfoMap chunkMap,
                         ChunkVersion collectionVersion);
 
+    RoutingTableHistory(NamespaceString nss,
+                        boost::optional<UUID> uuid,
+                        KeyPattern shardKeyPattern,
+                        std::unique_ptr<CollatorInterface> defaultCollator,
+                        bool unique,
+                        ChunkInfoMap chunkMap,
+                        ChunkVersion collectionVersion,
+                        ShardVersionMap shardVersions);
+
     /**
      * Does a single pass over the chunkMap and constructs the ShardVersionMap object.
      */
     ShardVersionMap _constructShardVersionMap() const;
 
+    /**
+     * Checks that the chunks with the given max KeyStrings, if still present in 'chunkMap', are
+     * contiguous with their neighbours. Used after applying changed chunks, since any gap or
+     * overlap they introduce must be next to one of them.
+     */
+    void _checkContinuityAround(const ChunkInfoMap& chunkMap,
+                                const std::vector<std::string>& maxKeyStrings) const;
+
     std::string _extractKeyString(const BSONObj& shardKeyValue) const;
 
     // The shard versioning mechanism hinges on keeping track of the number of times we reload
@@ -227,6 +391,20 @@ private:
     // shard does not exist, it will not have an entry in the map.
     ShardVersionMap _shardVersions;
 
+    // Maximum number of entries in '_targetingCache', zero if it is disabled.
+    const size_t _targetingCacheSize;
+
+    // Protects '_targetingCache'.
+    mutable Mutex _targetingCacheMutex =
+        MONGO_MAKE_LATCH("RoutingTableHistory::_targetingCacheMutex");
+
+    // Shards targeted by recent queries against this version of the routing table, keyed by the
+    // serialized filter and collation of the query.
+    mutable LRUCache<std::string, std::set<ShardId>> _targetingCache;
+
+    // Number of queries whose targeted shards were found in '_targetingCache'.
+    mutable uint64_t _targetingCacheHits{0};
+
     friend class ChunkManager;
 };
 
@@ -375,6 +553,12 @@ public:
                              const BSONObj& collation,
                              std::set<ShardId>* shardIds) const;
 
+    /**
+     * Returns the number of calls to getShardIdsForQuery() against this version of the routing
+     * table which were answered from its targeting cache.
+     */
+    uint64_t getTargetingCacheHits() const;
+
     /**
      * Returns all shard ids which contain chunks overlapping the range [min, max]. Please note the
      * inclusive bounds on both sides (SERVER-20768).
@@ -440,6 +624,15 @@ public:
     }
 
 private:
+    /**
+     * Computes the shard IDs for a given filter and collation, without consulting the targeting
+     * cache of the routing table.
+     */
+    void _targetShardIdsForQuery(OperationContext* opCtx,
+                                 const BSONObj& query,
+                                 const BSONObj& collation,
+                                 std::set<ShardId>* shardIds) const;
+
     std::shared_ptr<RoutingTableHistory> _rt;
     boost::optional<Timestamp> _clusterTime;
 };
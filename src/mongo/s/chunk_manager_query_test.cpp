@@ -36,6 +36,8 @@
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/s/catalog_cache_test_fixture.h"
 #include "mongo/s/chunk_manager.h"
+#include "mongo/s/mongos_server_parameters_gen.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -384,6 +386,65 @@ TEST_F(ChunkManagerQueryTest, InMultiShard) {
                  {ShardId("0"), ShardId("1"), ShardId("2")});
 }
 
+TEST_F(ChunkManagerQueryTest, LargeInMultiShard) {
+    // Most values fall into the chunks on shards 1 and 2, with a single one below them on shard 0
+    // and none in the last chunk.
+    BSONArrayBuilder inValues;
+    for (int i = 199; i >= 0; --i) {
+        inValues << i;
+    }
+    inValues << -5;
+
+    runQueryTest(BSON("a" << 1),
+                 nullptr,
+                 false,
+                 {BSON("a" << 0), BSON("a" << 100), BSON("a" << 200)},
+                 BSON("a" << BSON("$in" << inValues.arr())),
+                 BSONObj(),
+                 {ShardId("0"), ShardId("1"), ShardId("2")});
+}
+
+TEST_F(ChunkManagerQueryTest, InAndRangesAcrossChunkBoundaries) {
+    runQueryTest(BSON("a" << 1),
+                 nullptr,
+                 false,
+                 {BSON("a" << 0), BSON("a" << 100), BSON("a" << 200), BSON("a" << 300)},
+                 fromjson("{$or: [{a: {$in: [-10, 50, 100]}}, {a: {$gt: 150, $lte: 200}}]}"),
+                 BSONObj(),
+                 {ShardId("0"), ShardId("1"), ShardId("2"), ShardId("3")});
+}
+
+TEST_F(ChunkManagerQueryTest, TargetingCacheReturnsSameShardsForRepeatedQueries) {
+    const auto originalCacheSize = gRoutingTableTargetingCacheSize.load();
+    gRoutingTableTargetingCacheSize.store(1);
+    ON_BLOCK_EXIT([&] { gRoutingTableTargetingCacheSize.store(originalCacheSize); });
+
+    const ShardKeyPattern shardKeyPattern(BSON("a" << 1));
+    auto chunkManager = makeChunkManager(
+        kNss, shardKeyPattern, nullptr, false, {BSON("a" << 0), BSON("a" << 100)});
+
+    const auto inQuery = BSON("a" << BSON("$in" << BSON_ARRAY(-1 << 150)));
+    const auto rangeQuery = BSON("a" << BSON("$gte" << 50 << "$lt" << 60));
+
+    for (int i = 0; i < 2; ++i) {
+        std::set<ShardId> shardIds;
+        chunkManager->getShardIdsForQuery(operationContext(), inQuery, BSONObj(), &shardIds);
+        ASSERT(shardIds == std::set<ShardId>({ShardId("0"), ShardId("2")}));
+
+        // Evicts the previous query from the single entry cache.
+        shardIds.clear();
+        chunkManager->getShardIdsForQuery(operationContext(), rangeQuery, BSONObj(), &shardIds);
+        ASSERT(shardIds == std::set<ShardId>({ShardId("1")}));
+    }
+    ASSERT_EQ(0U, chunkManager->getTargetingCacheHits());
+
+    // Repeating the last query is answered from the cache.
+    std::set<ShardId> shardIds;
+    chunkManager->getShardIdsForQuery(operationContext(), rangeQuery, BSONObj(), &shardIds);
+    ASSERT(shardIds == std::set<ShardId>({ShardId("1")}));
+    ASSERT_EQ(1U, chunkManager->getTargetingCacheHits());
+}
+
 TEST_F(ChunkManagerQueryTest, CollationStringsMultiShard) {
     runQueryTest(BSON("a" << 1),
                  nullptr,
@@ -37,6 +37,17 @@ namespace mongo {
 
 namespace {
 
+AsyncRequestsSender::Request attachTxnDetails(OperationContext* opCtx,
+                                              const AsyncRequestsSender::Request& request) {
+    auto txnRouter = TransactionRouter::get(opCtx);
+    if (!txnRouter) {
+        return request;
+    }
+
+    return {request.shardId,
+            txnRouter.attachTxnFieldsIfNeeded(opCtx, request.shardId, request.cmdObj)};
+}
+
 std::vector<AsyncRequestsSender::Request> attachTxnDetails(
     OperationContext* opCtx, const std::vector<AsyncRequestsSender::Request>& requests) {
     auto txnRouter = TransactionRouter::get(opCtx);
@@ -101,4 +112,9 @@ void MultiStatementTransactionRequestsSender::stopRetrying() {
     _ars.stopRetrying();
 }
 
+void MultiStatementTransactionRequestsSender::addRequest(
+    const AsyncRequestsSender::Request& request) {
+    _ars.addRequest(attachTxnDetails(_opCtx, request));
+}
+
 }  // namespace mongo
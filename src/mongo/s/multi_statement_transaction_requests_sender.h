@@ -59,6 +59,8 @@ public:
 
     void stopRetrying();
 
+    void addRequest(const AsyncRequestsSender::Request& request);
+
 private:
     OperationContext* _opCtx;
     AsyncRequestsSender _ars;
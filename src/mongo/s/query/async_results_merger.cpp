@@ -41,6 +41,7 @@
 #include "mongo/db/query/killcursors_request.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/executor/remote_command_response.h"
+#include "mongo/s/query/async_results_merger_knobs_gen.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
@@ -82,6 +83,17 @@ int compareSortKeys(BSONObj leftSortKey, BSONObj rightSortKey, BSONObj sortKeyPa
     return leftSortKey.woCompare(rightSortKey, sortKeyPattern, rules);
 }
 
+/**
+ * Returns the Ordering with which to encode sort keys as KeyStrings for the sort pattern 'sort', or
+ * boost::none if there is no sort or it has more fields than an Ordering can describe.
+ */
+boost::optional<Ordering> makeSortKeyOrdering(const boost::optional<BSONObj>& sort) {
+    if (!sort || static_cast<size_t>(sort->nFields()) > Ordering::kMaxCompoundIndexKeys) {
+        return boost::none;
+    }
+    return Ordering::make(*sort);
+}
+
 }  // namespace
 
 AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
@@ -94,6 +106,7 @@ AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
       // since that is not supported we treat boost::none (unspecified) to mean 'kNormal'.
       _tailableMode(params.getTailableMode().value_or(TailableModeEnum::kNormal)),
       _params(std::move(params)),
+      _sortKeyOrdering(makeSortKeyOrdering(_params.getSort())),
       _mergeQueue(MergingComparator(
           _remotes, _params.getSort().value_or(BSONObj()), _params.getCompareWholeSortKey())),
       _promisedMinSortKeys(PromisedMinSortKeyComparator(_params.getSort().value_or(BSONObj()))) {
@@ -324,7 +337,7 @@ StatusWith<ClusterQueryResult> AsyncResultsMerger::nextReady() {
     return _params.getSort() ? _nextReadySorted(lk) : _nextReadyUnsorted(lk);
 }
 
-ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
+ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock lk) {
     // Tailable non-awaitData cursors cannot have a sort.
     invariant(_tailableMode != TailableModeEnum::kTailable);
 
@@ -340,6 +353,9 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
 
     ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
     _remotes[smallestRemote].docBuffer.pop();
+    if (_sortKeyOrdering) {
+        _remotes[smallestRemote].sortKeyBuffer.pop();
+    }
 
     // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
     // next result.
@@ -347,6 +363,8 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
         _mergeQueue.push(smallestRemote);
     }
 
+    _prefetchNextBatchIfLow(lk, smallestRemote);
+
     // For sorted tailable awaitData cursors, update the high water mark to the document's sort key.
     if (_tailableMode == TailableModeEnum::kTailableAndAwaitData) {
         _highWaterMark =
@@ -356,7 +374,7 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
     return front;
 }
 
-ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
+ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock lk) {
     size_t remotesAttempted = 0;
     while (remotesAttempted < _remotes.size()) {
         // It is illegal to call this method if there is an error received from any shard.
@@ -374,6 +392,7 @@ ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
                 _eofNext = true;
             }
 
+            _prefetchNextBatchIfLow(lk, _gettingFromRemote);
             return front;
         }
 
@@ -387,24 +406,73 @@ ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
     return {};
 }
 
-Status AsyncResultsMerger::_askForNextBatch(WithLock, size_t remoteIndex) {
-    invariant(_opCtx, "Cannot schedule a getMore without an OperationContext");
+boost::optional<std::int64_t> AsyncResultsMerger::_getMoreBatchSize(WithLock,
+                                                                  size_t remoteIndex) {
     auto& remote = _remotes[remoteIndex];
 
-    invariant(!remote.cbHandle.isValid());
+    if (_params.getBatchSize()) {
+        // If mongod returned less docs than the requested batchSize then modify the next getMore
+        // request to fetch the remaining docs only. If the remote node has a plan with OR for top k
+        // and a full sort as is the case for the OP_QUERY find then this optimization will prevent
+        // switching to the full sort plan branch.
+        if (*_params.getBatchSize() > remote.fetchedCount) {
+            return *_params.getBatchSize() - remote.fetchedCount;
+        }
+        return _params.getBatchSize();
+    }
 
-    // If mongod returned less docs than the requested batchSize then modify the next getMore
-    // request to fetch the remaining docs only. If the remote node has a plan with OR for top k and
-    // a full sort as is the case for the OP_QUERY find then this optimization will prevent
-    // switching to the full sort plan branch.
-    auto adjustedBatchSize = _params.getBatchSize();
-    if (_params.getBatchSize() && *_params.getBatchSize() > remote.fetchedCount) {
-        adjustedBatchSize = *_params.getBatchSize() - remote.fetchedCount;
+    const long long maxAdaptiveBatchSize = internalQueryMergerMaxAdaptiveBatchSize.load();
+    if (maxAdaptiveBatchSize <= 0 || _tailableMode != TailableModeEnum::kNormal) {
+        return boost::none;
+    }
+
+    // Start from the size of the batch the remote last sent, and double the batch size each time
+    // we have to wait on the remote because everything fetched from it has already been consumed.
+    if (!remote.adaptiveBatchSize) {
+        remote.adaptiveBatchSize =
+            remote.lastBatchSize ? remote.lastBatchSize : maxAdaptiveBatchSize;
+    } else if (!remote.hasNext()) {
+        remote.adaptiveBatchSize *= 2;
+    }
+    remote.adaptiveBatchSize = std::min(remote.adaptiveBatchSize, maxAdaptiveBatchSize);
+
+    return remote.adaptiveBatchSize;
+}
+
+void AsyncResultsMerger::_prefetchNextBatchIfLow(WithLock lk, size_t remoteIndex) {
+    const double watermark = internalQueryMergerPrefetchWatermark.load();
+    if (watermark <= 0) {
+        return;
+    }
+
+    // Tailable cursors pass the batches they receive from the remotes through as they are, and the
+    // statements of a transaction, including its getMores, must not run concurrently on a shard.
+    if (_tailableMode != TailableModeEnum::kNormal || _params.getTxnNumber() || !_opCtx ||
+        _lifecycleState != kAlive) {
+        return;
     }
 
+    auto& remote = _remotes[remoteIndex];
+    if (!remote.status.isOK() || remote.exhausted() || remote.cbHandle.isValid()) {
+        return;
+    }
+
+    if (static_cast<double>(remote.docBuffer.size()) > watermark * remote.lastBatchSize) {
+        return;
+    }
+
+    remote.status = _askForNextBatch(lk, remoteIndex);
+}
+
+Status AsyncResultsMerger::_askForNextBatch(WithLock lk, size_t remoteIndex) {
+    invariant(_opCtx, "Cannot schedule a getMore without an OperationContext");
+    auto& remote = _remotes[remoteIndex];
+
+    invariant(!remote.cbHandle.isValid());
+
     BSONObj cmdObj = GetMoreRequest(remote.cursorNss,
                                     remote.cursorId,
-                                    adjustedBatchSize,
+                                    _getMoreBatchSize(lk, remoteIndex),
                                     _awaitDataTimeout,
                                     boost::none,
                                     boost::none)
@@ -617,6 +685,8 @@ void AsyncResultsMerger::_cleanUpFailedBatch(WithLock lk, Status status, size_t
         remote.partialResultsReturned = (remote.status != ErrorCodes::ExchangePassthrough);
         std::queue<ClusterQueryResult> emptyBuffer;
         std::swap(remote.docBuffer, emptyBuffer);
+        std::queue<KeyString::Value> emptySortKeyBuffer;
+        std::swap(remote.sortKeyBuffer, emptySortKeyBuffer);
         remote.status = Status::OK();
         remote.cursorId = 0;
     }
@@ -671,6 +741,12 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
                                            size_t remoteIndex,
                                            const CursorResponse& response) {
     auto& remote = _remotes[remoteIndex];
+
+    // A sorted remote is on the merge queue exactly while it has buffered results. With
+    // prefetching, a batch may arrive while earlier results are still buffered, in which case the
+    // remote must not be queued a second time.
+    const bool wasQueued = !remote.docBuffer.empty();
+
     _updateRemoteMetadata(lk, remoteIndex, response);
     for (const auto& obj : response.getBatch()) {
         // If there's a sort, we're expecting the remote node to have given us back a sort key.
@@ -691,14 +767,23 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
             }
         }
 
+        if (_sortKeyOrdering) {
+            KeyString::Builder sortKey(
+                KeyString::Version::kLatestVersion,
+                extractSortKey(obj, _params.getCompareWholeSortKey()),
+                *_sortKeyOrdering);
+            remote.sortKeyBuffer.push(sortKey.getValueCopy());
+        }
+
         ClusterQueryResult result(obj);
         remote.docBuffer.push(result);
         ++remote.fetchedCount;
     }
+    remote.lastBatchSize = response.getBatch().size();
 
     // If we're doing a sorted merge, then we have to make sure to put this remote onto the merge
     // queue.
-    if (_params.getSort() && !response.getBatch().empty()) {
+    if (_params.getSort() && !wasQueued && !response.getBatch().empty()) {
         _mergeQueue.push(remoteIndex);
     }
     return true;
@@ -816,6 +901,12 @@ bool AsyncResultsMerger::RemoteCursorData::exhausted() const {
 //
 
 bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const size_t& rhs) {
+    // Sort keys are pre-encoded as KeyStrings unless the sort has too many fields.
+    if (!_remotes[lhs].sortKeyBuffer.empty()) {
+        return _remotes[lhs].sortKeyBuffer.front().compare(_remotes[rhs].sortKeyBuffer.front()) >
+            0;
+    }
+
     const ClusterQueryResult& leftDoc = _remotes[lhs].docBuffer.front();
     const ClusterQueryResult& rightDoc = _remotes[rhs].docBuffer.front();
 
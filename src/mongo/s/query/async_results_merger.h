@@ -35,7 +35,9 @@
 
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj.h"
+#include "mongo/bson/ordering.h"
 #include "mongo/db/cursor_id.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/s/query/async_results_merger_params_gen.h"
@@ -67,6 +69,10 @@ class CursorResponse;
  * This requires waiting until we have a response from every remote before returning results.
  * Without a sort, we are ready to return results as soon as we have *any* response from a remote.
  *
+ * By default the next batch is requested from a remote once its buffered results run out. If
+ * 'internalQueryMergerPrefetchWatermark' is set, it is instead requested once the buffer runs low,
+ * so that the round trip overlaps with returning the results still buffered.
+ *
  * On any error, the caller is responsible for shutting down the ARM using the kill() method.
  *
  * Does not throw exceptions.
@@ -305,6 +311,18 @@ private:
         // The buffer of results that have been retrieved but not yet returned to the caller.
         std::queue<ClusterQueryResult> docBuffer;
 
+        // Only used if there is a sort with no more fields than an Ordering can describe. The sort
+        // keys of the results in 'docBuffer', in the same order, encoded as KeyStrings so that
+        // merging compares them with a memcmp rather than a BSON comparison.
+        std::queue<KeyString::Value> sortKeyBuffer;
+
+        // The number of results in the last batch received from this remote.
+        long long lastBatchSize = 0;
+
+        // The batchSize requested in the last getMore when batch sizes are adapted to how fast
+        // results are consumed from this remote, or 0 if none has been requested yet.
+        long long adaptiveBatchSize = 0;
+
         // Is valid if there is currently a pending request to this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
 
@@ -369,6 +387,17 @@ private:
      */
     Status _askForNextBatch(WithLock, size_t remoteIndex);
 
+    /**
+     * Asks the remote at 'remoteIndex' for its next batch ahead of time if prefetching is enabled
+     * and the results buffered from it have fallen to the prefetch watermark.
+     */
+    void _prefetchNextBatchIfLow(WithLock, size_t remoteIndex);
+
+    /**
+     * Returns the batchSize to request in the next getMore to the remote at 'remoteIndex'.
+     */
+    boost::optional<std::int64_t> _getMoreBatchSize(WithLock, size_t remoteIndex);
+
     /**
      * Checks whether or not the remote cursors are all exhausted.
      */
@@ -463,6 +492,10 @@ private:
     TailableModeEnum _tailableMode;
     AsyncResultsMergerParams _params;
 
+    // The ordering used to encode the sort keys of buffered results as KeyStrings. Unset if there
+    // is no sort, or if the sort has too many fields to be described by an Ordering.
+    const boost::optional<Ordering> _sortKeyOrdering;
+
     // Must be acquired before accessing any data members (other than _params, which is read-only).
     mutable Mutex _mutex = MONGO_MAKE_LATCH("AsyncResultsMerger::_mutex");
 
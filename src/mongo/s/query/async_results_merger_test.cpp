@@ -41,9 +41,11 @@
 #include "mongo/db/query/query_request.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/s/client/shard_registry.h"
+#include "mongo/s/query/async_results_merger_knobs_gen.h"
 #include "mongo/s/query/results_merger_test_fixture.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -1115,6 +1117,172 @@ TEST_F(AsyncResultsMergerTest, GetMoreBatchSizes) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, MultiShardSortedDescendingCompoundSortKey) {
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: 1, b: -1}}");
+    std::vector<RemoteCursor> cursors;
+    std::vector<BSONObj> batch1 = {fromjson("{$sortKey: [1, 5]}"),
+                                   fromjson("{$sortKey: [2, 'x']}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, CursorId(0), batch1)));
+    std::vector<BSONObj> batch2 = {fromjson("{$sortKey: [1, 7.5]}"),
+                                   fromjson("{$sortKey: [2, 3]}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, CursorId(0), batch2)));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    // Numbers of different types compare by value, and strings sort after numbers.
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [1, 7.5]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [1, 5]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [2, 'x']}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [2, 3]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
+TEST_F(AsyncResultsMergerTest, PrefetchesNextBatchBelowWatermark) {
+    const auto originalWatermark = internalQueryMergerPrefetchWatermark.load();
+    internalQueryMergerPrefetchWatermark.store(0.5);
+    ON_BLOCK_EXIT([&] { internalQueryMergerPrefetchWatermark.store(originalWatermark); });
+
+    BSONObj findCmd = fromjson("{find: 'testcoll'}");
+    std::vector<RemoteCursor> cursors;
+    std::vector<BSONObj> batch1 = {
+        fromjson("{_id: 1}"), fromjson("{_id: 2}"), fromjson("{_id: 3}"), fromjson("{_id: 4}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, CursorId(1), batch1)));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    // No getMore is sent while more than half of the batch is still buffered.
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 1}"), *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_FALSE(networkHasReadyRequests());
+
+    // Returning the second result leaves the buffer at the watermark, so the next batch is
+    // requested while the rest of the buffer is returned.
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 2}"), *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(networkHasReadyRequests());
+
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch2 = {fromjson("{_id: 5}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch2);
+    scheduleNetworkResponses(std::move(responses));
+
+    for (int id = 3; id <= 5; ++id) {
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(BSON("_id" << id), *unittest::assertGet(arm->nextReady()).getResult());
+    }
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
+TEST_F(AsyncResultsMergerTest, PrefetchesNextBatchBelowWatermarkSorted) {
+    const auto originalWatermark = internalQueryMergerPrefetchWatermark.load();
+    internalQueryMergerPrefetchWatermark.store(0.5);
+    ON_BLOCK_EXIT([&] { internalQueryMergerPrefetchWatermark.store(originalWatermark); });
+
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {_id: 1}}");
+    std::vector<RemoteCursor> cursors;
+    std::vector<BSONObj> batch1 = {fromjson("{$sortKey: {'': 1}}"),
+                                   fromjson("{$sortKey: {'': 2}}"),
+                                   fromjson("{$sortKey: {'': 3}}"),
+                                   fromjson("{$sortKey: {'': 4}}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, CursorId(1), batch1)));
+    std::vector<BSONObj> batch2 = {fromjson("{$sortKey: {'': 10}}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, CursorId(0), batch2)));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 1}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_FALSE(networkHasReadyRequests());
+
+    // The next batch of the first shard is requested while two of its results are still buffered,
+    // so that shard is still on the merge queue when the batch arrives.
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 2}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(networkHasReadyRequests());
+
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch3 = {fromjson("{$sortKey: {'': 5}}"),
+                                   fromjson("{$sortKey: {'': 6}}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch3);
+    scheduleNetworkResponses(std::move(responses));
+
+    // Every result is returned exactly once and in order, and the merge ends once both shards are
+    // drained.
+    for (int key : {3, 4, 5, 6, 10}) {
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(BSON("$sortKey" << BSON("" << key)),
+                          *unittest::assertGet(arm->nextReady()).getResult());
+    }
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
+TEST_F(AsyncResultsMergerTest, AdaptiveGetMoreBatchSizes) {
+    const auto originalMaxBatchSize = internalQueryMergerMaxAdaptiveBatchSize.load();
+    internalQueryMergerMaxAdaptiveBatchSize.store(8);
+    ON_BLOCK_EXIT([&] { internalQueryMergerMaxAdaptiveBatchSize.store(originalMaxBatchSize); });
+
+    BSONObj findCmd = fromjson("{find: 'testcoll'}");
+    std::vector<RemoteCursor> cursors;
+    std::vector<BSONObj> firstBatch = {fromjson("{_id: 1}"), fromjson("{_id: 2}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, CursorId(1), firstBatch)));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    // Returns the buffered results, checking that their ids follow on from the previous ones, and
+    // whether the end of the stream was reached.
+    int nextId = 1;
+    auto drainBuffer = [&] {
+        while (arm->ready()) {
+            auto next = unittest::assertGet(arm->nextReady());
+            if (next.isEOF()) {
+                return true;
+            }
+            ASSERT_BSONOBJ_EQ(BSON("_id" << nextId++), *next.getResult());
+        }
+        return false;
+    };
+
+    // Each getMore starts from the size of the previous batch and doubles, since the merge had to
+    // wait on the shard every time, until it reaches the cap.
+    const std::vector<long long> expectedBatchSizes = {2, 4, 8, 8};
+    for (size_t i = 0; i < expectedBatchSizes.size(); ++i) {
+        ASSERT_FALSE(drainBuffer());
+
+        auto readyEvent = unittest::assertGet(arm->nextEvent());
+        auto request = GetMoreRequest::parseFromBSON("anydbname", getNthPendingRequest(0).cmdObj);
+        ASSERT_OK(request.getStatus());
+        ASSERT_EQ(*request.getValue().batchSize, expectedBatchSizes[i]);
+
+        std::vector<BSONObj> batch;
+        for (long long j = 0; j < expectedBatchSizes[i]; ++j) {
+            batch.push_back(BSON("_id" << nextId + static_cast<int>(j)));
+        }
+        const bool lastBatch = i + 1 == expectedBatchSizes.size();
+        std::vector<CursorResponse> responses;
+        responses.emplace_back(kTestNss, CursorId(lastBatch ? 0 : 1), batch);
+        scheduleNetworkResponses(std::move(responses));
+        executor()->waitForEvent(readyEvent);
+    }
+
+    ASSERT_TRUE(drainBuffer());
+    ASSERT_EQ(nextId, 25);
+}
+
 TEST_F(AsyncResultsMergerTest, AllowPartialResults) {
     BSONObj findCmd = fromjson("{find: 'testcoll', allowPartialResults: true}");
     std::vector<RemoteCursor> cursors;
@@ -181,6 +181,8 @@ void updateHostsTargetedMetrics(OperationContext* opCtx,
 
     auto nShardsTargeted = CurOp::get(opCtx)->debug().nShards;
     if (nShardsTargeted > 0) {
+        CurOp::get(opCtx)->debug().nShardsOwningChunks = shardsOwningChunks.size();
+
         auto targetType = NumHostsTargetedMetrics::get(opCtx).parseTargetType(
             opCtx, nShardsTargeted, shardsOwningChunks.size());
         NumHostsTargetedMetrics::get(opCtx).addNumHostsTargeted(
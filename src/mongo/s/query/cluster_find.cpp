@@ -47,6 +47,7 @@
 #include "mongo/db/curop_failpoint_helpers.h"
 #include "mongo/db/logical_clock.h"
 #include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/canonical_query_encoder.h"
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/query_planner_common.h"
@@ -61,6 +62,7 @@
 #include "mongo/s/query/async_results_merger.h"
 #include "mongo/s/query/cluster_client_cursor_impl.h"
 #include "mongo/s/query/cluster_cursor_manager.h"
+#include "mongo/s/query/cluster_query_result_cache.h"
 #include "mongo/s/query/establish_cursors.h"
 #include "mongo/s/query/store_possible_cursor.h"
 #include "mongo/s/stale_exception.h"
@@ -229,12 +231,30 @@ void updateNumHostsTargetedMetrics(OperationContext* opCtx,
         nShardsOwningChunks = routingInfo.cm()->getNShardsOwningChunks();
     }
 
+    CurOp::get(opCtx)->debug().nShardsOwningChunks = nShardsOwningChunks;
+
     auto targetType = NumHostsTargetedMetrics::get(opCtx).parseTargetType(
         opCtx, nTargetedShards, nShardsOwningChunks);
     NumHostsTargetedMetrics::get(opCtx).addNumHostsTargeted(
         NumHostsTargetedMetrics::QueryType::kFindCmd, targetType);
 }
 
+/**
+ * Returns the version of the routing table against which cached results for the collection are
+ * valid: the collection version if the collection is sharded, or else the version and primary shard
+ * of its database.
+ */
+BSONObj makeResultCacheRoutingVersion(const CachedCollectionRoutingInfo& routingInfo) {
+    BSONObjBuilder builder;
+    if (auto cm = routingInfo.cm()) {
+        cm->getVersion().appendLegacyWithField(&builder, "collectionVersion");
+    } else {
+        builder.append("primaryShard", routingInfo.db().primaryId().toString());
+        builder.append("databaseVersion", routingInfo.db().databaseVersion().toBSON());
+    }
+    return builder.obj();
+}
+
 CursorId runQueryWithoutRetrying(OperationContext* opCtx,
                                  const CanonicalQuery& query,
                                  const ReadPreferenceSetting& readPref,
@@ -493,8 +513,16 @@ CursorId ClusterFind::runQuery(OperationContext* opCtx,
             !query.getQueryRequest().getRequestResumeToken() &&
                 query.getQueryRequest().getResumeAfter().isEmpty());
 
+    // Record the query shape, so that the shards targeted by each query (reported alongside it in
+    // the slow query log and the profiler) can be attributed to its shape.
+    CurOp::get(opCtx)->debug().queryHash = canonical_query_encoder::computeHash(query.encodeKey());
+
     auto const catalogCache = Grid::get(opCtx)->catalogCache();
 
+    auto const resultCache = ClusterQueryResultCache::get(opCtx);
+    auto const clock = opCtx->getServiceContext()->getFastClockSource();
+    const auto resultCacheKey = ClusterQueryResultCache::makeKey(opCtx, query, readPref);
+
     // Re-target and re-send the initial find command to the shards until we have established the
     // shard version.
     for (size_t retries = 1; retries <= kMaxRetries; ++retries) {
@@ -507,9 +535,29 @@ CursorId ClusterFind::runQuery(OperationContext* opCtx,
 
         auto routingInfo = uassertStatusOK(routingInfoStatus);
 
+        // Serve the query from the result cache if it was last run against the same routing table.
+        // Queries whose first batch did not exhaust the cursor are never cached, so a cached entry
+        // always holds the complete result set.
+        const auto routingVersion =
+            resultCacheKey ? makeResultCacheRoutingVersion(routingInfo) : BSONObj();
+        if (resultCacheKey) {
+            auto cachedResults = resultCache->lookup(*resultCacheKey, routingVersion, clock->now());
+            if (cachedResults) {
+                *results = std::move(*cachedResults);
+                CurOp::get(opCtx)->debug().nreturned = results->size();
+                CurOp::get(opCtx)->debug().cursorExhausted = true;
+                return CursorId(0);
+            }
+        }
+
         try {
-            return runQueryWithoutRetrying(
+            auto cursorId = runQueryWithoutRetrying(
                 opCtx, query, readPref, routingInfo, results, partialResultsReturned);
+            if (resultCacheKey) {
+                resultCache->insert(
+                    *resultCacheKey, routingVersion, cursorId, *results, clock->now());
+            }
+            return cursorId;
         } catch (ExceptionFor<ErrorCodes::StaleDbVersion>& ex) {
             if (retries >= kMaxRetries) {
                 // Check if there are no retries remaining, so the last received error can be
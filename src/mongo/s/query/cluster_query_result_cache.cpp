@@ -0,0 +1,248 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/query/cluster_query_result_cache.h"
+
+#include <limits>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/client/read_preference.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_planner_common.h"
+#include "mongo/db/repl/read_concern_args.h"
+#include "mongo/s/query/cluster_query_knobs_gen.h"
+#include "mongo/s/transaction_router.h"
+
+namespace mongo {
+namespace {
+
+const auto getClusterQueryResultCache =
+    ServiceContext::declareDecoration<ClusterQueryResultCache>();
+
+std::string makeCacheKey(const BSONObj& key) {
+    return std::string(key.objdata(), key.objsize());
+}
+
+}  // namespace
+
+ClusterQueryResultCache::ClusterQueryResultCache()
+    : _cache(std::numeric_limits<std::size_t>::max()) {}
+
+ClusterQueryResultCache* ClusterQueryResultCache::get(ServiceContext* service) {
+    return &getClusterQueryResultCache(service);
+}
+
+ClusterQueryResultCache* ClusterQueryResultCache::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+bool ClusterQueryResultCache::isEnabled() {
+    return internalQueryClusterResultCacheMaxSizeBytes.load() > 0;
+}
+
+boost::optional<BSONObj> ClusterQueryResultCache::makeKey(OperationContext* opCtx,
+                                                          const CanonicalQuery& query,
+                                                          const ReadPreferenceSetting& readPref) {
+    if (!isEnabled()) {
+        return boost::none;
+    }
+
+    // Reads in a transaction or with causal consistency must observe the writes preceding them,
+    // which a result cached before those writes might not reflect.
+    if (TransactionRouter::get(opCtx)) {
+        return boost::none;
+    }
+
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    if (readConcernArgs.getArgsAfterClusterTime() || readConcernArgs.getArgsAtClusterTime() ||
+        readConcernArgs.getArgsOpTime() ||
+        readConcernArgs.getLevel() == repl::ReadConcernLevel::kLinearizableReadConcern ||
+        readConcernArgs.getLevel() == repl::ReadConcernLevel::kSnapshotReadConcern) {
+        return boost::none;
+    }
+
+    const auto& qr = query.getQueryRequest();
+    if (qr.isTailable() || qr.isAllowPartialResults()) {
+        return boost::none;
+    }
+
+    // Filters and projections which evaluate expressions may depend on $$NOW, $rand or server-side
+    // JavaScript, so their results cannot be reused.
+    if (QueryPlannerCommon::hasNode(query.root(), MatchExpression::EXPRESSION) ||
+        QueryPlannerCommon::hasNode(query.root(), MatchExpression::WHERE) ||
+        (query.getProj() && query.getProj()->hasExpressions())) {
+        return boost::none;
+    }
+
+    BSONObjBuilder keyBuilder;
+    keyBuilder.append("ns", query.nss().ns());
+    keyBuilder.append("shape", query.encodeKey());
+    {
+        // The runtime constants and the time limit differ between executions of the same query
+        // without affecting its results.
+        BSONObjBuilder findBuilder(keyBuilder.subobjStart("find"));
+        for (auto&& elem : qr.asFindCommand()) {
+            const auto fieldName = elem.fieldNameStringData();
+            if (fieldName != QueryRequest::kRuntimeConstantsField &&
+                fieldName != QueryRequest::cmdOptionMaxTimeMS) {
+                findBuilder.append(elem);
+            }
+        }
+    }
+    keyBuilder.append("readConcern", readConcernArgs.toBSONInner());
+    keyBuilder.append("readPreference", readPref.toInnerBSON());
+    return keyBuilder.obj();
+}
+
+boost::optional<std::vector<BSONObj>> ClusterQueryResultCache::lookup(
+    const BSONObj& key, const BSONObj& routingVersion, Date_t now) {
+    const auto maxSizeBytes = internalQueryClusterResultCacheMaxSizeBytes.load();
+
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    // The size limit may have been lowered or the cache disabled since the last insert.
+    _evictToSize(lk, maxSizeBytes);
+
+    auto it = _cache.find(makeCacheKey(key));
+    if (it == _cache.end()) {
+        _numMisses.fetchAndAdd(1);
+        return boost::none;
+    }
+
+    if (!SimpleBSONObjComparator::kInstance.evaluate(it->second.routingVersion ==
+                                                     routingVersion)) {
+        _numInvalidations.fetchAndAdd(1);
+        _numMisses.fetchAndAdd(1);
+        _erase(lk, it);
+        return boost::none;
+    }
+
+    if (it->second.expiresAt <= now) {
+        _numExpirations.fetchAndAdd(1);
+        _numMisses.fetchAndAdd(1);
+        _erase(lk, it);
+        return boost::none;
+    }
+
+    _numHits.fetchAndAdd(1);
+    return it->second.results;
+}
+
+void ClusterQueryResultCache::insert(const BSONObj& key,
+                                     const BSONObj& routingVersion,
+                                     CursorId cursorId,
+                                     const std::vector<BSONObj>& results,
+                                     Date_t now) {
+    // The remaining results of an open cursor would have to be fetched from the shards.
+    if (cursorId != CursorId(0)) {
+        return;
+    }
+
+    const auto maxSizeBytes = internalQueryClusterResultCacheMaxSizeBytes.load();
+    const auto ttl = Milliseconds(internalQueryClusterResultCacheTTLMillis.load());
+
+    auto cacheKey = makeCacheKey(key);
+
+    Entry entry;
+    entry.routingVersion = routingVersion.getOwned();
+    entry.expiresAt = now + ttl;
+    entry.sizeBytes = cacheKey.size() + entry.routingVersion.objsize();
+    entry.results.reserve(results.size());
+    for (const auto& result : results) {
+        entry.results.push_back(result.getOwned());
+        entry.sizeBytes += result.objsize();
+    }
+
+    if (entry.sizeBytes > maxSizeBytes) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    auto it = _cache.cfind(cacheKey);
+    if (it != _cache.end()) {
+        _sizeBytes -= it->second.sizeBytes;
+    }
+
+    _sizeBytes += entry.sizeBytes;
+    _cache.add(cacheKey, std::move(entry));
+    _numInserts.fetchAndAdd(1);
+
+    _evictToSize(lk, maxSizeBytes);
+}
+
+void ClusterQueryResultCache::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _cache.clear();
+    _sizeBytes = 0;
+}
+
+void ClusterQueryResultCache::report(BSONObjBuilder* builder) const {
+    long long numEntries;
+    long long sizeBytes;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        numEntries = _cache.size();
+        sizeBytes = _sizeBytes;
+    }
+
+    const auto numHits = _numHits.load();
+    const auto numMisses = _numMisses.load();
+
+    builder->append("enabled", isEnabled());
+    builder->append("numEntries", numEntries);
+    builder->append("sizeBytes", sizeBytes);
+    builder->append("maxSizeBytes", internalQueryClusterResultCacheMaxSizeBytes.load());
+    builder->append("hits", numHits);
+    builder->append("misses", numMisses);
+    builder->append("hitRate",
+                    numHits + numMisses > 0 ? double(numHits) / (numHits + numMisses) : 0.0);
+    builder->append("inserts", _numInserts.load());
+    builder->append("invalidations", _numInvalidations.load());
+    builder->append("expirations", _numExpirations.load());
+    builder->append("evictions", _numEvictions.load());
+}
+
+ClusterQueryResultCache::Cache::iterator ClusterQueryResultCache::_erase(WithLock,
+                                                                         Cache::iterator it) {
+    _sizeBytes -= it->second.sizeBytes;
+    return _cache.erase(it);
+}
+
+void ClusterQueryResultCache::_evictToSize(WithLock lk, long long maxSizeBytes) {
+    while (_sizeBytes > maxSizeBytes && !_cache.empty()) {
+        _erase(lk, std::prev(_cache.end()));
+        _numEvictions.fetchAndAdd(1);
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,158 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/cursor_id.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/lru_cache.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class CanonicalQuery;
+struct ReadPreferenceSetting;
+
+/**
+ * Caches the complete result sets of read-only find commands run through mongos, so that repeated
+ * executions of the same query can be answered without contacting the shards.
+ *
+ * Each entry is stored under a key which uniquely identifies the query (its shape, parameters,
+ * read concern and read preference) together with the routing table version of the collection
+ * against which the results were produced. A lookup with a different routing version drops the
+ * entry, and every entry expires after 'internalQueryClusterResultCacheTTLMillis'. The memory used
+ * by the cache is bounded by 'internalQueryClusterResultCacheMaxSizeBytes', beyond which the least
+ * recently used entries are evicted. A maximum size of zero disables the cache.
+ *
+ * Aggregations are not cached. Their pipelines may write ($out, $merge) or read collections other
+ * than the one they run on ($lookup, $graphLookup, $unionWith), whose routing versions an entry
+ * would also have to record.
+ *
+ * This class is thread-safe.
+ */
+class ClusterQueryResultCache {
+    ClusterQueryResultCache(const ClusterQueryResultCache&) = delete;
+    ClusterQueryResultCache& operator=(const ClusterQueryResultCache&) = delete;
+
+public:
+    ClusterQueryResultCache();
+
+    static ClusterQueryResultCache* get(ServiceContext* service);
+    static ClusterQueryResultCache* get(OperationContext* opCtx);
+
+    /**
+     * Returns true if the cache is currently enabled through its server parameters.
+     */
+    static bool isEnabled();
+
+    /**
+     * Returns the key under which the results of 'query' may be cached, or boost::none if the
+     * cache is disabled or the query is not guaranteed to return the same results when re-run
+     * against unchanged data: reads in a transaction, causally consistent, linearizable and
+     * snapshot reads, tailable and partial results queries, and queries whose filter or
+     * projection evaluates expressions.
+     */
+    static boost::optional<BSONObj> makeKey(OperationContext* opCtx,
+                                            const CanonicalQuery& query,
+                                            const ReadPreferenceSetting& readPref);
+
+    /**
+     * Returns the results cached under 'key', or boost::none if there are none which were
+     * produced against 'routingVersion' and are still within their time to live as of 'now'.
+     */
+    boost::optional<std::vector<BSONObj>> lookup(const BSONObj& key,
+                                                 const BSONObj& routingVersion,
+                                                 Date_t now);
+
+    /**
+     * Caches 'results' under 'key', replacing any previous entry, and evicts the least recently
+     * used entries until the cache is within its size limit again. Result sets which on their own
+     * exceed the size limit are not cached, nor are the incomplete results of a query whose cursor
+     * 'cursorId' is still open.
+     */
+    void insert(const BSONObj& key,
+                const BSONObj& routingVersion,
+                CursorId cursorId,
+                const std::vector<BSONObj>& results,
+                Date_t now);
+
+    /**
+     * Drops all cached results.
+     */
+    void clear();
+
+    /**
+     * Appends the hit rate and memory usage statistics of the cache to 'builder'.
+     */
+    void report(BSONObjBuilder* builder) const;
+
+private:
+    struct Entry {
+        BSONObj routingVersion;
+        std::vector<BSONObj> results;
+        Date_t expiresAt;
+        long long sizeBytes;
+    };
+
+    using Cache = LRUCache<std::string, Entry>;
+
+    /**
+     * Removes the entry pointed to by 'it' and returns an iterator to the next one.
+     */
+    Cache::iterator _erase(WithLock, Cache::iterator it);
+
+    /**
+     * Evicts the least recently used entries until the cache uses no more than 'maxSizeBytes'.
+     */
+    void _evictToSize(WithLock, long long maxSizeBytes);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("ClusterQueryResultCache::_mutex");
+
+    Cache _cache;
+
+    // Total size of all cached entries, including their keys.
+    long long _sizeBytes{0};
+
+    AtomicWord<long long> _numHits{0};
+    AtomicWord<long long> _numMisses{0};
+    AtomicWord<long long> _numInserts{0};
+    AtomicWord<long long> _numInvalidations{0};
+    AtomicWord<long long> _numExpirations{0};
+    AtomicWord<long long> _numEvictions{0};
+};
+
+}  // namespace mongo
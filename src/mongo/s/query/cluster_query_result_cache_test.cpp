@@ -0,0 +1,228 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/json.h"
+#include "mongo/client/read_preference.h"
+#include "mongo/db/logical_session_id.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_test_service_context.h"
+#include "mongo/db/repl/read_concern_args.h"
+#include "mongo/s/query/cluster_query_knobs_gen.h"
+#include "mongo/s/query/cluster_query_result_cache.h"
+#include "mongo/s/session_catalog_router.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const BSONObj kKey = BSON("ns"
+                          << "test.coll"
+                          << "find" << BSON("filter" << BSON("a" << 1)));
+const BSONObj kVersion = BSON("collectionVersion" << BSON_ARRAY(Timestamp(1, 0) << OID()));
+
+class ClusterQueryResultCacheTest : public unittest::Test {
+protected:
+    ClusterQueryResultCacheTest()
+        : _originalMaxSizeBytes(internalQueryClusterResultCacheMaxSizeBytes.load()),
+          _originalTTLMillis(internalQueryClusterResultCacheTTLMillis.load()) {
+        internalQueryClusterResultCacheMaxSizeBytes.store(1024 * 1024);
+        internalQueryClusterResultCacheTTLMillis.store(1000);
+    }
+
+    ~ClusterQueryResultCacheTest() {
+        internalQueryClusterResultCacheMaxSizeBytes.store(_originalMaxSizeBytes);
+        internalQueryClusterResultCacheTTLMillis.store(_originalTTLMillis);
+    }
+
+    BSONObj report() const {
+        BSONObjBuilder builder;
+        _cache.report(&builder);
+        return builder.obj();
+    }
+
+    const Date_t _now = Date_t::fromMillisSinceEpoch(100000);
+    ClusterQueryResultCache _cache;
+
+private:
+    const long long _originalMaxSizeBytes;
+    const long long _originalTTLMillis;
+};
+
+TEST_F(ClusterQueryResultCacheTest, ReturnsCachedResultsForSameRoutingVersion) {
+    ASSERT_FALSE(_cache.lookup(kKey, kVersion, _now));
+
+    _cache.insert(kKey, kVersion, CursorId(0), {BSON("_id" << 1), BSON("_id" << 2)}, _now);
+
+    auto results = _cache.lookup(kKey, kVersion, _now + Milliseconds(10));
+    ASSERT(results);
+    ASSERT_EQ(2U, results->size());
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 2), (*results)[1]);
+
+    auto stats = report();
+    ASSERT_EQ(1, stats["hits"].numberLong());
+    ASSERT_EQ(1, stats["misses"].numberLong());
+    ASSERT_EQ(1, stats["numEntries"].numberLong());
+}
+
+TEST_F(ClusterQueryResultCacheTest, RoutingVersionChangeInvalidatesEntry) {
+    _cache.insert(kKey, kVersion, CursorId(0), {BSON("_id" << 1)}, _now);
+
+    const auto newVersion = BSON("collectionVersion" << BSON_ARRAY(Timestamp(2, 0) << OID()));
+    ASSERT_FALSE(_cache.lookup(kKey, newVersion, _now));
+
+    // The stale entry was dropped, so not even the old version finds it anymore.
+    ASSERT_FALSE(_cache.lookup(kKey, kVersion, _now));
+
+    auto stats = report();
+    ASSERT_EQ(1, stats["invalidations"].numberLong());
+    ASSERT_EQ(0, stats["numEntries"].numberLong());
+    ASSERT_EQ(0, stats["sizeBytes"].numberLong());
+}
+
+TEST_F(ClusterQueryResultCacheTest, EntriesExpireAfterTTL) {
+    _cache.insert(kKey, kVersion, CursorId(0), {BSON("_id" << 1)}, _now);
+
+    ASSERT(_cache.lookup(kKey, kVersion, _now + Milliseconds(999)));
+    ASSERT_FALSE(_cache.lookup(kKey, kVersion, _now + Milliseconds(1000)));
+    ASSERT_EQ(1, report()["expirations"].numberLong());
+}
+
+TEST_F(ClusterQueryResultCacheTest, EvictsLeastRecentlyUsedEntriesBeyondSizeLimit) {
+    const auto otherKey = BSON("ns"
+                               << "test.coll"
+                               << "find" << BSON("filter" << BSON("a" << 2)));
+    const auto doc = BSON("_id" << 1 << "payload" << std::string(400, 'x'));
+
+    internalQueryClusterResultCacheMaxSizeBytes.store(1000);
+
+    _cache.insert(kKey, kVersion, CursorId(0), {doc}, _now);
+    _cache.insert(otherKey, kVersion, CursorId(0), {doc}, _now);
+    ASSERT_FALSE(_cache.lookup(kKey, kVersion, _now));
+    ASSERT(_cache.lookup(otherKey, kVersion, _now));
+
+    // A result set which does not fit in the cache on its own is never cached.
+    _cache.insert(kKey, kVersion, CursorId(0), {doc, doc, doc}, _now);
+    ASSERT_FALSE(_cache.lookup(kKey, kVersion, _now));
+
+    auto stats = report();
+    ASSERT_EQ(1, stats["evictions"].numberLong());
+    ASSERT_LTE(stats["sizeBytes"].numberLong(), 1000);
+}
+
+TEST_F(ClusterQueryResultCacheTest, DisablingTheCacheDropsAllEntries) {
+    _cache.insert(kKey, kVersion, CursorId(0), {BSON("_id" << 1)}, _now);
+
+    internalQueryClusterResultCacheMaxSizeBytes.store(0);
+    ASSERT_FALSE(ClusterQueryResultCache::isEnabled());
+    ASSERT_FALSE(_cache.lookup(kKey, kVersion, _now));
+    ASSERT_EQ(0, report()["numEntries"].numberLong());
+}
+
+TEST_F(ClusterQueryResultCacheTest, IncompleteResultsOfOpenCursorsAreNotCached) {
+    _cache.insert(kKey, kVersion, CursorId(123), {BSON("_id" << 1)}, _now);
+    ASSERT_FALSE(_cache.lookup(kKey, kVersion, _now));
+    ASSERT_EQ(0, report()["numEntries"].numberLong());
+}
+
+class ClusterQueryResultCacheEligibilityTest : public ClusterQueryResultCacheTest {
+protected:
+    ClusterQueryResultCacheEligibilityTest() : _opCtx(_serviceContext.makeOperationContext()) {}
+
+    std::unique_ptr<QueryRequest> makeQueryRequest(BSONObj filter) {
+        auto qr = std::make_unique<QueryRequest>(NamespaceString("test.coll"));
+        qr->setFilter(filter);
+        return qr;
+    }
+
+    boost::optional<BSONObj> makeKey(std::unique_ptr<QueryRequest> qr) {
+        auto query = unittest::assertGet(
+            CanonicalQuery::canonicalize(_opCtx.get(),
+                                         std::move(qr),
+                                         nullptr,
+                                         ExtensionsCallbackNoop(),
+                                         MatchExpressionParser::kAllowAllSpecialFeatures));
+        return ClusterQueryResultCache::makeKey(_opCtx.get(), *query, ReadPreferenceSetting());
+    }
+
+    QueryTestServiceContext _serviceContext;
+    ServiceContext::UniqueOperationContext _opCtx;
+};
+
+TEST_F(ClusterQueryResultCacheEligibilityTest, PlainFindIsCached) {
+    ASSERT(makeKey(makeQueryRequest(BSON("a" << 1))));
+}
+
+TEST_F(ClusterQueryResultCacheEligibilityTest, FindInTransactionIsNotCached) {
+    _opCtx->setLogicalSessionId(makeLogicalSessionIdForTest());
+    _opCtx->setTxnNumber(1);
+    RouterOperationContextSession routerSession(_opCtx.get());
+
+    ASSERT_FALSE(makeKey(makeQueryRequest(BSON("a" << 1))));
+}
+
+TEST_F(ClusterQueryResultCacheEligibilityTest, CausallyConsistentFindIsNotCached) {
+    repl::ReadConcernArgs::get(_opCtx.get()) =
+        repl::ReadConcernArgs(LogicalTime(Timestamp(1, 1)), boost::none);
+    ASSERT_FALSE(makeKey(makeQueryRequest(BSON("a" << 1))));
+}
+
+TEST_F(ClusterQueryResultCacheEligibilityTest, SnapshotFindIsNotCached) {
+    repl::ReadConcernArgs::get(_opCtx.get()) =
+        repl::ReadConcernArgs(repl::ReadConcernLevel::kSnapshotReadConcern);
+    ASSERT_FALSE(makeKey(makeQueryRequest(BSON("a" << 1))));
+}
+
+TEST_F(ClusterQueryResultCacheEligibilityTest, LinearizableFindIsNotCached) {
+    repl::ReadConcernArgs::get(_opCtx.get()) =
+        repl::ReadConcernArgs(repl::ReadConcernLevel::kLinearizableReadConcern);
+    ASSERT_FALSE(makeKey(makeQueryRequest(BSON("a" << 1))));
+}
+
+TEST_F(ClusterQueryResultCacheEligibilityTest, TailableFindIsNotCached) {
+    auto qr = makeQueryRequest(BSON("a" << 1));
+    qr->setTailableMode(TailableModeEnum::kTailable);
+    ASSERT_FALSE(makeKey(std::move(qr)));
+}
+
+TEST_F(ClusterQueryResultCacheEligibilityTest, FindAllowingPartialResultsIsNotCached) {
+    auto qr = makeQueryRequest(BSON("a" << 1));
+    qr->setAllowPartialResults(true);
+    ASSERT_FALSE(makeKey(std::move(qr)));
+}
+
+TEST_F(ClusterQueryResultCacheEligibilityTest, FindEvaluatingExpressionsIsNotCached) {
+    ASSERT_FALSE(makeKey(makeQueryRequest(fromjson("{$expr: {$lt: ['$a', '$$NOW']}}"))));
+    ASSERT_FALSE(makeKey(makeQueryRequest(fromjson("{$where: 'this.a == 1'}"))));
+}
+
+}  // namespace
+}  // namespace mongo
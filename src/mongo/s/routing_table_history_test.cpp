@@ -29,6 +29,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <numeric>
+
 #include "mongo/s/chunk_manager.h"
 
 #include "mongo/bson/bsonobjbuilder.h"
@@ -318,5 +320,196 @@ TEST_F(RoutingTableHistoryTestThreeInitialChunks,
                               expectedBytesInChunksNotSplit);
 }
 
+
+std::string makeKey(int i) {
+    // Zero pad so that the keys sort in numeric order.
+    auto digits = std::to_string(i);
+    return "key" + std::string(8 - digits.size(), '0') + digits;
+}
+
+ChunkInfoMap makeChunkInfoMap(int numEntries) {
+    ChunkInfoMap map;
+    // Insert out of order, like chunks arriving sorted by version rather than by key.
+    for (int i = 0; i < numEntries; ++i) {
+        map.insert({makeKey((i * 7919) % numEntries), nullptr});
+    }
+    return map;
+}
+
+void assertChunkInfoMapKeys(const ChunkInfoMap& map, const std::vector<int>& expectedKeys) {
+    ASSERT_EQ(map.size(), expectedKeys.size());
+    auto it = map.begin();
+    for (auto key : expectedKeys) {
+        ASSERT(it != map.end());
+        ASSERT_EQ(it->first, makeKey(key));
+        ++it;
+    }
+    ASSERT(it == map.end());
+}
+
+TEST(ChunkInfoMapTest, InsertKeepsEntriesSortedAcrossSegments) {
+    const int numEntries = 10 * ChunkInfoMap::kTargetSegmentSize;
+    auto map = makeChunkInfoMap(numEntries);
+    ASSERT_GT(map.numSegments_forTest(), 1ull);
+
+    std::vector<int> expectedKeys(numEntries);
+    std::iota(expectedKeys.begin(), expectedKeys.end(), 0);
+    assertChunkInfoMapKeys(map, expectedKeys);
+
+    // Walking backwards from the end visits every entry in reverse order.
+    auto it = map.end();
+    for (int i = numEntries - 1; i >= 0; --i) {
+        --it;
+        ASSERT_EQ(it->first, makeKey(i));
+    }
+    ASSERT(it == map.begin());
+}
+
+TEST(ChunkInfoMapTest, Lookups) {
+    const int numEntries = 5 * ChunkInfoMap::kTargetSegmentSize;
+    auto map = makeChunkInfoMap(numEntries);
+
+    for (int i = 0; i < numEntries; i += 97) {
+        ASSERT_EQ(map.lower_bound(makeKey(i))->first, makeKey(i));
+        if (i + 1 < numEntries) {
+            ASSERT_EQ(map.upper_bound(makeKey(i))->first, makeKey(i + 1));
+        }
+    }
+    ASSERT(map.upper_bound(makeKey(numEntries - 1)) == map.end());
+    ASSERT(map.lower_bound(makeKey(numEntries)) == map.end());
+    ASSERT(map.upper_bound("") == map.begin());
+}
+
+TEST(ChunkInfoMapTest, EraseAcrossSegmentsLeavesCopiesUntouched) {
+    const int numEntries = 6 * ChunkInfoMap::kTargetSegmentSize;
+    const auto original = makeChunkInfoMap(numEntries);
+    auto copy = original;
+
+    // Erase a range spanning several segments, then insert a single entry in its place, the way
+    // a merge updates the routing table.
+    const int eraseBegin = 100;
+    const int eraseEnd = numEntries - 100;
+    copy.erase(copy.lower_bound(makeKey(eraseBegin)), copy.lower_bound(makeKey(eraseEnd)));
+    copy.insert({makeKey(eraseBegin), nullptr});
+
+    std::vector<int> expectedKeys;
+    for (int i = 0; i < numEntries; ++i) {
+        if (i <= eraseBegin || i >= eraseEnd) {
+            expectedKeys.push_back(i);
+        }
+    }
+    assertChunkInfoMapKeys(copy, expectedKeys);
+
+    std::vector<int> originalKeys(numEntries);
+    std::iota(originalKeys.begin(), originalKeys.end(), 0);
+    assertChunkInfoMapKeys(original, originalKeys);
+}
+
+TEST(ChunkInfoMapTest, EraseEverything) {
+    auto map = makeChunkInfoMap(3 * ChunkInfoMap::kTargetSegmentSize);
+    map.erase(map.begin(), map.end());
+    ASSERT(map.empty());
+    ASSERT_EQ(map.numSegments_forTest(), 0ull);
+    ASSERT(map.begin() == map.end());
+}
+
+
+/**
+ * Checks that a routing table built incrementally through makeUpdated has the same shard versions
+ * as one built from scratch out of the same chunks.
+ */
+void assertSameShardVersions(const std::shared_ptr<RoutingTableHistory>& updated,
+                             const std::vector<ChunkType>& allChunks,
+                             const OID& epoch) {
+    auto sortedChunks = allChunks;
+    std::sort(sortedChunks.begin(), sortedChunks.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.getVersion().isOlderThan(rhs.getVersion());
+    });
+    const KeyPattern shardKeyPattern(BSON("a" << 1));
+    auto rebuilt = RoutingTableHistory::makeNew(
+        kNss, UUID::gen(), shardKeyPattern, nullptr, false, epoch, sortedChunks);
+
+    ASSERT_EQ(rebuilt->getNShardsOwningChunks(), updated->getNShardsOwningChunks());
+    for (const auto& shardId : {ShardId("shard0"), ShardId("shard1")}) {
+        ASSERT_EQ(rebuilt->getVersion(shardId), updated->getVersion(shardId));
+    }
+}
+
+class RoutingTableHistoryIncrementalUpdateTest : public unittest::Test {
+protected:
+    ChunkType makeChunk(const BSONObj& min, const BSONObj& max, const char* shard) {
+        _version.incMajor();
+        return ChunkType(kNss, ChunkRange{min, max}, _version, ShardId(shard));
+    }
+
+    const OID _epoch = OID::gen();
+    const KeyPattern _shardKeyPattern{BSON("a" << 1)};
+    const BSONObj _minKey = _shardKeyPattern.globalMin();
+    const BSONObj _maxKey = _shardKeyPattern.globalMax();
+    ChunkVersion _version{0, 0, _epoch};
+};
+
+TEST_F(RoutingTableHistoryIncrementalUpdateTest, MigrationsUpdateShardVersions) {
+    std::vector<ChunkType> chunks{makeChunk(_minKey, BSON("a" << 0), "shard0"),
+                                  makeChunk(BSON("a" << 0), BSON("a" << 10), "shard0"),
+                                  makeChunk(BSON("a" << 10), BSON("a" << 20), "shard1"),
+                                  makeChunk(BSON("a" << 20), _maxKey, "shard1")};
+    auto rt = RoutingTableHistory::makeNew(
+        kNss, UUID::gen(), _shardKeyPattern, nullptr, false, _epoch, chunks);
+
+    // Migrate [0, 10) to shard1, bumping the version of the chunk left behind on shard0.
+    chunks[1] = makeChunk(BSON("a" << 0), BSON("a" << 10), "shard1");
+    chunks[0] = makeChunk(_minKey, BSON("a" << 0), "shard0");
+    rt = rt->makeUpdated({chunks[1], chunks[0]});
+    assertSameShardVersions(rt, chunks, _epoch);
+
+    // Migrate the last chunk off shard0, which then no longer owns any chunks.
+    chunks[0] = makeChunk(_minKey, BSON("a" << 0), "shard1");
+    rt = rt->makeUpdated({chunks[0]});
+    assertSameShardVersions(rt, chunks, _epoch);
+    ASSERT_EQ(1, rt->getNShardsOwningChunks());
+
+    // Migrate shard1's highest versioned chunk away without bumping any of its other chunks, so its
+    // version has to be recomputed from the chunks it still owns.
+    chunks[0] = makeChunk(_minKey, BSON("a" << 0), "shard0");
+    rt = rt->makeUpdated({chunks[0]});
+    assertSameShardVersions(rt, chunks, _epoch);
+}
+
+TEST_F(RoutingTableHistoryIncrementalUpdateTest, SplitAndMergeUpdateShardVersions) {
+    std::vector<ChunkType> chunks{makeChunk(_minKey, BSON("a" << 0), "shard0"),
+                                  makeChunk(BSON("a" << 0), _maxKey, "shard1")};
+    auto rt = RoutingTableHistory::makeNew(
+        kNss, UUID::gen(), _shardKeyPattern, nullptr, false, _epoch, chunks);
+
+    // Split [0, MaxKey) on shard1 into three chunks.
+    std::vector<ChunkType> split{makeChunk(BSON("a" << 0), BSON("a" << 10), "shard1"),
+                                 makeChunk(BSON("a" << 10), BSON("a" << 20), "shard1"),
+                                 makeChunk(BSON("a" << 20), _maxKey, "shard1")};
+    rt = rt->makeUpdated(split);
+    ASSERT_EQ(4ull, rt->getChunkMap().size());
+    std::vector<ChunkType> allChunks{chunks[0], split[0], split[1], split[2]};
+    assertSameShardVersions(rt, allChunks, _epoch);
+
+    // Merge them back together.
+    auto merged = makeChunk(BSON("a" << 0), _maxKey, "shard1");
+    rt = rt->makeUpdated({merged});
+    ASSERT_EQ(2ull, rt->getChunkMap().size());
+    assertSameShardVersions(rt, {chunks[0], merged}, _epoch);
+}
+
+TEST_F(RoutingTableHistoryIncrementalUpdateTest, GapIntroducedByUpdateIsDetected) {
+    std::vector<ChunkType> chunks{makeChunk(_minKey, BSON("a" << 0), "shard0"),
+                                  makeChunk(BSON("a" << 0), BSON("a" << 10), "shard0"),
+                                  makeChunk(BSON("a" << 10), _maxKey, "shard1")};
+    auto rt = RoutingTableHistory::makeNew(
+        kNss, UUID::gen(), _shardKeyPattern, nullptr, false, _epoch, chunks);
+
+    // Only the lower half of a split of [0, 10) is returned.
+    ASSERT_THROWS_CODE(rt->makeUpdated({makeChunk(BSON("a" << 0), BSON("a" << 5), "shard0")}),
+                       DBException,
+                       ErrorCodes::ConflictingOperationInProgress);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -33,6 +33,8 @@
 
 #include "mongo/s/write_ops/batch_write_exec.h"
 
+#include <deque>
+
 #include "mongo/base/error_codes.h"
 #include "mongo/base/owned_pointer_map.h"
 #include "mongo/base/status.h"
@@ -45,6 +47,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/grid.h"
+#include "mongo/s/mongos_server_parameters_gen.h"
 #include "mongo/s/multi_statement_transaction_requests_sender.h"
 #include "mongo/s/transaction_router.h"
 #include "mongo/s/write_ops/batch_write_op.h"
@@ -63,6 +66,9 @@ const ReadPreferenceSetting kPrimaryOnlyReadPreference(ReadPreference::PrimaryOn
 // TODO: Unordered map?
 typedef OwnedPointerMap<ShardId, TargetedWriteBatch> OwnedShardBatchMap;
 
+// Batches waiting for the shard to reply to the one in flight before they are sent
+using QueuedShardBatchMap = std::map<ShardId, std::deque<std::unique_ptr<TargetedWriteBatch>>>;
+
 WriteErrorDetail errorFromStatus(const Status& status) {
     WriteErrorDetail error;
     error.setStatus(status);
@@ -111,6 +117,34 @@ bool hasTransientTransactionError(const BatchedCommandResponse& response) {
     return iter != errorLabels.end();
 }
 
+// Targets the next round of an unordered write which is not part of a transaction. The first batch
+// for each shard goes into 'childBatches' and any further ones, in the order they are to be sent,
+// into 'queuedBatches'.
+Status targetPipelinedBatches(BatchWriteOp& batchOp,
+                              const NSTargeter& targeter,
+                              bool recordTargetErrors,
+                              std::map<ShardId, TargetedWriteBatch*>* childBatches,
+                              QueuedShardBatchMap* queuedBatches) {
+    std::map<ShardId, std::vector<TargetedWriteBatch*>> shardBatches;
+    Status targetStatus = batchOp.targetPipelinedBatches(
+        targeter,
+        recordTargetErrors,
+        static_cast<size_t>(gMaxPipelinedWriteBatchesPerShard.load()),
+        &shardBatches);
+
+    for (auto& shardAndBatches : shardBatches) {
+        auto& batches = shardAndBatches.second;
+        childBatches->emplace(shardAndBatches.first, batches.front());
+
+        auto& queue = (*queuedBatches)[shardAndBatches.first];
+        for (auto it = std::next(batches.begin()); it != batches.end(); ++it) {
+            queue.emplace_back(*it);
+        }
+    }
+
+    return targetStatus;
+}
+
 // The number of times we'll try to continue a batch op if no progress is being made. This only
 // applies when no writes are occurring and metadata is not changing on reload.
 const int kMaxRoundsWithoutProgress(5);
@@ -134,6 +168,11 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
 
     BatchWriteOp batchOp(opCtx, clientRequest);
 
+    // Unordered writes outside of a transaction may target several batches at the same shard in a
+    // round, sending each as soon as the shard has replied to the previous one.
+    const bool pipelineBatches =
+        !clientRequest.getWriteCommandBase().getOrdered() && !TransactionRouter::get(opCtx);
+
     // Current batch status
     bool refreshedTargeter = false;
     int rounds = 0;
@@ -168,11 +207,15 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
 
         OwnedPointerMap<ShardId, TargetedWriteBatch> childBatchesOwned;
         std::map<ShardId, TargetedWriteBatch*>& childBatches = childBatchesOwned.mutableMap();
+        QueuedShardBatchMap queuedBatches;
 
         // If we've already had a targeting error, we've refreshed the metadata once and can
         // record target errors definitively.
         bool recordTargetErrors = refreshedTargeter;
-        Status targetStatus = batchOp.targetBatch(targeter, recordTargetErrors, &childBatches);
+        Status targetStatus = pipelineBatches
+            ? targetPipelinedBatches(
+                  batchOp, targeter, recordTargetErrors, &childBatches, &queuedBatches)
+            : batchOp.targetBatch(targeter, recordTargetErrors, &childBatches);
         if (!targetStatus.isOK()) {
             // Don't do anything until a targeter refresh
             targeter.noteCouldNotTarget();
@@ -197,6 +240,23 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
         // Send all child batches
         //
 
+        const auto buildShardBatchRequest = [&](const TargetedWriteBatch& batch) {
+            const auto shardBatchRequest(batchOp.buildBatchRequest(batch));
+
+            BSONObjBuilder requestBuilder;
+            shardBatchRequest.serialize(&requestBuilder);
+            logical_session_id_helpers::serializeLsidAndTxnNumber(opCtx, &requestBuilder);
+
+            auto request = requestBuilder.obj();
+            LOGV2_DEBUG(22905,
+                        4,
+                        "Sending write batch to {targetShardId}: {request}",
+                        "targetShardId"_attr = batch.getEndpoint().shardName,
+                        "request"_attr = redact(request));
+
+            return request;
+        };
+
         const size_t numToSend = childBatches.size();
         size_t numSent = 0;
 
@@ -227,23 +287,7 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
 
                 stats->noteTargetedShard(targetShardId);
 
-                const auto request = [&] {
-                    const auto shardBatchRequest(batchOp.buildBatchRequest(*nextBatch));
-
-                    BSONObjBuilder requestBuilder;
-                    shardBatchRequest.serialize(&requestBuilder);
-                    logical_session_id_helpers::serializeLsidAndTxnNumber(opCtx, &requestBuilder);
-
-                    return requestBuilder.obj();
-                }();
-
-                LOGV2_DEBUG(22905,
-                            4,
-                            "Sending write batch to {targetShardId}: {request}",
-                            "targetShardId"_attr = targetShardId,
-                            "request"_attr = redact(request));
-
-                requests.emplace_back(targetShardId, request);
+                requests.emplace_back(targetShardId, buildShardBatchRequest(*nextBatch));
 
                 // Indicate we're done by setting the batch to nullptr. We'll only get duplicate
                 // hostEndpoints if we have broadcast and non-broadcast endpoints for the same host,
@@ -265,6 +309,27 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
                 isRetryableWrite ? Shard::RetryPolicy::kIdempotent : Shard::RetryPolicy::kNoRetry);
             numSent += pendingBatches.size();
 
+            // Once a shard has replied, sends it the next of its queued batches, if any. Queued
+            // batches are sent even after a stale version error, since their writes may belong to
+            // write ops which are also in flight to other shards and so can't be cancelled; the
+            // shard will reject them as stale and they are retried in the next round.
+            const auto sendNextQueuedBatch = [&](const ShardId& shardId) {
+                auto queueIt = queuedBatches.find(shardId);
+                if (queueIt == queuedBatches.end() || queueIt->second.empty())
+                    return;
+
+                auto nextBatch = std::move(queueIt->second.front());
+                queueIt->second.pop_front();
+
+                ars.addRequest({shardId, buildShardBatchRequest(*nextBatch)});
+
+                // The batch which was just replied to is no longer needed
+                auto pendingIt = pendingBatches.find(shardId);
+                invariant(pendingIt != pendingBatches.end());
+                delete pendingIt->second;
+                pendingIt->second = nextBatch.release();
+            };
+
             //
             // Receive the responses.
             //
@@ -301,6 +366,8 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
                     invariant(it != childBatches.end());
                     delete it->second;
                     it->second = nullptr;
+
+                    sendNextQueuedBatch(response.shardId);
                     continue;
                 }
 
@@ -412,6 +479,8 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
                         break;
                     }
                 }
+
+                sendNextQueuedBatch(response.shardId);
             }
         }
 
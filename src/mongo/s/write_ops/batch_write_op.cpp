@@ -31,6 +31,7 @@
 
 #include "mongo/s/write_ops/batch_write_op.h"
 
+#include <algorithm>
 #include <memory>
 #include <numeric>
 
@@ -156,6 +157,23 @@ bool wouldMakeBatchesTooBig(const std::vector<TargetedWrite*>& writes,
     return false;
 }
 
+/**
+ * Helper to determine whether a targeted write can be appended to an existing batch.
+ */
+bool canAppendToBatch(const TargetedWrite& write,
+                      int writeSizeBytes,
+                      const TargetedWriteBatch& batch) {
+    const EndpointComp endpointComp;
+    if (endpointComp(&write.endpoint, &batch.getEndpoint()) ||
+        endpointComp(&batch.getEndpoint(), &write.endpoint)) {
+        // The shard is targeted at a different version, which needs a batch of its own
+        return false;
+    }
+
+    return batch.getNumOps() < write_ops::kMaxWriteBatchSize &&
+        batch.getEstimatedSizeBytes() + writeSizeBytes <= BSONObjMaxUserSize;
+}
+
 /**
  * Gets an estimated size of how much the particular write operation would add to the size of the
  * batch.
@@ -441,6 +459,105 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
     return Status::OK();
 }
 
+Status BatchWriteOp::targetPipelinedBatches(
+    const NSTargeter& targeter,
+    bool recordTargetErrors,
+    size_t maxBatchesPerShard,
+    std::map<ShardId, std::vector<TargetedWriteBatch*>>* targetedBatches) {
+    //
+    // Unordered batches outside of a transaction don't need all the batches of a round to go
+    // out together, so when a shard's batch fills up (or the shard is targeted at a different
+    // version) we start another batch for that shard instead of ending the round. Write ops which
+    // don't fit within 'maxBatchesPerShard' batches are left for the next round.
+    //
+
+    invariant(!_clientRequest.getWriteCommandBase().getOrdered());
+    invariant(!_inTransaction);
+    invariant(maxBatchesPerShard > 0);
+
+    std::map<ShardId, std::vector<TargetedWriteBatch*>> shardBatches;
+
+    const size_t numWriteOps = _clientRequest.sizeWriteOps();
+
+    for (size_t i = 0; i < numWriteOps; ++i) {
+        WriteOp& writeOp = _writeOps[i];
+
+        // Only target _Ready ops
+        if (writeOp.getWriteState() != WriteOpState_Ready)
+            continue;
+
+        OwnedPointerVector<TargetedWrite> writesOwned;
+        vector<TargetedWrite*>& writes = writesOwned.mutableVector();
+
+        Status targetStatus = writeOp.targetWrites(_opCtx, targeter, &writes);
+
+        if (!targetStatus.isOK()) {
+            WriteErrorDetail targetError;
+            buildTargetError(targetStatus, &targetError);
+
+            if (!recordTargetErrors) {
+                // Cancel current batch state with an error
+                for (auto& shardAndBatches : shardBatches) {
+                    for (auto batch : shardAndBatches.second) {
+                        for (auto write : batch->getWrites()) {
+                            _writeOps[write->writeOpRef.first].cancelWrites(&targetError);
+                        }
+                        delete batch;
+                    }
+                }
+                return targetStatus;
+            }
+
+            writeOp.setOpError(targetError);
+            continue;
+        }
+
+        // Account the array overhead once for the actual updates array and once for the statement
+        // ids array, if retryable writes are used
+        const int writeSizeBytes = getWriteSizeBytes(writeOp) +
+            write_ops::kWriteCommandBSONArrayPerElementOverheadBytes +
+            (_batchTxnNum ? write_ops::kWriteCommandBSONArrayPerElementOverheadBytes + 4 : 0);
+
+        // A write op is either targeted to all of its shards in this round or left for the next
+        const bool fits = std::all_of(writes.begin(), writes.end(), [&](TargetedWrite* write) {
+            auto it = shardBatches.find(write->endpoint.shardName);
+            return it == shardBatches.end() ||
+                canAppendToBatch(*write, writeSizeBytes, *it->second.back()) ||
+                it->second.size() < maxBatchesPerShard;
+        });
+
+        if (!fits) {
+            writeOp.cancelWrites(nullptr);
+            continue;
+        }
+
+        for (const auto write : writes) {
+            auto& batches = shardBatches[write->endpoint.shardName];
+            if (batches.empty() || !canAppendToBatch(*write, writeSizeBytes, *batches.back())) {
+                batches.push_back(new TargetedWriteBatch(write->endpoint));
+            }
+
+            batches.back()->addWrite(write, writeSizeBytes);
+        }
+
+        // Relinquish ownership of TargetedWrites, now the TargetedBatches own them
+        writesOwned.mutableVector().clear();
+    }
+
+    for (auto& shardAndBatches : shardBatches) {
+        for (auto batch : shardAndBatches.second) {
+            // Remember targeted batch for reporting
+            _targeted.insert(batch);
+        }
+    }
+
+    *targetedBatches = std::move(shardBatches);
+
+    _nShardsOwningChunks = targeter.getNShardsOwningChunks();
+
+    return Status::OK();
+}
+
 BatchedCommandRequest BatchWriteOp::buildBatchRequest(
     const TargetedWriteBatch& targetedBatch) const {
     const auto batchType = _clientRequest.getBatchType();
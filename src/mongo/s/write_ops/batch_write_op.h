@@ -147,6 +147,19 @@ public:
                        bool recordTargetErrors,
                        std::map<ShardId, TargetedWriteBatch*>* targetedBatches);
 
+    /**
+     * Variant of targetBatch for unordered writes outside of a transaction, which may target up to
+     * 'maxBatchesPerShard' batches at the same shard instead of ending the round once a shard's
+     * batch is full. The batches for each shard are returned in the order they should be sent.
+     *
+     * Returned TargetedWriteBatches are owned by the caller.
+     */
+    Status targetPipelinedBatches(
+        const NSTargeter& targeter,
+        bool recordTargetErrors,
+        size_t maxBatchesPerShard,
+        std::map<ShardId, std::vector<TargetedWriteBatch*>>* targetedBatches);
+
     /**
      * Fills a BatchCommandRequest from a TargetedWriteBatch for this BatchWriteOp.
      */